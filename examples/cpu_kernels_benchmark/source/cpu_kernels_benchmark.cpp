@@ -0,0 +1,363 @@
+#include <gvk.hpp>
+#include <random>
+#include <numeric>
+
+// Number of elements which every kernel is run on. It is not a multiple of 8, s.t. the remainders are checked, too:
+static constexpr size_t sNumElements = 100003;
+// Every kernel is run this many times, and the fastest run is reported:
+static constexpr int sNumRuns = 20;
+
+static const char* to_string(gvk::simd_instruction_set aInstructionSet)
+{
+	switch (aInstructionSet) {
+	case gvk::simd_instruction_set::sse4_1: return "SSE4.1";
+	case gvk::simd_instruction_set::avx2:   return "AVX2";
+	default:                                return "scalar";
+	}
+}
+
+/** Runs aKernel sNumRuns times and returns the duration of the fastest run in milliseconds. */
+template <typename F>
+static double measure_best_of(F aKernel)
+{
+	auto best = std::numeric_limits<double>::max();
+	for (int i = 0; i < sNumRuns; ++i) {
+		const auto begin = std::chrono::high_resolution_clock::now();
+		aKernel();
+		const auto end = std::chrono::high_resolution_clock::now();
+		best = std::min(best, std::chrono::duration<double, std::milli>(end - begin).count());
+	}
+	return best;
+}
+
+/** Relative error of a with respect to the reference value b, which is absolute for values of b smaller than 1 */
+static float relative_error(float a, float b)
+{
+	return std::abs(a - b) / std::max(1.0f, std::abs(b));
+}
+
+/** Error of two quaternions, which represent the same rotation if they are equal or negated */
+static float rotation_error(const glm::quat& a, const glm::quat& b)
+{
+	float same = 0.0f, negated = 0.0f;
+	for (int c = 0; c < 4; ++c) {
+		same    = std::max(same,    std::abs(a[c] - b[c]));
+		negated = std::max(negated, std::abs(a[c] + b[c]));
+	}
+	return std::min(same, negated);
+}
+
+struct transforms_data
+{
+	std::vector<glm::vec3> mTranslations;
+	std::vector<glm::quat> mRotations;
+	std::vector<glm::vec3> mScales;
+};
+
+/**	Creates random transforms, which are preceded by a few special cases:
+ *	The identity, and rotations by 180 degrees around each axis, which exercise
+ *	every branch of glm::quat_cast.
+ */
+static transforms_data create_transforms(size_t aCount)
+{
+	std::mt19937 rng{ 42 };
+	std::uniform_real_distribution<float> translationDist{ -100.0f, 100.0f };
+	std::uniform_real_distribution<float> componentDist{ -1.0f, 1.0f };
+	std::uniform_real_distribution<float> scaleDist{ 0.1f, 10.0f };
+
+	transforms_data result;
+	result.mTranslations.reserve(aCount);
+	result.mRotations.reserve(aCount);
+	result.mScales.reserve(aCount);
+
+	const std::array<glm::quat, 4> specialRotations = {
+		glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f },
+		glm::quat{ 0.0f, 1.0f, 0.0f, 0.0f },
+		glm::quat{ 0.0f, 0.0f, 1.0f, 0.0f },
+		glm::quat{ 0.0f, 0.0f, 0.0f, 1.0f }
+	};
+	for (size_t i = 0; i < aCount; ++i) {
+		result.mTranslations.emplace_back(translationDist(rng), translationDist(rng), translationDist(rng));
+		if (i < specialRotations.size()) {
+			result.mRotations.push_back(specialRotations[i]);
+			result.mScales.emplace_back(1.0f);
+		}
+		else {
+			glm::quat q;
+			do {
+				q = glm::quat{ componentDist(rng), componentDist(rng), componentDist(rng), componentDist(rng) };
+			} while (glm::length(q) < 0.1f);
+			result.mRotations.push_back(glm::normalize(q));
+			result.mScales.emplace_back(scaleDist(rng), scaleDist(rng), scaleDist(rng));
+		}
+	}
+	return result;
+}
+
+/**	Compares matrices_from_transforms and transforms_from_matrices with the currently active instruction set
+ *	against the scalar matrix_from_transforms and transforms_from_matrix (which uses glm::quat_cast), and
+ *	measures both of them.
+ *	@return	True if all the results are within the tolerances
+ */
+static bool check_transform_batch(const transforms_data& aTransforms)
+{
+	static constexpr float sMatrixTolerance = 1e-5f;
+	static constexpr float sRotationTolerance = 1e-4f;
+	static constexpr float sScaleTolerance = 1e-5f;
+
+	const auto count = aTransforms.mTranslations.size();
+	std::vector<glm::mat4> matrices(count);
+	std::vector<glm::vec3> translations(count);
+	std::vector<glm::quat> rotations(count);
+	std::vector<glm::vec3> scales(count);
+
+	const auto composeMs = measure_best_of([&]() {
+		gvk::matrices_from_transforms(aTransforms.mTranslations.data(), aTransforms.mRotations.data(), aTransforms.mScales.data(), count, matrices.data());
+	});
+	const auto decomposeMs = measure_best_of([&]() {
+		gvk::transforms_from_matrices(matrices.data(), count, translations.data(), rotations.data(), scales.data());
+	});
+
+	float maxMatrixError = 0.0f, maxTranslationError = 0.0f, maxRotationError = 0.0f, maxScaleError = 0.0f;
+	std::vector<glm::mat4> expectedMatrices(count);
+	for (size_t i = 0; i < count; ++i) {
+		expectedMatrices[i] = gvk::matrix_from_transforms(aTransforms.mTranslations[i], aTransforms.mRotations[i], aTransforms.mScales[i]);
+		for (int col = 0; col < 4; ++col) {
+			for (int row = 0; row < 4; ++row) {
+				maxMatrixError = std::max(maxMatrixError, relative_error(matrices[i][col][row], expectedMatrices[i][col][row]));
+			}
+		}
+	}
+
+	// Decompose the reference matrices, s.t. the errors of both kernels do not add up:
+	gvk::transforms_from_matrices(expectedMatrices.data(), count, translations.data(), rotations.data(), scales.data());
+	for (size_t i = 0; i < count; ++i) {
+		const auto [expectedTranslation, expectedRotation, expectedScale] = gvk::transforms_from_matrix(expectedMatrices[i]);
+		for (int c = 0; c < 3; ++c) {
+			maxTranslationError = std::max(maxTranslationError, relative_error(translations[i][c], expectedTranslation[c]));
+			maxScaleError = std::max(maxScaleError, relative_error(scales[i][c], expectedScale[c]));
+		}
+		maxRotationError = std::max(maxRotationError, rotation_error(rotations[i], expectedRotation));
+	}
+
+	const bool passed = maxMatrixError <= sMatrixTolerance
+		&& maxTranslationError <= sMatrixTolerance
+		&& maxRotationError <= sRotationTolerance
+		&& maxScaleError <= sScaleTolerance;
+
+	fmt::print("{:>7} | matrices_from_transforms: {:8.3f} ms | transforms_from_matrices: {:8.3f} ms | max. errors: matrix {:.2e}, translation {:.2e}, rotation {:.2e}, scale {:.2e} | {}\n",
+		to_string(gvk::active_simd_instruction_set()), composeMs, decomposeMs,
+		maxMatrixError, maxTranslationError, maxRotationError, maxScaleError,
+		passed ? "PASSED" : "FAILED");
+	return passed;
+}
+
+/** A square occluder in the plane z = aZ, which is given by its half extent, and which consists of aSubdivisions^2 quads */
+static gvk::occluder_mesh create_occluder_square(float aHalfExtent, float aZ, uint32_t aSubdivisions)
+{
+	gvk::occluder_mesh result;
+	for (uint32_t y = 0; y <= aSubdivisions; ++y) {
+		for (uint32_t x = 0; x <= aSubdivisions; ++x) {
+			result.mPositions.emplace_back(
+				-aHalfExtent + 2.0f * aHalfExtent * static_cast<float>(x) / static_cast<float>(aSubdivisions),
+				-aHalfExtent + 2.0f * aHalfExtent * static_cast<float>(y) / static_cast<float>(aSubdivisions),
+				aZ);
+		}
+	}
+	for (uint32_t y = 0; y < aSubdivisions; ++y) {
+		for (uint32_t x = 0; x < aSubdivisions; ++x) {
+			const uint32_t i = y * (aSubdivisions + 1) + x;
+			result.mIndices.insert(std::end(result.mIndices), { i, i + 1, i + aSubdivisions + 2, i, i + aSubdivisions + 2, i + aSubdivisions + 1 });
+		}
+	}
+	result.mBounds = gvk::compute_bounding_box(result.mPositions);
+	return result;
+}
+
+/**	Rasterizes a square occluder with the currently active instruction set, and compares the depth buffer
+ *	against the analytically computed one. Tests bounding boxes with known visibility via is_visible,
+ *	and measures remove_occluded for random bounding boxes.
+ *	@return	True if all the results are as expected
+ */
+static bool check_occlusion_culler(gvk::thread_pool& aThreadPool)
+{
+	static constexpr float sDepthTolerance = 1e-5f;
+	static constexpr float sOccluderHalfExtent = 4.0f;
+	static constexpr float sOccluderZ = -10.0f;
+
+	const auto projectionAndView = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f); // Camera at the origin, looking along -z
+	const auto occluder = create_occluder_square(sOccluderHalfExtent, sOccluderZ, 16);
+	gvk::occlusion_culler culler{ 256, 128 };
+	const auto w = static_cast<float>(culler.width());
+	const auto h = static_cast<float>(culler.height());
+
+	culler.begin_frame(projectionAndView);
+	culler.add_occluder(occluder, glm::mat4{ 1.0f });
+	const auto rasterizeMs = measure_best_of([&]() { culler.rasterize(); });
+
+	// The square is parallel to the near plane => it has the same depth everywhere, and it covers a rectangle on screen:
+	auto toScreen = [&](const glm::vec3& bPosition) {
+		const auto clip = projectionAndView * glm::vec4{ bPosition, 1.0f };
+		const auto ndc = glm::vec3{ clip } / clip.w;
+		return glm::vec3{ (ndc.x * 0.5f + 0.5f) * w, (ndc.y * 0.5f + 0.5f) * h, ndc.z };
+	};
+	const auto screenMin = toScreen(glm::vec3{ -sOccluderHalfExtent, -sOccluderHalfExtent, sOccluderZ });
+	const auto screenMax = toScreen(glm::vec3{  sOccluderHalfExtent,  sOccluderHalfExtent, sOccluderZ });
+	const float occluderDepth = screenMin.z;
+
+	// Pixels within one pixel of the square's edges may go either way:
+	size_t numWrongPixels = 0;
+	for (uint32_t y = 0; y < culler.height(); ++y) {
+		for (uint32_t x = 0; x < culler.width(); ++x) {
+			const float fx = static_cast<float>(x) + 0.5f;
+			const float fy = static_cast<float>(y) + 0.5f;
+			const float depth = culler.depth_buffer()[static_cast<size_t>(y) * culler.width() + x];
+			const bool inside  = fx > screenMin.x + 1.0f && fx < screenMax.x - 1.0f && fy > screenMin.y + 1.0f && fy < screenMax.y - 1.0f;
+			const bool outside = fx < screenMin.x - 1.0f || fx > screenMax.x + 1.0f || fy < screenMin.y - 1.0f || fy > screenMax.y + 1.0f;
+			if ((inside && std::abs(depth - occluderDepth) > sDepthTolerance) || (outside && 1.0f != depth)) {
+				++numWrongPixels;
+			}
+		}
+	}
+
+	// Rasterizing in parallel must result in exactly the same depth buffer:
+	const auto serialDepth = culler.depth_buffer();
+	culler.begin_frame(projectionAndView);
+	culler.add_occluder(occluder, glm::mat4{ 1.0f });
+	culler.rasterize(aThreadPool);
+	const bool parallelMatches = serialDepth == culler.depth_buffer();
+
+	auto box = [](const glm::vec3& bCenter, float bHalfExtent) {
+		return gvk::bounding_box{ bCenter - glm::vec3{ bHalfExtent }, bCenter + glm::vec3{ bHalfExtent } };
+	};
+	const std::array<std::tuple<const char*, gvk::bounding_box, bool>, 7> cases = {
+		std::make_tuple("behind the occluder",            box(glm::vec3{  0.0f, 0.0f,  -20.0f }, 1.0f), false),
+		std::make_tuple("in front of the occluder",       box(glm::vec3{  0.0f, 0.0f,   -5.0f }, 1.0f), true),
+		std::make_tuple("behind the occluder's edge",     box(glm::vec3{  8.0f, 0.0f,  -20.0f }, 1.0f), true),
+		std::make_tuple("beside the occluder",            box(glm::vec3{ 15.0f, 0.0f,  -20.0f }, 1.0f), true),
+		std::make_tuple("intersecting the near plane",    box(glm::vec3{  0.0f, 0.0f,    0.0f }, 1.0f), true),
+		std::make_tuple("off screen",                     box(glm::vec3{ 100.0f, 0.0f, -20.0f }, 1.0f), false),
+		std::make_tuple("beyond the far plane",           box(glm::vec3{  0.0f, 0.0f, -200.0f }, 1.0f), false)
+	};
+	std::vector<std::string> wrongCases;
+	for (const auto& [name, bounds, expectedVisible] : cases) {
+		if (culler.is_visible(bounds) != expectedVisible) {
+			wrongCases.emplace_back(name);
+		}
+	}
+
+	// Random boxes, of which those which are in the occluder's shadow are removed:
+	std::mt19937 rng{ 42 };
+	std::uniform_real_distribution<float> xyDist{ -30.0f, 30.0f };
+	std::uniform_real_distribution<float> zDist{ -60.0f, -1.0f };
+	std::vector<gvk::bounding_box> boxes;
+	boxes.reserve(sNumElements);
+	for (size_t i = 0; i < sNumElements; ++i) {
+		boxes.push_back(box(glm::vec3{ xyDist(rng), xyDist(rng), zDist(rng) }, 0.25f));
+	}
+	std::vector<uint32_t> allIndices(boxes.size());
+	std::iota(std::begin(allIndices), std::end(allIndices), 0u);
+	std::vector<uint32_t> visibleIndices;
+	const auto removeOccludedMs = measure_best_of([&]() {
+		visibleIndices = allIndices;
+		culler.remove_occluded(boxes.data(), visibleIndices);
+	});
+	auto visibleIndicesParallel = allIndices;
+	culler.remove_occluded(aThreadPool, boxes.data(), visibleIndicesParallel);
+	const bool removeOccludedMatches = visibleIndices == visibleIndicesParallel;
+
+	const bool passed = 0 == numWrongPixels && parallelMatches && wrongCases.empty() && removeOccludedMatches;
+	fmt::print("{:>7} | rasterize: {:8.3f} ms | remove_occluded: {:8.3f} ms ({} of {} visible) | wrong pixels: {}, parallel rasterization {}, parallel remove_occluded {}{}{} | {}\n",
+		to_string(gvk::active_simd_instruction_set()), rasterizeMs, removeOccludedMs, visibleIndices.size(), boxes.size(),
+		numWrongPixels, parallelMatches ? "matches" : "DIFFERS", removeOccludedMatches ? "matches" : "DIFFERS",
+		wrongCases.empty() ? "" : ", wrong visibility of boxes: ", fmt::join(wrongCases, ", "),
+		passed ? "PASSED" : "FAILED");
+	return passed;
+}
+
+/**	Checks the frame timing of baked animations for clip durations which are not a whole number of frames long:
+ *	The last frame must be played back at exactly the end of the clip, and looping must wrap around at exactly its duration.
+ *	@return	True if all the results are as expected
+ */
+static bool check_baked_animation_timing()
+{
+	static constexpr float sFrameTolerance = 1e-3f;
+
+	bool passed = true;
+	for (auto framesPerSecond : { 24.0f, 30.0f, 60.0f }) {
+		for (auto duration : { 1.01, 2.0 / 3.0, 1.0, 0.05, 10.007 }) {
+			gvk::baked_animation_data baked{};
+			std::tie(baked.mNumFrames, baked.mFramesPerSecond) = gvk::baked_animation_frames(duration, framesPerSecond);
+			const auto lastFrame = static_cast<float>(baked.mNumFrames - 1u);
+			const auto period = static_cast<float>(lastFrame / baked.mFramesPerSecond);
+			const auto clipDuration = static_cast<float>(duration);
+
+			// Clamped playback reaches the last frame at the end of the clip, looped playback wraps around there:
+			const auto frameAtEnd = gvk::baked_animation_frame_at(baked, clipDuration, false);
+			const auto loopedFrameAtEnd = gvk::baked_animation_frame_at(baked, clipDuration, true);
+			float maxLoopError = 0.0f;
+			for (auto t : { 0.1f, 0.37f, 0.5f, 0.93f }) {
+				const auto expected = gvk::baked_animation_frame_at(baked, t * clipDuration, true);
+				maxLoopError = std::max(maxLoopError, std::abs(gvk::baked_animation_frame_at(baked, t * clipDuration + clipDuration, true) - expected));
+				maxLoopError = std::max(maxLoopError, std::abs(gvk::baked_animation_frame_at(baked, t * clipDuration + 3.0f * clipDuration, true) - expected));
+			}
+
+			const bool ok = std::abs(period - clipDuration) <= 1e-5f * std::max(1.0f, clipDuration)
+				&& std::abs(frameAtEnd - lastFrame) <= sFrameTolerance
+				&& std::min(loopedFrameAtEnd, lastFrame - loopedFrameAtEnd) <= sFrameTolerance
+				&& maxLoopError <= sFrameTolerance
+				&& baked.mFramesPerSecond >= framesPerSecond;
+			if (!ok) {
+				fmt::print("{:6.3f} s at {:4.1f} fps | {} frames at {:.4f} fps, period {:.6f} s, last frame at end {:.4f}, max. loop error {:.2e} | FAILED\n",
+					duration, framesPerSecond, baked.mNumFrames, baked.mFramesPerSecond, period, frameAtEnd, maxLoopError);
+			}
+			passed = ok && passed;
+		}
+	}
+	if (passed) {
+		fmt::print("All clips wrap around at exactly their durations | PASSED\n");
+	}
+	return passed;
+}
+
+int main() // <== Starting point ==
+{
+	try {
+		const auto transforms = create_transforms(sNumElements);
+		const auto supported = gvk::supported_simd_instruction_set();
+		fmt::print("Best supported instruction set: {}\n", to_string(supported));
+
+		bool passed = true;
+		fmt::print("\nTransform batches of {} elements:\n", sNumElements);
+		for (auto instructionSet : { gvk::simd_instruction_set::scalar, gvk::simd_instruction_set::sse4_1, gvk::simd_instruction_set::avx2 }) {
+			if (static_cast<int>(instructionSet) > static_cast<int>(supported)) {
+				fmt::print("{:>7} | not supported\n", to_string(instructionSet));
+				continue;
+			}
+			gvk::set_simd_instruction_set(instructionSet);
+			passed = check_transform_batch(transforms) && passed;
+		}
+
+		// The occlusion culler uses AVX2 or scalar code only:
+		gvk::thread_pool threadPool;
+		fmt::print("\nOcclusion culling of {} bounding boxes:\n", sNumElements);
+		for (auto instructionSet : { gvk::simd_instruction_set::scalar, gvk::simd_instruction_set::avx2 }) {
+			if (static_cast<int>(instructionSet) > static_cast<int>(supported)) {
+				fmt::print("{:>7} | not supported\n", to_string(instructionSet));
+				continue;
+			}
+			gvk::set_simd_instruction_set(instructionSet);
+			passed = check_occlusion_culler(threadPool) && passed;
+		}
+		gvk::set_simd_instruction_set(supported);
+
+		fmt::print("\nBaked animation timing:\n");
+		passed = check_baked_animation_timing() && passed;
+
+		fmt::print("\n{}\n", passed ? "All checks passed." : "Some checks FAILED.");
+		return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (gvk::logic_error&) {}
+	catch (gvk::runtime_error&) {}
+	return EXIT_FAILURE;
+}
@@ -11,6 +11,22 @@ namespace gvk
 		double mEndTicks;
 	};
 
+	/**	Error tolerances for the keyframe reduction of animation::compress.
+	 *	A key is removed if interpolating between its neighbouring keys
+	 *	reproduces it within the given tolerance.
+	 */
+	struct animation_compression_config
+	{
+		/** Maximum deviation of translations, in units of the node's local space */
+		float mPositionTolerance = 1e-4f;
+
+		/** Maximum deviation of rotations, in radians */
+		float mRotationTolerance = 1e-4f;
+
+		/** Maximum deviation of scaling factors */
+		float mScalingTolerance = 1e-4f;
+	};
+
 	struct position_key
 	{
 		double mTime;
@@ -109,9 +125,30 @@ namespace gvk
 		 *	 mBoneMatrixTargets, though.)
 		 */
 		std::vector<bone_mesh_data> mBoneMeshTargets;
+
+		/** Playback cursors into mPositionKeys, mRotationKeys, and mScalingKeys,
+		 *	respectively. They store the key index which has been found during the
+		 *	previous animate() call, s.t. the search can continue from there.
+		 */
+		size_t mPositionKeyCursor = 0;
+		size_t mRotationKeyCursor = 0;
+		size_t mScalingKeyCursor = 0;
+
+		/** True if this node may be skipped at low levels of detail, c.f. animation::set_unimportant */
+		bool mUnimportant = false;
+
+		/** The local transform which has been calculated during the previous animate() call.
+		 *	It is used instead of sampling the keys if this node is skipped.
+		 */
+		glm::mat4 mLocalTransform{ 1.0f };
+
+		/** True once mLocalTransform has been calculated from the keys. Until then, this node is never skipped. */
+		bool mLocalTransformEvaluated = false;
 	};
 
 	class model_t;
+	class compiled_animation;
+	class compressed_animation;
 	
 	/**	Class that represents one specific animation for one or multiple meshes
 	 */
@@ -122,29 +159,121 @@ namespace gvk
 	public:
 		void animate(const animation_clip_data& aClip, double mTime);
 
+		/**	Creates an alternative representation of this animation, which stores
+		 *	its keys in a structure-of-arrays layout and evaluates multiple nodes
+		 *	at once with SIMD instructions. See compiled_animation for details.
+		 *	It writes into the same target storage as this animation.
+		 */
+		compiled_animation compile() const;
+
+		/**	Creates a compressed representation of this animation, which removes keys that
+		 *	can be reconstructed by interpolation within the given tolerances, and quantizes
+		 *	the remaining keys. See compressed_animation for details.
+		 *	It writes into the same target storage as this animation.
+		 */
+		compressed_animation compress(const animation_compression_config& aConfig = {}) const;
+
+		/**	Returns the memory address of the first bone matrix of the first mesh,
+		 *	i.e. the beginning of the target storage which bone matrices are written into.
+		 */
+		glm::mat4* target_storage_begin() const;
+
+		/**	Returns the number of bone matrices which the target storage must be able to hold,
+		 *	counted from target_storage_begin().
+		 */
+		size_t target_storage_size() const;
+
+		/**	Changes the target storage which bone matrices are written into. All target
+		 *	pointers are moved by the same offset, i.e. the layout of the bone matrices
+		 *	within the target storage remains the same.
+		 *	@param	aNewBeginningOfTargetStorage	Memory address of the first bone matrix of the first mesh.
+		 *											It must be able to hold target_storage_size() matrices.
+		 */
+		void retarget(glm::mat4* aNewBeginningOfTargetStorage);
+
+		/**	Sets the format in which bone matrices are written into the target storage.
+		 *	With bone_matrix_encoding::mat3x4 or bone_matrix_encoding::dual_quaternion, the target
+		 *	storage is interpreted as tightly packed glm::vec4 elements, where each bone occupies
+		 *	number_of_vec4s_per_bone(aEncoding) elements, c.f. write_bone_matrix. Its size in bytes
+		 *	shrinks accordingly, by 25% or 50% compared to glm::mat4.
+		 *	Matching shader functions are provided in framework/shaders/bone_matrix_encoding.glsl.
+		 */
+		void set_output_encoding(bone_matrix_encoding aEncoding) { mOutputEncoding = aEncoding; }
+
+		/** Returns the format in which bone matrices are written into the target storage */
+		bone_matrix_encoding output_encoding() const { return mOutputEncoding; }
+
+		/** Returns the number of animated nodes */
+		size_t number_of_nodes() const { return mAnimationData.size(); }
+
+		/** Returns the indices of all animated nodes which are not the animated parent of any other node */
+		std::vector<size_t> leaf_node_indices() const;
+
+		/**	Flags the given node as unimportant, i.e. its keys are not sampled while
+		 *	skipping unimportant nodes is enabled (c.f. set_skip_unimportant_nodes).
+		 *	Typically, leaf bones like fingers, toes, or facial bones are flagged, c.f. leaf_node_indices.
+		 *	A skipped node keeps the local transform of its last evaluation, i.e. it still
+		 *	follows its parents' movement. Nodes are only skipped after their keys have been sampled once.
+		 *	@param	aNodeIndex		Index of the node in the range [0, number_of_nodes())
+		 *	@param	aUnimportant	Whether or not the node is unimportant
+		 */
+		void set_unimportant(size_t aNodeIndex, bool aUnimportant = true);
+
+		/** Enables or disables skipping of unimportant nodes in animate(), e.g. for low levels of detail. */
+		void set_skip_unimportant_nodes(bool aSkip) { mSkipUnimportantNodes = aSkip; }
+
+		/** Returns whether or not unimportant nodes are skipped in animate() */
+		bool skips_unimportant_nodes() const { return mSkipUnimportantNodes; }
+
 	private:
 		/** Helper function used during animate() to find two positions of key-elements
 		 *	between which the given aTime lies.
+		 *
+		 *	The search starts at aCursor, which is the position that has been found
+		 *	during the previous invocation. During forward playback, the time has
+		 *	typically advanced by no more than a key or two, so the cursor is moved
+		 *	forward incrementally. If the time has jumped backwards (due to seeking
+		 *	or looping) or far ahead, a binary search is performed instead.
+		 *	aCursor is updated to the first of the two returned positions.
 		 */
 		template <typename T>
-		std::tuple<size_t, size_t> find_positions_in_keys(const T& aCollection, double aTime)
+		std::tuple<size_t, size_t> find_positions_in_keys(const T& aCollection, double aTime, size_t& aCursor)
 		{
+			static constexpr size_t sMaxIncrementalSteps = 4;
 			const auto maxIndex = aCollection.size() - 1;
-			
-			size_t pos1 = 0;
-			while (pos1 + 1 <= maxIndex && aCollection[pos1 + 1].mTime <= aTime) {
-				++pos1;
+
+			size_t pos1 = std::min(aCursor, maxIndex);
+			if (0 == pos1 || aCollection[pos1].mTime <= aTime) {
+				size_t steps = 0;
+				while (pos1 + 1 <= maxIndex && aCollection[pos1 + 1].mTime <= aTime && steps < sMaxIncrementalSteps) {
+					++pos1;
+					++steps;
+				}
+				if (pos1 + 1 <= maxIndex && aCollection[pos1 + 1].mTime <= aTime) {
+					pos1 = find_position_in_keys_binary_search(aCollection, aTime);
+				}
 			}
-			
-			size_t pos2 = pos1 + (pos1 < maxIndex ? 1 : 0);
-			while (pos2 + 1 < maxIndex && aCollection[pos2 + 1].mTime < aTime) {
-				LOG_WARNING(fmt::format("Now that's strange: keys[{}].mTime {} < {}, despite keys[{}].mTime {} <= {}", pos2 + 1, aCollection[pos2 + 1].mTime, aTime, pos1, aCollection[pos1].mTime, aTime));
-				++pos2;
+			else {
+				pos1 = find_position_in_keys_binary_search(aCollection, aTime);
 			}
-			
+			aCursor = pos1;
+
+			size_t pos2 = pos1 + (pos1 < maxIndex ? 1 : 0);
 			return std::make_tuple(pos1, pos2);
 		}
 
+		/** Helper function used by find_positions_in_keys to find the position of the
+		 *	last key-element whose time is not greater than aTime, or 0 if there is none.
+		 */
+		template <typename T>
+		size_t find_position_in_keys_binary_search(const T& aCollection, double aTime)
+		{
+			auto it = std::upper_bound(std::begin(aCollection), std::end(aCollection), aTime, [](double bTime, const auto& bKey) {
+				return bTime < bKey.mTime;
+			});
+			return it == std::begin(aCollection) ? 0 : static_cast<size_t>(std::distance(std::begin(aCollection), it) - 1);
+		}
+
 		/**	For two kiven keys (each of which must contain a .mTime member of type
 		 *	double), and a given aTime value, return the corresponding interpolation
 		 *	factor in the range [0..1].
@@ -178,5 +307,13 @@ namespace gvk
 		 *  (Second tuple element of mMeshIndicesAndTargetStorage)
 		 */
 		size_t mMaxNumBoneMatrices;
+
+		/** Format in which bone matrices are written into the target storage
+		 */
+		bone_matrix_encoding mOutputEncoding = bone_matrix_encoding::mat4;
+
+		/** If true, the keys of nodes which are flagged as unimportant are not sampled
+		 */
+		bool mSkipUnimportantNodes = false;
 	};
 }
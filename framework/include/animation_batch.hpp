@@ -0,0 +1,171 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Bone matrix type with the size and the alignment of one cache line, used
+	 *	as element type of animation_batch's bone palette.
+	 */
+	struct alignas(64) bone_palette_matrix
+	{
+		glm::mat4 mMatrix;
+	};
+	static_assert(sizeof(bone_palette_matrix) == sizeof(glm::mat4), "bone_palette_matrix must be tightly packed, s.t. the bone palette can be accessed as contiguous glm::mat4 elements.");
+
+	/**	Level of detail for the evaluation of animation instances in an animation_batch.
+	 *	A level applies to an instance if its distance to the camera is at most mMaxDistance
+	 *	or, alternatively, if its size on screen is at least mMinScreenSize.
+	 */
+	struct animation_lod_level
+	{
+		/** Maximum distance to the camera for which this level is selected */
+		float mMaxDistance = std::numeric_limits<float>::max();
+
+		/** Minimum size on screen, e.g. the projected height relative to the viewport height, for which this level is selected */
+		float mMinScreenSize = 0.0f;
+
+		/**	The animation is evaluated every mUpdateInterval-th animate() call. In between, the bone
+		 *	matrices are interpolated between the two latest evaluations. 1 means every call.
+		 */
+		uint32_t mUpdateInterval = 1;
+
+		/**	If true, nodes which have been flagged as unimportant are not evaluated, c.f. animation::set_unimportant.
+		 *	This applies to instances of class animation only; compiled_animation always evaluates all nodes.
+		 */
+		bool mSkipUnimportantNodes = false;
+	};
+
+	/**	Holds many animation instances, i.e. (animation, clip, time) tuples, and evaluates
+	 *	them in parallel on a thread pool. All instances write their bone matrices into one
+	 *	contiguous bone palette, which is owned by the animation_batch.
+	 *
+	 *	Each instance's region in the bone palette starts at a cache line boundary, since
+	 *	one bone matrix occupies exactly one cache line. Hence, no two instances which are
+	 *	evaluated on different threads write into the same cache line.
+	 *
+	 *	The animations are retargeted to the bone palette, i.e. whichever target storage
+	 *	they have been prepared for, it is not written to by the animation_batch.
+	 *	Within an instance's region, the bone matrices are laid out the same way as they
+	 *	would have been in the original target storage.
+	 *
+	 *	Optionally, the instances can be evaluated with different levels of detail (LOD), c.f.
+	 *	set_lod_levels. Distant instances can then be evaluated less frequently and with fewer nodes.
+	 *	Instances which are evaluated every Nth call are evaluated ahead of time, i.e. at the time
+	 *	which they are expected to reach N calls later, and their bone matrices are interpolated
+	 *	between the two latest evaluations in the calls in between. The evaluations of different
+	 *	instances are staggered across calls, s.t. the costs are spread evenly. The interpolation
+	 *	takes the animations' output encodings into account (c.f. animation::set_output_encoding),
+	 *	i.e. dual quaternions are blended like dual quaternions rather than like matrices.
+	 */
+	class animation_batch
+	{
+	public:
+		animation_batch() = default;
+		animation_batch(animation_batch&&) noexcept = default;
+		animation_batch(const animation_batch&) = delete;
+		animation_batch& operator=(animation_batch&&) noexcept = default;
+		animation_batch& operator=(const animation_batch&) = delete;
+		~animation_batch() = default;
+
+		/**	Adds an animation instance.
+		 *	@param	aAnimation	The animation, typically created via model_t::prepare_animation_for_meshes_into_strided_contiguous_memory
+		 *	@param	aClip		The clip to be played
+		 *	@param	aTime		Initial time in seconds
+		 *	@return	The index of the instance, to be used with the other member functions.
+		 */
+		size_t add_instance(animation aAnimation, animation_clip_data aClip, double aTime = 0.0);
+
+		/**	Adds a compiled animation instance.
+		 *	@param	aAnimation	The animation, typically created via animation::compile
+		 *	@param	aClip		The clip to be played
+		 *	@param	aTime		Initial time in seconds
+		 *	@return	The index of the instance, to be used with the other member functions.
+		 */
+		size_t add_instance(compiled_animation aAnimation, animation_clip_data aClip, double aTime = 0.0);
+
+		/** Returns the number of animation instances */
+		size_t number_of_instances() const { return mInstances.size(); }
+
+		/** Sets the time, in seconds, which the given instance shall be evaluated at */
+		void set_time(size_t aInstanceIndex, double aTime) { mInstances[aInstanceIndex].mTime = aTime; }
+
+		/** Gets the time, in seconds, which the given instance will be evaluated at */
+		double time(size_t aInstanceIndex) const { return mInstances[aInstanceIndex].mTime; }
+
+		/** Sets the clip which the given instance shall play */
+		void set_clip(size_t aInstanceIndex, animation_clip_data aClip) { mInstances[aInstanceIndex].mClip = aClip; }
+
+		/** Advances the times of all instances by the given delta time in seconds. */
+		void advance_time(double aDeltaTime);
+
+		/**	Sets the levels of detail, which are selected via set_lod_level, set_lod_from_distance,
+		 *	or set_lod_from_screen_size. Level 0 is the most detailed one. All instances are reset to level 0.
+		 *	Without any levels, all instances are evaluated in every animate() call with all nodes.
+		 */
+		void set_lod_levels(std::vector<animation_lod_level> aLevels);
+
+		/** Selects the level of detail of the given instance */
+		void set_lod_level(size_t aInstanceIndex, size_t aLevel);
+
+		/** Selects the first level of detail whose mMaxDistance is not less than the given distance, or the last level */
+		void set_lod_from_distance(size_t aInstanceIndex, float aDistance);
+
+		/** Selects the first level of detail whose mMinScreenSize is not greater than the given screen size, or the last level */
+		void set_lod_from_screen_size(size_t aInstanceIndex, float aScreenSize);
+
+		/** Returns the level of detail of the given instance */
+		size_t lod_level(size_t aInstanceIndex) const { return mInstances[aInstanceIndex].mLodLevel; }
+
+		/**	Evaluates all instances at their current times and writes their bone matrices
+		 *	into the bone palette. The instances are split into chunks, which are evaluated
+		 *	in parallel on the given thread pool.
+		 *	@param	aThreadPool				The thread pool to use
+		 *	@param	aInstancesPerChunk		Number of instances which are evaluated by one thread in a row.
+		 *									If 0, the chunk size is derived from the number of instances
+		 *									and the number of worker threads.
+		 */
+		void animate(thread_pool& aThreadPool = default_thread_pool(), size_t aInstancesPerChunk = 0);
+
+		/** Returns the first element of the bone palette, which contains all instances' bone matrices */
+		const glm::mat4* bone_palette() const;
+
+		/** Returns the number of bone matrices in the bone palette */
+		size_t bone_palette_size() const { return mBonePalette.size(); }
+
+		/** Returns the offset, in number of bone matrices, of the given instance's region within the bone palette */
+		size_t bone_palette_offset(size_t aInstanceIndex) const { return mInstances[aInstanceIndex].mPaletteOffset; }
+
+		/** Returns the number of bone matrices of the given instance's region within the bone palette */
+		size_t bone_palette_count(size_t aInstanceIndex) const { return mInstances[aInstanceIndex].mPaletteCount; }
+
+	private:
+		struct instance
+		{
+			std::variant<animation, compiled_animation> mAnimation;
+			animation_clip_data mClip;
+			double mTime;
+			size_t mPaletteOffset;
+			size_t mPaletteCount;
+
+			size_t mLodLevel = 0;
+			/** Number of animate() calls until the next evaluation, if the update interval is greater than 1 */
+			uint32_t mCallsUntilUpdate = 0;
+			/** Time of the previous animate() call, to estimate the time of the next evaluation */
+			double mPreviousTime = 0.0;
+			/** The two latest evaluations and their times, if the update interval is greater than 1 */
+			std::array<std::vector<glm::mat4>, 2> mKeyPoses;
+			std::array<double, 2> mKeyPoseTimes = {};
+			bool mKeyPosesValid = false;
+		};
+
+		size_t add(std::variant<animation, compiled_animation> aAnimation, size_t aPaletteCount, animation_clip_data aClip, double aTime);
+
+		/** Evaluates one instance according to its level of detail */
+		void animate_instance(size_t aInstanceIndex);
+
+		std::vector<instance> mInstances;
+		std::vector<bone_palette_matrix> mBonePalette;
+		bool mPaletteOutdated = false;
+		std::vector<animation_lod_level> mLodLevels;
+	};
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Bone matrices of an animation clip, which have been sampled at a fixed rate.
+	 *
+	 *	mData is laid out as it is expected by framework/shaders/baked_animation.glsl:
+	 *	 - mData[0] is a header: (number of frames, bones per frame, effective frames per second, encoding),
+	 *	   where all but the frames per second are stored as uint bits (c.f. glm::uintBitsToFloat).
+	 *	 - Followed by mNumFrames frames, each of which consists of mBonesPerFrame bone matrices,
+	 *	   each of which occupies number_of_vec4s_per_bone(mEncoding) elements.
+	 */
+	struct baked_animation_data
+	{
+		bone_matrix_encoding mEncoding;
+		uint32_t mNumFrames;
+		uint32_t mBonesPerFrame;
+		/** The effective sampling rate, c.f. baked_animation_frames */
+		float mFramesPerSecond;
+		std::vector<glm::vec4> mData;
+	};
+
+	/**	Determines how many frames a clip of the given duration is baked into, and at which rate they are played back.
+	 *	The frames are evenly distributed over the clip, s.t. the first and the last frame are at its start and its end.
+	 *	Therefore, the effective rate is (number of frames - 1) / aDuration, which is slightly higher than aFramesPerSecond
+	 *	if aDuration * aFramesPerSecond is not a whole number. This way, a looping clip wraps around at exactly aDuration.
+	 *	@param	aDuration			Duration of the clip in seconds
+	 *	@param	aFramesPerSecond	Requested sampling rate
+	 *	@return	The number of frames, and the effective frames per second
+	 */
+	extern std::tuple<uint32_t, float> baked_animation_frames(double aDuration, float aFramesPerSecond);
+
+	/**	Returns the (fractional) frame which is played back at the given time (in seconds, relative to the start of the clip),
+	 *	computed in the same way as baked_bone_matrix in framework/shaders/baked_animation.glsl does.
+	 *	If aLoop is true, the time wraps around at the end of the clip, otherwise it is clamped.
+	 */
+	inline float baked_animation_frame_at(const baked_animation_data& aBakedAnimation, float aTime, bool aLoop = true)
+	{
+		const auto lastFrame = static_cast<float>(aBakedAnimation.mNumFrames - 1u);
+		const auto frame = aTime * aBakedAnimation.mFramesPerSecond;
+		if (aLoop && lastFrame > 0.0f) {
+			return frame - lastFrame * std::floor(frame / lastFrame); // GLSL's mod
+		}
+		return glm::clamp(frame, 0.0f, lastFrame);
+	}
+
+	/**	Samples the given animation over the given clip's range at a fixed rate and stores
+	 *	the resulting bone matrices in the given encoding.
+	 *	The bone matrices of each frame are laid out like in the animation's target storage.
+	 *	@param	aAnimation			The animation to be baked. It is taken by value, because it is
+	 *								retargeted into temporary memory for the sampling.
+	 *	@param	aClip				The clip whose range [mStartTicks, mEndTicks] shall be baked
+	 *	@param	aFramesPerSecond	Sampling rate, which is adjusted s.t. the last frame is at the end of the clip, c.f. baked_animation_frames
+	 *	@param	aEncoding			Format of the stored bone matrices
+	 */
+	extern baked_animation_data bake_animation(animation aAnimation, const animation_clip_data& aClip, float aFramesPerSecond, bone_matrix_encoding aEncoding = bone_matrix_encoding::mat3x4);
+
+	/**	Uploads baked animation data into a device-local storage buffer, which can be bound to
+	 *	the buffer declared in framework/shaders/baked_animation.glsl.
+	 *	@param	aBakedAnimation		The baked animation data
+	 *	@param	aSyncHandler		How to synchronize the upload
+	 */
+	extern avk::buffer create_baked_animation_buffer(const baked_animation_data& aBakedAnimation, avk::sync aSyncHandler = avk::sync::wait_idle());
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Formats in which bone matrices can be stored for the GPU */
+	enum struct bone_matrix_encoding
+	{
+		/** Full 4x4 matrix in column-major order, 4 vec4s (64 bytes) */
+		mat4 = 0,
+		/** The first three rows of the matrix, i.e. a row-major 3x4 matrix, 3 vec4s (48 bytes) */
+		mat3x4 = 1,
+		/**	Dual quaternion: real part (x, y, z, w) followed by dual part (x, y, z, w), 2 vec4s (32 bytes).
+		 *	Dual quaternions can only represent rotations and translations, i.e. scaling is lost.
+		 */
+		dual_quaternion = 2
+	};
+
+	/** Returns the number of vec4 elements which one bone matrix occupies in the given encoding */
+	static inline size_t number_of_vec4s_per_bone(bone_matrix_encoding aEncoding)
+	{
+		switch (aEncoding) {
+		case bone_matrix_encoding::mat4:
+			return 4;
+		case bone_matrix_encoding::mat3x4:
+			return 3;
+		case bone_matrix_encoding::dual_quaternion:
+			return 2;
+		default:
+			throw gvk::logic_error("Unknown bone_matrix_encoding");
+		}
+	}
+
+	/**	Encodes the given bone matrix and writes the result into aTarget, which must
+	 *	be able to hold number_of_vec4s_per_bone(aEncoding) elements.
+	 */
+	static inline void encode_bone_matrix(const glm::mat4& aBoneMatrix, bone_matrix_encoding aEncoding, glm::vec4* aTarget)
+	{
+		switch (aEncoding) {
+		case bone_matrix_encoding::mat4:
+			for (glm::length_t col = 0; col < 4; ++col) {
+				aTarget[col] = aBoneMatrix[col];
+			}
+			break;
+		case bone_matrix_encoding::mat3x4:
+			for (glm::length_t row = 0; row < 3; ++row) {
+				aTarget[row] = glm::vec4{ aBoneMatrix[0][row], aBoneMatrix[1][row], aBoneMatrix[2][row], aBoneMatrix[3][row] };
+			}
+			break;
+		case bone_matrix_encoding::dual_quaternion:
+		{
+			// Remove the scaling from the basis vectors before extracting the rotation:
+			const glm::mat3 rotationMatrix{ glm::normalize(glm::vec3{ aBoneMatrix[0] }), glm::normalize(glm::vec3{ aBoneMatrix[1] }), glm::normalize(glm::vec3{ aBoneMatrix[2] }) };
+			const glm::quat real = glm::normalize(glm::quat_cast(rotationMatrix));
+			const glm::vec3 t{ aBoneMatrix[3] };
+			// dual = 0.5 * (0, t) * real
+			const glm::vec3 rv{ real.x, real.y, real.z };
+			const glm::vec3 dv = 0.5f * (real.w * t + glm::cross(t, rv));
+			aTarget[0] = glm::vec4{ rv, real.w };
+			aTarget[1] = glm::vec4{ dv, -0.5f * glm::dot(t, rv) };
+			break;
+		}
+		default:
+			throw gvk::logic_error("Unknown bone_matrix_encoding");
+		}
+	}
+
+	/**	Writes the given bone matrix in the given encoding into the target storage.
+	 *	Target pointers always address bone matrices in units of glm::mat4, as they are set up by
+	 *	model_t::prepare_animation_for_meshes_into_strided_contiguous_memory. For the other encodings,
+	 *	only the offset of aTarget relative to aTargetStorageBegin is used, which is the bone's slot
+	 *	in the target storage, i.e. the encoded bone matrices are tightly packed.
+	 *	@param	aBoneMatrix				The bone matrix to be written
+	 *	@param	aEncoding				The encoding of the target storage
+	 *	@param	aTargetStorageBegin		Memory address of the beginning of the target storage
+	 *	@param	aTarget					Target pointer of the bone matrix
+	 */
+	static inline void write_bone_matrix(const glm::mat4& aBoneMatrix, bone_matrix_encoding aEncoding, glm::mat4* aTargetStorageBegin, glm::mat4* aTarget)
+	{
+		if (bone_matrix_encoding::mat4 == aEncoding) {
+			*aTarget = aBoneMatrix;
+			return;
+		}
+		const auto slot = static_cast<size_t>(aTarget - aTargetStorageBegin);
+		encode_bone_matrix(aBoneMatrix, aEncoding, reinterpret_cast<glm::vec4*>(aTargetStorageBegin) + slot * number_of_vec4s_per_bone(aEncoding));
+	}
+}
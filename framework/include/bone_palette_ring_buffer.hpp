@@ -0,0 +1,79 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	GPU buffers for bone matrices, which animations write into directly.
+	 *
+	 *	There is one buffer (a "slice") per frame in flight, each of which is persistently mapped
+	 *	into host-coherent memory. While the GPU reads the bone matrices of a previous frame from
+	 *	its slice, the current frame's animations write into the current frame's slice. This
+	 *	avoids the intermediate copy of the bone matrices in CPU memory and an upload per frame.
+	 *
+	 *	The slices are rotated automatically with the main window's current frame, i.e. the
+	 *	slice in use is always the one with the index window::current_in_flight_index().
+	 *	Use animate() to retarget an animation to the current slice and evaluate it.
+	 */
+	class bone_palette_ring_buffer
+	{
+	public:
+		bone_palette_ring_buffer() = default;
+		bone_palette_ring_buffer(bone_palette_ring_buffer&& aOther) noexcept;
+		bone_palette_ring_buffer(const bone_palette_ring_buffer&) = delete;
+		bone_palette_ring_buffer& operator=(bone_palette_ring_buffer&& aOther) noexcept;
+		bone_palette_ring_buffer& operator=(const bone_palette_ring_buffer&) = delete;
+		~bone_palette_ring_buffer();
+
+		/**	Creates one persistently mapped storage buffer per frame in flight of the main window.
+		 *	The buffers are always allocated in host-coherent memory (avk::memory_usage::host_coherent),
+		 *	since the slices are written through their mapped pointers without flushing them.
+		 *	@param	aNumBoneMatrices	Number of bone matrices (in units of glm::mat4) which each slice can hold
+		 */
+		static bone_palette_ring_buffer create(size_t aNumBoneMatrices);
+
+		/** Returns the number of bone matrices which each slice can hold */
+		size_t number_of_bone_matrices() const { return mNumBoneMatrices; }
+
+		/** Returns the number of slices, i.e. the number of frames in flight */
+		size_t number_of_slices() const { return mBuffers.size(); }
+
+		/** Returns the index of the slice which is used in the current frame */
+		size_t current_slice_index() const;
+
+		/** Returns the mapped memory of the current frame's slice */
+		glm::mat4* current_slice() const { return slice(current_slice_index()); }
+
+		/** Returns the mapped memory of the given slice */
+		glm::mat4* slice(size_t aSliceIndex) const { return mMappedSlices[aSliceIndex]; }
+
+		/** Returns the buffer of the current frame's slice, to be bound to the shaders of the current frame */
+		const avk::buffer& current_buffer() const { return buffer(current_slice_index()); }
+
+		/** Returns the buffer of the given slice */
+		const avk::buffer& buffer(size_t aSliceIndex) const { return mBuffers[aSliceIndex]; }
+
+		/**	Retargets the given animation to the current frame's slice if it is not targeted at it
+		 *	already, and evaluates it. Works with animation, compiled_animation, and compressed_animation.
+		 *	@param	aAnimation		The animation to evaluate
+		 *	@param	aClip			The clip to be played
+		 *	@param	aTime			Time in seconds
+		 *	@param	aOffset			Offset of the animation's target storage within the slice, in units of glm::mat4
+		 */
+		template <typename A>
+		void animate(A& aAnimation, const animation_clip_data& aClip, double aTime, size_t aOffset = 0)
+		{
+			auto* target = current_slice() + aOffset;
+			if (aAnimation.target_storage_begin() != target) {
+				aAnimation.retarget(target);
+			}
+			aAnimation.animate(aClip, aTime);
+		}
+
+	private:
+		void unmap_all();
+
+		std::vector<avk::buffer> mBuffers;
+		std::vector<glm::mat4*> mMappedSlices;
+		size_t mNumBoneMatrices = 0;
+	};
+}
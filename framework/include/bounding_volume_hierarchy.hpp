@@ -0,0 +1,128 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Result of bounding_volume_hierarchy::intersect_ray */
+	struct bvh_ray_hit
+	{
+		uint32_t mPrimitiveIndex;
+		/** Distance from the ray's origin, in multiples of the ray's direction */
+		float mDistance;
+	};
+
+	/** Result of bounding_volume_hierarchy::find_nearest */
+	struct bvh_nearest_primitive
+	{
+		uint32_t mPrimitiveIndex;
+		float mDistance;
+	};
+
+	/**	A bounding volume hierarchy (BVH) over primitives which are given by their axis-aligned
+	 *	bounding boxes, e.g. the world space bounds of all meshes of all instances of an ORCA scene
+	 *	(c.f. get_orca_mesh_instances). It answers frustum, ray, and nearest-primitive queries in
+	 *	sub-linear time.
+	 *
+	 *	The hierarchy is built top-down with a binned surface area heuristic (SAH): The split
+	 *	candidates of a node are the borders of sNumBins equally sized bins along the axis of
+	 *	the largest extent of its primitives' centroids. The subtrees of large nodes are built
+	 *	concurrently if a thread_pool is passed to build.
+	 *
+	 *	When primitives move, refit updates the bounds of the nodes without changing the topology,
+	 *	which is much cheaper than a rebuild. The quality of the hierarchy degrades if primitives
+	 *	move a lot, though. Compare sah_cost() to its value after the last build in order to
+	 *	decide when to rebuild.
+	 *
+	 *	The queries do not modify the hierarchy, i.e. they can be executed concurrently.
+	 */
+	class bounding_volume_hierarchy
+	{
+	public:
+		static constexpr uint32_t sNumBins = 16;
+
+		/** A node of the hierarchy. The primitives of every node's subtree are stored consecutively in primitive_indices(). */
+		struct node
+		{
+			bounding_box mBounds;
+			/** Index of the first primitive of this node's subtree in primitive_indices() */
+			uint32_t mFirstPrimitive;
+			/** Number of primitives in this node's subtree */
+			uint32_t mNumPrimitives;
+			/** Index of the left child, where the right child is stored right after it. 0 for leaves. */
+			uint32_t mLeftChild;
+		};
+
+		bounding_volume_hierarchy() = default;
+		bounding_volume_hierarchy(bounding_volume_hierarchy&&) noexcept = default;
+		bounding_volume_hierarchy(const bounding_volume_hierarchy&) = default;
+		bounding_volume_hierarchy& operator=(bounding_volume_hierarchy&&) noexcept = default;
+		bounding_volume_hierarchy& operator=(const bounding_volume_hierarchy&) = default;
+		~bounding_volume_hierarchy() = default;
+
+		/**	Builds the hierarchy on the calling thread.
+		 *	@param	aPrimitiveBounds	Bounding box of every primitive. A primitive's index is its index in this vector.
+		 *	@param	aMaxLeafSize		Nodes with at most this many primitives become leaves
+		 */
+		void build(std::vector<bounding_box> aPrimitiveBounds, uint32_t aMaxLeafSize = 4);
+
+		/** Builds the hierarchy like the other overload, where large nodes are binned and their subtrees are built concurrently on the given thread pool. */
+		void build(thread_pool& aThreadPool, std::vector<bounding_box> aPrimitiveBounds, uint32_t aMaxLeafSize = 4);
+
+		/** Updates the bounds of all primitives and refits all nodes. aPrimitiveBounds must contain as many entries as the hierarchy has primitives. */
+		void refit(std::vector<bounding_box> aPrimitiveBounds);
+
+		/**	Updates the bounds of some primitives and refits only the nodes above them.
+		 *	@param	aPrimitiveIndices	Indices of the primitives which have changed
+		 *	@param	aNewBounds			New bounding box of each primitive in aPrimitiveIndices, at the same index
+		 */
+		void refit(const std::vector<uint32_t>& aPrimitiveIndices, const std::vector<bounding_box>& aNewBounds);
+
+		/**	Gathers the indices of all primitives which are not completely outside of the given frustum.
+		 *	Subtrees which are completely inside of the frustum are added without testing their primitives.
+		 *	@param	aFrustum				The frustum to test against, in the same space as the primitives' bounds
+		 *	@param	aVisibleIndicesOut		Is cleared, then receives the indices of the visible primitives in no particular order.
+		 */
+		void query_frustum(const frustum& aFrustum, std::vector<uint32_t>& aVisibleIndicesOut) const;
+
+		/**	Finds the closest primitive which is hit by the given ray, e.g. for picking.
+		 *	@param	aOrigin					Origin of the ray
+		 *	@param	aDirection				Direction of the ray, which does not have to be normalized
+		 *	@param	aMaxDistance			Hits farther away than this (in multiples of aDirection) are ignored
+		 *	@param	aPrimitiveIntersector	Optional exact test of a primitive whose bounding box is hit: Receives the primitive
+		 *									index and returns the distance of the hit, or nothing if the primitive is missed.
+		 *									If not set, the distance to a primitive's bounding box is used.
+		 */
+		std::optional<bvh_ray_hit> intersect_ray(const glm::vec3& aOrigin, const glm::vec3& aDirection, float aMaxDistance = std::numeric_limits<float>::infinity(), const std::function<std::optional<float>(uint32_t)>& aPrimitiveIntersector = {}) const;
+
+		/**	Finds the primitive which is closest to the given point.
+		 *	@param	aPoint					The query point
+		 *	@param	aMaxDistance			Primitives farther away than this are ignored
+		 *	@param	aPrimitiveDistance		Optional exact distance of a primitive: Receives the primitive index and returns the
+		 *									distance from aPoint, which must not be less than the distance to the primitive's
+		 *									bounding box. If not set, the distance to a primitive's bounding box is used.
+		 */
+		std::optional<bvh_nearest_primitive> find_nearest(const glm::vec3& aPoint, float aMaxDistance = std::numeric_limits<float>::infinity(), const std::function<float(uint32_t)>& aPrimitiveDistance = {}) const;
+
+		/** Returns the cost of the hierarchy according to the surface area heuristic, relative to the root's surface area */
+		float sah_cost() const;
+
+		bool empty() const { return mNodes.empty(); }
+		const std::vector<node>& nodes() const { return mNodes; }
+		const std::vector<uint32_t>& primitive_indices() const { return mPrimitiveIndices; }
+		const std::vector<bounding_box>& primitive_bounds() const { return mPrimitiveBounds; }
+
+	private:
+		void build(thread_pool* aThreadPool, std::vector<bounding_box> aPrimitiveBounds, uint32_t aMaxLeafSize);
+		void build_node(uint32_t aNodeIndex, uint32_t aFirst, uint32_t aCount, const std::vector<glm::vec3>& aCentroids, std::atomic<uint32_t>& aNextNode, thread_pool* aThreadPool);
+		bounding_box leaf_bounds(const node& aNode) const;
+
+		std::vector<node> mNodes;
+		std::vector<uint32_t> mPrimitiveIndices;
+		std::vector<bounding_box> mPrimitiveBounds;
+		/** Parent of every node, where the root's parent is 0 as well */
+		std::vector<uint32_t> mParents;
+		/** Leaf node of every primitive */
+		std::vector<uint32_t> mLeafOfPrimitive;
+		uint32_t mMaxLeafSize = 4;
+	};
+}
@@ -89,6 +89,10 @@ namespace gvk
 		// both matrices combined together.
 		glm::mat4 projection_and_view_matrix() const;
 
+		// Extracts the world space frustum planes from projection_and_view_matrix(),
+		// to be used with cull_bounding_boxes or cull_bounding_spheres.
+		frustum view_frustum() const;
+
 	protected:
 		void update_projection_matrix();
 
@@ -0,0 +1,117 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Same as animation::find_positions_in_keys, but for float key times stored contiguously.
+	 *	@param	aTimes		Key times in ascending order
+	 *	@param	aCount		Number of key times, must be greater than 0
+	 *	@param	aTime		Time to search for
+	 *	@param	aCursor		Position found during the previous invocation; updated to the returned position
+	 *	@return	The position of the last key whose time is not greater than aTime, or 0 if there is none.
+	 */
+	extern uint32_t find_position_in_times(const float* aTimes, uint32_t aCount, float aTime, uint32_t& aCursor);
+
+	/**	Alternative representation of an animation, which is optimized for evaluation speed.
+	 *	It is created from an animation via animation::compile() and writes the same bone
+	 *	matrices into the same target storage as the animation it has been created from.
+	 *
+	 *	Differences to class animation:
+	 *	 - The keys are stored in structure-of-arrays streams with float times (in ticks).
+	 *	 - The sampled translations, rotations, and scalings of multiple nodes are interpolated
+	 *	   and composed into local matrices at once with SIMD instructions: four nodes with SSE,
+	 *	   or eight nodes if compiled with AVX support (i.e. if __AVX__ is defined).
+	 *	 - Rotations are interpolated via nlerp, i.e. along the shortest path and normalized.
+	 *	 - The hierarchy is resolved in topological order (parents before children), which is
+	 *	   the order in which the nodes are stored in an animation.
+	 */
+	class compiled_animation
+	{
+		friend class animation;
+		friend class gpu_animation;
+
+	public:
+		compiled_animation() = default;
+		compiled_animation(compiled_animation&&) noexcept = default;
+		compiled_animation(const compiled_animation&) = default;
+		compiled_animation& operator=(compiled_animation&&) noexcept = default;
+		compiled_animation& operator=(const compiled_animation&) = default;
+		~compiled_animation() = default;
+
+		/**	Evaluates the animation at the given time and writes the resulting bone matrices
+		 *	into the target storage.
+		 *	@param	aClip	Clip data, which must refer to the same animation index which this
+		 *					compiled_animation has been created from.
+		 *	@param	aTime	Time in seconds
+		 */
+		void animate(const animation_clip_data& aClip, double aTime);
+
+		/** Returns the number of animated nodes */
+		size_t number_of_nodes() const { return mNumNodes; }
+
+		/** Returns the memory address of the first bone matrix of the first mesh, c.f. animation::target_storage_begin() */
+		glm::mat4* target_storage_begin() const { return mTargetStorageBegin; }
+
+		/** Returns the number of bone matrices which the target storage must be able to hold, c.f. animation::target_storage_size() */
+		size_t target_storage_size() const { return mTargetStorageSize; }
+
+		/** Changes the target storage which bone matrices are written into, c.f. animation::retarget() */
+		void retarget(glm::mat4* aNewBeginningOfTargetStorage);
+
+		/** Sets the format in which bone matrices are written into the target storage, c.f. animation::set_output_encoding() */
+		void set_output_encoding(bone_matrix_encoding aEncoding) { mOutputEncoding = aEncoding; }
+
+		/** Returns the format in which bone matrices are written into the target storage */
+		bone_matrix_encoding output_encoding() const { return mOutputEncoding; }
+
+	private:
+		/**	Keys of one channel (i.e. positions, rotations, or scalings) of all nodes.
+		 *	The keys of node i are stored in the range [mOffsets[i], mOffsets[i] + mCounts[i])
+		 *	of mTimes and mValues.
+		 */
+		struct key_stream
+		{
+			std::vector<uint32_t> mOffsets;
+			std::vector<uint32_t> mCounts;
+			std::vector<uint32_t> mCursors;
+			std::vector<float> mTimes;
+			std::array<std::vector<float>, 4> mValues;
+		};
+
+		/**	Bone matrix to be written for one node and one mesh,
+		 *	c.f. bone_mesh_data
+		 */
+		struct bone_output
+		{
+			size_t mNodeIndex;
+			glm::mat4 mInverseMeshRootMatrix;
+			glm::mat4 mInverseBindPoseMatrix;
+			glm::mat4* mBoneMatrixTarget;
+		};
+
+		/**	Samples the given stream for all nodes and stores the two keys' values
+		 *	and the interpolation factors as SoA into the given arrays.
+		 */
+		void gather_keys(key_stream& aStream, float aTime, const glm::vec4& aDefaultValue, size_t aNumComponents, float* aFrom, float* aTo, float* aFactors);
+
+		key_stream mPositions;
+		key_stream mRotations;
+		key_stream mScalings;
+
+		/** Index of the animated parent node for each node, or -1 if there is none. */
+		std::vector<int64_t> mParentIndices;
+		std::vector<glm::mat4> mParentTransforms;
+		std::vector<glm::mat4> mGlobalTransforms;
+		std::vector<bone_output> mBoneOutputs;
+
+		/** Scratch memory for the SoA evaluation, holds all components for mNumPaddedNodes nodes. */
+		std::vector<float> mScratch;
+
+		glm::mat4* mTargetStorageBegin = nullptr;
+		size_t mTargetStorageSize = 0;
+		bone_matrix_encoding mOutputEncoding = bone_matrix_encoding::mat4;
+		uint32_t mAnimationIndex = 0;
+		size_t mNumNodes = 0;
+		size_t mNumPaddedNodes = 0;
+	};
+}
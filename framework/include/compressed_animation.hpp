@@ -0,0 +1,136 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Statistics about the compression of an animation, as returned by compressed_animation::report().
+	 *	Sizes are given in bytes and refer to the key data only, i.e. without the hierarchy and bone data,
+	 *	which are the same for both representations.
+	 */
+	struct animation_compression_report
+	{
+		uint32_t mAnimationIndex;
+		size_t mNumKeysBefore;
+		size_t mNumKeysAfter;
+		size_t mBytesBefore;
+		size_t mBytesAfter;
+
+		/** Returns the ratio of the size before to the size after the compression */
+		double compression_ratio() const { return 0 == mBytesAfter ? 1.0 : static_cast<double>(mBytesBefore) / static_cast<double>(mBytesAfter); }
+	};
+
+	/**	Compressed representation of an animation, which is created via animation::compress()
+	 *	and writes the same bone matrices into the same target storage as the animation it has
+	 *	been created from.
+	 *
+	 *	Compression is performed in two steps:
+	 *	 1. Keyframe reduction: Keys which can be reconstructed within the configured tolerance
+	 *	    by interpolating between the remaining keys are removed. Tracks which are constant
+	 *	    within the tolerance are reduced to one key.
+	 *	 2. Quantization: Rotations are stored as smallest-three quaternions in 48 bits, i.e. the
+	 *	    index of the largest component in 2 bits and the other three components in 15 bits each.
+	 *	    Translations and scalings are stored with 16 bits per component, relative to the
+	 *	    value range of each track. Key times are stored as floats (in ticks).
+	 *
+	 *	The quantization error comes on top of the tolerances of the keyframe reduction.
+	 *	Rotations are interpolated via nlerp, i.e. along the shortest path and normalized.
+	 */
+	class compressed_animation
+	{
+		friend class animation;
+
+	public:
+		compressed_animation() = default;
+		compressed_animation(compressed_animation&&) noexcept = default;
+		compressed_animation(const compressed_animation&) = default;
+		compressed_animation& operator=(compressed_animation&&) noexcept = default;
+		compressed_animation& operator=(const compressed_animation&) = default;
+		~compressed_animation() = default;
+
+		/**	Evaluates the animation at the given time and writes the resulting bone matrices
+		 *	into the target storage.
+		 *	@param	aClip	Clip data, which must refer to the same animation index which this
+		 *					compressed_animation has been created from.
+		 *	@param	aTime	Time in seconds
+		 */
+		void animate(const animation_clip_data& aClip, double aTime);
+
+		/** Returns the number of keys and the memory consumption before and after the compression */
+		const animation_compression_report& report() const { return mReport; }
+
+		/** Returns the number of animated nodes */
+		size_t number_of_nodes() const { return mNodes.size(); }
+
+		/** Returns the memory address of the first bone matrix of the first mesh, c.f. animation::target_storage_begin() */
+		glm::mat4* target_storage_begin() const { return mTargetStorageBegin; }
+
+		/** Returns the number of bone matrices which the target storage must be able to hold, c.f. animation::target_storage_size() */
+		size_t target_storage_size() const { return mTargetStorageSize; }
+
+		/** Changes the target storage which bone matrices are written into, c.f. animation::retarget() */
+		void retarget(glm::mat4* aNewBeginningOfTargetStorage);
+
+		/** Sets the format in which bone matrices are written into the target storage, c.f. animation::set_output_encoding() */
+		void set_output_encoding(bone_matrix_encoding aEncoding) { mOutputEncoding = aEncoding; }
+
+		/** Returns the format in which bone matrices are written into the target storage */
+		bone_matrix_encoding output_encoding() const { return mOutputEncoding; }
+
+	private:
+		/**	Keys of one channel of one node, which are stored in the range [mOffset, mOffset + mCount)
+		 *	of the channel's times and values. For translations and scalings, the quantized values
+		 *	are relative to [mMin, mMin + mExtent].
+		 */
+		struct track
+		{
+			uint32_t mOffset;
+			uint32_t mCount;
+			uint32_t mCursor;
+			glm::vec3 mMin;
+			glm::vec3 mExtent;
+		};
+
+		struct node
+		{
+			track mPositions;
+			track mRotations;
+			track mScalings;
+			/** Index of the animated parent node, or -1 if there is none. */
+			int64_t mParentIndex;
+			glm::mat4 mParentTransform;
+		};
+
+		/**	Bone matrix to be written for one node and one mesh,
+		 *	c.f. bone_mesh_data
+		 */
+		struct bone_output
+		{
+			size_t mNodeIndex;
+			glm::mat4 mInverseMeshRootMatrix;
+			glm::mat4 mInverseBindPoseMatrix;
+			glm::mat4* mBoneMatrixTarget;
+		};
+
+		using quantized_value = std::array<uint16_t, 3>;
+
+		glm::vec3 sample_vec3(track& aTrack, const std::vector<float>& aTimes, const std::vector<quantized_value>& aValues, float aTime, const glm::vec3& aDefaultValue);
+		glm::quat sample_quat(track& aTrack, float aTime);
+
+		std::vector<node> mNodes;
+		std::vector<glm::mat4> mGlobalTransforms;
+		std::vector<bone_output> mBoneOutputs;
+
+		std::vector<float> mPositionTimes;
+		std::vector<quantized_value> mPositionValues;
+		std::vector<float> mRotationTimes;
+		std::vector<quantized_value> mRotationValues;
+		std::vector<float> mScalingTimes;
+		std::vector<quantized_value> mScalingValues;
+
+		animation_compression_report mReport;
+		glm::mat4* mTargetStorageBegin = nullptr;
+		size_t mTargetStorageSize = 0;
+		bone_matrix_encoding mOutputEncoding = bone_matrix_encoding::mat4;
+		uint32_t mAnimationIndex = 0;
+	};
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	The six planes of a view frustum in world space. Each plane is stored as (a, b, c, d)
+	 *	with a normalized normal (a, b, c) pointing into the frustum, i.e. a point p is on
+	 *	the inner side of a plane if dot(vec3(plane), p) + plane.w >= 0.
+	 */
+	struct frustum
+	{
+		/** Order of the planes in mPlanes. (Plain "near" and "far" would clash with the macros of windows.h.) */
+		enum plane_index { left_plane = 0, right_plane, bottom_plane, top_plane, near_plane, far_plane };
+		std::array<glm::vec4, 6> mPlanes;
+	};
+
+	/** Axis-aligned bounding box, given by its minimum and maximum corners */
+	struct bounding_box
+	{
+		glm::vec3 mMin;
+		glm::vec3 mMax;
+	};
+
+	/** Bounding sphere, given by its center and radius */
+	struct bounding_sphere
+	{
+		glm::vec3 mCenter;
+		float mRadius;
+	};
+
+	/**	Extracts the frustum planes from a combined projection and view matrix (Gribb/Hartmann).
+	 *	Assumes a depth range of [0, 1] in clip space, which is the case in Vulkan.
+	 *	@param	aProjectionAndViewMatrix	E.g. camera::projection_and_view_matrix()
+	 */
+	extern frustum extract_frustum(const glm::mat4& aProjectionAndViewMatrix);
+
+	/**	Returns the axis-aligned bounding box of the given positions, e.g. of a mesh's positions_for_mesh,
+	 *	or a box of zero size at the origin if there are no positions.
+	 */
+	extern bounding_box compute_bounding_box(const std::vector<glm::vec3>& aPositions);
+
+	/**	Transforms the given bounding box and returns the axis-aligned bounding box of the result,
+	 *	e.g. to get from a mesh's bounding box in mesh space to its bounding box in world space.
+	 */
+	extern bounding_box transform_bounding_box(const bounding_box& aBox, const glm::mat4& aMatrix);
+
+	/** Returns false if the given bounding box is completely outside of the frustum, true otherwise (conservative) */
+	extern bool is_inside_frustum(const frustum& aFrustum, const bounding_box& aBox);
+
+	/** Returns false if the given bounding sphere is completely outside of the frustum, true otherwise (conservative) */
+	extern bool is_inside_frustum(const frustum& aFrustum, const bounding_sphere& aSphere);
+
+	/**	Tests an array of bounding boxes against a frustum, 8 boxes at a time if AVX2 is available
+	 *	(c.f. active_simd_instruction_set), and writes the indices of those which are not culled.
+	 *	@param	aFrustum				The frustum to test against
+	 *	@param	aBoxes					Pointer to aCount bounding boxes in the same space as aFrustum
+	 *	@param	aCount					Number of bounding boxes
+	 *	@param	aVisibleIndicesOut		Is cleared, then receives the indices of the visible boxes in ascending order.
+	 *									Its capacity is reused, i.e. keep it around between frames.
+	 */
+	extern void cull_bounding_boxes(const frustum& aFrustum, const bounding_box* aBoxes, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut);
+
+	/**	Parallel version of cull_bounding_boxes: Splits the boxes into chunks of aBoxesPerTask,
+	 *	which are tested on the given thread pool. Counts of up to aBoxesPerTask are tested on
+	 *	the calling thread only. The result is the same as the one of the serial version.
+	 */
+	extern void cull_bounding_boxes(thread_pool& aThreadPool, const frustum& aFrustum, const bounding_box* aBoxes, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut, size_t aBoxesPerTask = 16384);
+
+	/**	Tests an array of bounding spheres against a frustum, 8 spheres at a time if AVX2 is available
+	 *	(c.f. active_simd_instruction_set), and writes the indices of those which are not culled.
+	 *	@param	aFrustum				The frustum to test against
+	 *	@param	aSpheres				Pointer to aCount bounding spheres in the same space as aFrustum
+	 *	@param	aCount					Number of bounding spheres
+	 *	@param	aVisibleIndicesOut		Is cleared, then receives the indices of the visible spheres in ascending order.
+	 *									Its capacity is reused, i.e. keep it around between frames.
+	 */
+	extern void cull_bounding_spheres(const frustum& aFrustum, const bounding_sphere* aSpheres, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut);
+
+	/**	Parallel version of cull_bounding_spheres: Splits the spheres into chunks of aSpheresPerTask,
+	 *	which are tested on the given thread pool. Counts of up to aSpheresPerTask are tested on
+	 *	the calling thread only. The result is the same as the one of the serial version.
+	 */
+	extern void cull_bounding_spheres(thread_pool& aThreadPool, const frustum& aFrustum, const bounding_sphere* aSpheres, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut, size_t aSpheresPerTask = 16384);
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Per-node data of a gpu_animation in the format of the compute shader's storage buffer (std430). */
+	struct gpu_animation_node_data
+	{
+		glm::mat4 mParentTransform;
+		int32_t mParentIndex;
+		uint32_t mPositionKeysOffset;
+		uint32_t mPositionKeysCount;
+		uint32_t mRotationKeysOffset;
+		uint32_t mRotationKeysCount;
+		uint32_t mScalingKeysOffset;
+		uint32_t mScalingKeysCount;
+		uint32_t mPadding;
+	};
+
+	/** Per-bone data of a gpu_animation in the format of the compute shader's storage buffer (std430). */
+	struct gpu_animation_bone_data
+	{
+		glm::mat4 mInverseMeshRootMatrix;
+		glm::mat4 mInverseBindPoseMatrix;
+		uint32_t mNodeIndex;
+		/** Index of the bone matrix, relative to the instance's mBoneMatrixOffset */
+		uint32_t mTargetIndex;
+		uint32_t mPadding0;
+		uint32_t mPadding1;
+	};
+
+	/** Per-instance state of a gpu_animation, which is all that has to be updated per frame. */
+	struct gpu_animation_instance_data
+	{
+		float mTimeInTicks;
+		/** Index of the instance's first bone matrix in the bone matrices buffer */
+		uint32_t mBoneMatrixOffset;
+		uint32_t mPadding0;
+		uint32_t mPadding1;
+	};
+
+	/**	Evaluates an animation in a compute shader, for many instances at once.
+	 *
+	 *	The keys, the hierarchy, and the bone data of an animation are uploaded into GPU buffers
+	 *	once. Per frame, only a gpu_animation_instance_data entry per instance is uploaded. The
+	 *	compute shader samples the keys (binary search + lerp/nlerp), composes the hierarchy
+	 *	level by level, and writes the final bone matrices (including the inverse bind pose and
+	 *	inverse mesh root matrices) directly into a storage buffer that is provided by the user,
+	 *	typically the one that is read by the skinning vertex shader. The bone matrices are laid
+	 *	out per instance in the same way as in the target storage that the animation has been
+	 *	prepared for, starting at the instance's mBoneMatrixOffset. They are written in the
+	 *	compiled_animation's output encoding (c.f. compiled_animation::set_output_encoding), i.e.
+	 *	each bone occupies number_of_vec4s_per_bone(output_encoding()) vec4 elements, as expected
+	 *	by framework/shaders/bone_matrix_encoding.glsl.
+	 *
+	 *	The compute shader is located at framework/shaders/gpu_animation.comp. Add it to the
+	 *	shaders of your application, s.t. it is deployed along with the application's shaders.
+	 *	It includes framework/shaders/bone_matrix_encoding.glsl, which must be deployed next to it.
+	 */
+	class gpu_animation
+	{
+	public:
+		gpu_animation() = default;
+		gpu_animation(gpu_animation&&) noexcept = default;
+		gpu_animation(const gpu_animation&) = delete;
+		gpu_animation& operator=(gpu_animation&&) noexcept = default;
+		gpu_animation& operator=(const gpu_animation&) = delete;
+		~gpu_animation() = default;
+
+		/**	Uploads the data of the given animation into GPU buffers and creates the compute pipeline.
+		 *	@param	aAnimation			The animation to be evaluated on the GPU
+		 *	@param	aMaxNumInstances	Maximum number of instances which can be evaluated with one record_animate call
+		 *	@param	aShaderPath			Path to the deployed compute shader
+		 *	@param	aSyncHandler		How to synchronize the upload of the buffers
+		 */
+		static gpu_animation create(const compiled_animation& aAnimation, uint32_t aMaxNumInstances, const std::string& aShaderPath = "shaders/gpu_animation.comp", avk::sync aSyncHandler = avk::sync::wait_idle());
+
+		/** Returns the number of bone matrices which each instance writes, c.f. compiled_animation::target_storage_size() */
+		uint32_t bone_matrices_per_instance() const { return mBoneMatricesPerInstance; }
+
+		/** Returns the format in which the bone matrices are written, which is the compiled_animation's output encoding */
+		bone_matrix_encoding output_encoding() const { return mOutputEncoding; }
+
+		/** Returns the maximum number of instances */
+		uint32_t max_number_of_instances() const { return mMaxNumInstances; }
+
+		/**	Sets the state of one instance
+		 *	@param	aInstanceIndex		Index of the instance in the range [0, max_number_of_instances())
+		 *	@param	aClip				The clip to be played
+		 *	@param	aTime				Time in seconds
+		 *	@param	aBoneMatrixOffset	Index of the instance's first bone matrix in the bone matrices buffer, in units of bones
+		 *								(i.e. of number_of_vec4s_per_bone(output_encoding()) vec4 elements)
+		 */
+		void set_instance(uint32_t aInstanceIndex, const animation_clip_data& aClip, double aTime, uint32_t aBoneMatrixOffset);
+
+		/**	Records the compute dispatch which evaluates the first aNumInstances instances into the given command buffer.
+		 *	The instances' state is uploaded into a buffer for the current frame in flight, and the compute shader uses
+		 *	scratch memory for the current frame in flight, i.e. it must be recorded at most once per frame. Afterwards, a barrier is
+		 *	established, which makes the bone matrices available to vertex shaders.
+		 *	@param	aCommandBuffer			Command buffer to record into
+		 *	@param	aBoneMatricesBuffer		Storage buffer which the bone matrices are written into, in output_encoding()
+		 *	@param	aNumInstances			Number of instances to evaluate
+		 */
+		void record_animate(avk::command_buffer_t& aCommandBuffer, const avk::buffer& aBoneMatricesBuffer, uint32_t aNumInstances);
+
+	private:
+		struct push_constants
+		{
+			uint32_t mNumNodes;
+			uint32_t mNumLevels;
+			uint32_t mNumBones;
+			uint32_t mNumInstances;
+			uint32_t mEncoding;
+		};
+
+		avk::buffer mNodesBuffer;
+		avk::buffer mKeyTimesBuffer;
+		avk::buffer mKeyValuesBuffer;
+		avk::buffer mLevelsBuffer;
+		avk::buffer mBonesBuffer;
+		/** Per frame in flight */
+		std::vector<avk::buffer> mGlobalTransformsBuffers;
+		/** Per frame in flight */
+		std::vector<avk::buffer> mInstanceBuffers;
+		std::vector<gpu_animation_instance_data> mInstances;
+		avk::compute_pipeline mPipeline;
+		avk::descriptor_cache mDescriptorCache;
+		uint32_t mAnimationIndex = 0;
+		uint32_t mNumNodes = 0;
+		uint32_t mNumLevels = 0;
+		uint32_t mNumBones = 0;
+		uint32_t mBoneMatricesPerInstance = 0;
+		uint32_t mMaxNumInstances = 0;
+		bone_matrix_encoding mOutputEncoding = bone_matrix_encoding::mat4;
+	};
+}
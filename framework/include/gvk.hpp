@@ -34,8 +34,11 @@
 #include <cstdint>
 #include <chrono>
 #include <filesystem>
+#include <thread>
+#include <future>
 
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 
 // ----------------------- externals -----------------------
@@ -117,6 +120,7 @@
 #include "context_generic_glfw.hpp"
 
 #include "math_utils.hpp"
+#include "thread_pool.hpp"
 #include "key_code.hpp"
 #include "key_state.hpp"
 #include "timer_frame_type.hpp"
@@ -171,6 +175,10 @@ namespace gvk
 #include "sequential_invoker.hpp"
 
 #include "transform.hpp"
+#include "transform_batch.hpp"
+#include "transform_system.hpp"
+#include "frustum_culling.hpp"
+#include "bounding_volume_hierarchy.hpp"
 #include "camera.hpp"
 #include "quake_camera.hpp"
 #include "material_config.hpp"
@@ -179,10 +187,26 @@ namespace gvk
 #include "lightsource.hpp"
 #include "lightsource_gpu_data.hpp"
 #include "model_types.hpp"
+#include "bone_matrix_encoding.hpp"
 #include "animation.hpp"
+#include "compiled_animation.hpp"
+#include "compressed_animation.hpp"
+#include "animation_batch.hpp"
+#include "gpu_animation.hpp"
+#include "baked_animation.hpp"
+#include "bone_palette_ring_buffer.hpp"
+#include "vertex_welding.hpp"
+#include "tangent_generation.hpp"
 #include "model.hpp"
 #include "orca_scene.hpp"
+#include "texture_cache.hpp"
 #include "material_image_helpers.hpp"
+#include "texture_upload_batch.hpp"
+#include "orca_instancing.hpp"
+#include "scene_batch.hpp"
+#include "orca_scene_package.hpp"
+#include "occlusion_culling.hpp"
+#include "orca_path_benchmark.hpp"
 
 #include "composition.hpp"
 #include "setup.hpp"
@@ -52,11 +52,32 @@ namespace gvk
 		return img;
 	}
 
-	static avk::image create_image_from_file(const std::string& aPath, vk::Format aFormat, bool aFlip = true, avk::memory_usage aMemoryUsage = avk::memory_usage::device, avk::image_usage aImageUsage = avk::image_usage::general_texture, avk::sync aSyncHandler = avk::sync::wait_idle(), std::optional<gli::texture> aAlreadyLoadedGliTexture = {})
+	/**	An image which has been loaded from file and decoded on the CPU, but which has not been uploaded yet.
+	 *	C.f. decode_image_file and create_image_from_decoded_image
+	 */
+	struct decoded_image
 	{
-		std::vector<avk::buffer> stagingBuffers;
-		int width = 0;
-		int height = 0;
+		std::string mPath;
+		vk::Format mFormat;
+		int mWidth;
+		int mHeight;
+		/** The pixels of an uncompressed image as returned by stb_image, which are freed via stbi_image_free */
+		std::shared_ptr<void> mPixels;
+		/** Size of mPixels in bytes */
+		size_t mPixelsSize;
+		/** A block-compressed image, including all of its MIP levels */
+		std::optional<gli::texture> mGliTexture;
+	};
+
+	/**	Loads and decodes an image file on the CPU, which is the first part of create_image_from_file.
+	 *	It does not access the GPU or any global state, i.e., multiple images can be decoded concurrently.
+	 *	Upload the result via create_image_from_decoded_image.
+	 */
+	static decoded_image decode_image_file(const std::string& aPath, vk::Format aFormat, bool aFlip = true, std::optional<gli::texture> aAlreadyLoadedGliTexture = {})
+	{
+		decoded_image result{ aPath, aFormat, 0, 0, {}, 0, {} };
+		int& width = result.mWidth;
+		int& height = result.mHeight;
 
 		// ============ Compressed formats (DDS) ==========
 		if (avk::is_block_compressed_format(aFormat)) {
@@ -71,18 +92,13 @@ namespace gvk
 
 			width  = gliTex.extent()[0];
 			height = gliTex.extent()[1];
-
-			auto& sb = stagingBuffers.emplace_back(context().create_buffer(
-				avk::memory_usage::host_coherent,
-				vk::BufferUsageFlagBits::eTransferSrc,
-				avk::generic_buffer_meta::create_from_size(gliTex.size())
-			));
-			sb->fill(gliTex.data(), 0, avk::sync::not_required());
+			result.mGliTexture = std::move(aAlreadyLoadedGliTexture);
 		}
 		// ============ RGB 8-bit formats ==========
 		else if (avk::is_uint8_format(aFormat) || avk::is_int8_format(aFormat)) {
 
-			stbi_set_flip_vertically_on_load(aFlip);
+			// Only set the flip setting for the calling thread, so that other threads can decode images concurrently:
+			stbi_set_flip_vertically_on_load_thread(aFlip);
 			int desiredColorChannels = STBI_rgb_alpha;
 			
 			if (!avk::is_4component_format(aFormat)) { 
@@ -105,19 +121,13 @@ namespace gvk
 				throw gvk::runtime_error(fmt::format("Couldn't load image from '{}' using stbi_load", aPath));
 			}
 
-			auto& sb = stagingBuffers.emplace_back(context().create_buffer(
-				avk::memory_usage::host_coherent,
-				vk::BufferUsageFlagBits::eTransferSrc,
-				avk::generic_buffer_meta::create_from_size(imageSize)
-			));
-			sb->fill(pixels, 0, avk::sync::not_required());
-
-			stbi_image_free(pixels);
+			result.mPixels = std::shared_ptr<void>(pixels, stbi_image_free);
+			result.mPixelsSize = imageSize;
 		}
 		// ============ RGB 16-bit float formats (HDR) ==========
 		else if (avk::is_float16_format(aFormat)) {
 			
-			stbi_set_flip_vertically_on_load(true);
+			stbi_set_flip_vertically_on_load_thread(true);
 			int desiredColorChannels = STBI_rgb_alpha;
 			
 			if (!avk::is_4component_format(aFormat)) { 
@@ -140,23 +150,46 @@ namespace gvk
 				throw gvk::runtime_error(fmt::format("Couldn't load image from '{}' using stbi_loadf", aPath));
 			}
 
+			result.mPixels = std::shared_ptr<void>(pixels, stbi_image_free);
+			result.mPixelsSize = imageSize;
+		}
+		else {
+			throw gvk::runtime_error("No loader for the given image format implemented.");
+		}
+
+		return result;
+	}
+
+	/**	Uploads an image which has been decoded via decode_image_file, which is the second part of create_image_from_file.
+	 *	MIP levels of uncompressed images are generated on the GPU.
+	 */
+	static avk::image create_image_from_decoded_image(decoded_image aImage, avk::memory_usage aMemoryUsage = avk::memory_usage::device, avk::image_usage aImageUsage = avk::image_usage::general_texture, avk::sync aSyncHandler = avk::sync::wait_idle())
+	{
+		std::vector<avk::buffer> stagingBuffers;
+
+		if (aImage.mGliTexture.has_value()) {
+			auto& gliTex = aImage.mGliTexture.value();
 			auto& sb = stagingBuffers.emplace_back(context().create_buffer(
 				avk::memory_usage::host_coherent,
 				vk::BufferUsageFlagBits::eTransferSrc,
-				avk::generic_buffer_meta::create_from_size(imageSize)
+				avk::generic_buffer_meta::create_from_size(gliTex.size())
 			));
-			sb->fill(pixels, 0, avk::sync::not_required());
-			
-			stbi_image_free(pixels);
+			sb->fill(gliTex.data(), 0, avk::sync::not_required());
 		}
 		else {
-			throw gvk::runtime_error("No loader for the given image format implemented.");
+			auto& sb = stagingBuffers.emplace_back(context().create_buffer(
+				avk::memory_usage::host_coherent,
+				vk::BufferUsageFlagBits::eTransferSrc,
+				avk::generic_buffer_meta::create_from_size(aImage.mPixelsSize)
+			));
+			sb->fill(aImage.mPixels.get(), 0, avk::sync::not_required());
+			aImage.mPixels.reset();
 		}
 
 		auto& commandBuffer = aSyncHandler.get_or_create_command_buffer();
 		aSyncHandler.establish_barrier_before_the_operation(avk::pipeline_stage::transfer, avk::read_memory_access{avk::memory_access::transfer_read_access});
 
-		auto img = context().create_image(width, height, aFormat, 1, aMemoryUsage, aImageUsage);
+		auto img = context().create_image(aImage.mWidth, aImage.mHeight, aImage.mFormat, 1, aMemoryUsage, aImageUsage);
 		auto finalTargetLayout = img->target_layout(); // save for later, because first, we need to transfer something into it
 
 		// 1. Transition image layout to eTransferDstOptimal
@@ -169,13 +202,13 @@ namespace gvk
 																																				// TODO: Verify the above ^ comment
 		// Are MIP-maps required?
 		if (img->config().mipLevels > 1u) {
-			if (avk::is_block_compressed_format(aFormat)) {
-				assert (aAlreadyLoadedGliTexture.has_value());
+			if (avk::is_block_compressed_format(aImage.mFormat)) {
+				assert (aImage.mGliTexture.has_value());
 				// 1st level is contained in stagingBuffer
 				// 
 				// Now let's load further levels from the GliTexture and upload them directly into the sub-levels
 
-				auto& gliTex = aAlreadyLoadedGliTexture.value();
+				auto& gliTex = aImage.mGliTexture.value();
 				// TODO: Do we have to account for gliTex.base_level() and gliTex.max_level()?
 				for(size_t level = 1; level < gliTex.levels(); ++level)
 				{
@@ -220,8 +253,54 @@ namespace gvk
 		assert(!result.has_value());
 		return img;
 	}
+
+	static avk::image create_image_from_file(const std::string& aPath, vk::Format aFormat, bool aFlip = true, avk::memory_usage aMemoryUsage = avk::memory_usage::device, avk::image_usage aImageUsage = avk::image_usage::general_texture, avk::sync aSyncHandler = avk::sync::wait_idle(), std::optional<gli::texture> aAlreadyLoadedGliTexture = {})
+	{
+		return create_image_from_decoded_image(decode_image_file(aPath, aFormat, aFlip, std::move(aAlreadyLoadedGliTexture)), aMemoryUsage, aImageUsage, std::move(aSyncHandler));
+	}
 	
-	static avk::image create_image_from_file(const std::string& aPath, bool aLoadHdrIfPossible = true, bool aLoadSrgbIfApplicable = true, bool aFlip = true, int aPreferredNumberOfTextureComponents = 4, avk::memory_usage aMemoryUsage = avk::memory_usage::device, avk::image_usage aImageUsage = avk::image_usage::general_texture, avk::sync aSyncHandler = avk::sync::wait_idle())
+	/** Returns the Vulkan format which corresponds to the given block-compressed gli format,
+	 *	or an empty optional if there is no such (supported) format.
+	 */
+	static std::optional<vk::Format> vk_format_from_gli_format(gli::format aGliFormat)
+	{
+		switch (aGliFormat) {
+		// See "Khronos Data Format Specification": https://www.khronos.org/registry/DataFormat/specs/1.3/dataformat.1.3.html#S3TC
+		// And Vulkan specification: https://www.khronos.org/registry/vulkan/specs/1.2-khr-extensions/html/chap42.html#appendix-compressedtex-bc
+		case gli::format::FORMAT_RGB_DXT1_UNORM_BLOCK8:
+			return vk::Format::eBc1RgbUnormBlock;
+		case gli::format::FORMAT_RGB_DXT1_SRGB_BLOCK8:
+			return vk::Format::eBc1RgbSrgbBlock;
+		case gli::format::FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+			return vk::Format::eBc1RgbaUnormBlock;
+		case gli::format::FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+			return vk::Format::eBc1RgbaSrgbBlock;
+		case gli::format::FORMAT_RGBA_DXT3_UNORM_BLOCK16:
+			return vk::Format::eBc2UnormBlock;
+		case gli::format::FORMAT_RGBA_DXT3_SRGB_BLOCK16:
+			return vk::Format::eBc2SrgbBlock; 
+		case gli::format::FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+			return vk::Format::eBc3UnormBlock;
+		case gli::format::FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+			return vk::Format::eBc3SrgbBlock;
+		case gli::format::FORMAT_R_ATI1N_UNORM_BLOCK8:
+			return vk::Format::eBc4UnormBlock;
+		// See "Khronos Data Format Specification": https://www.khronos.org/registry/DataFormat/specs/1.3/dataformat.1.3.html#RGTC
+		// And Vulkan specification: https://www.khronos.org/registry/vulkan/specs/1.2-khr-extensions/html/chap42.html#appendix-compressedtex-bc
+		case gli::format::FORMAT_R_ATI1N_SNORM_BLOCK8:
+			return vk::Format::eBc4SnormBlock;
+		case gli::format::FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			return vk::Format::eBc5UnormBlock;
+		case gli::format::FORMAT_RG_ATI2N_SNORM_BLOCK16:
+			return vk::Format::eBc5SnormBlock;
+		}
+		return {};
+	}
+
+	/**	Determines the format of an image file like create_image_from_file does, then loads and decodes it on the CPU.
+	 *	Multiple images can be decoded concurrently, c.f. decode_image_file(const std::string&, vk::Format, bool, std::optional<gli::texture>)
+	 */
+	static decoded_image decode_image_file(const std::string& aPath, bool aLoadHdrIfPossible, bool aLoadSrgbIfApplicable, bool aFlip = true, int aPreferredNumberOfTextureComponents = 4)
 	{
 		std::optional<vk::Format> imFmt = {};
 
@@ -232,48 +311,7 @@ namespace gvk
 				gliTex = gli::flip(gliTex.value());
 			}
 
-			auto gliFmt = gliTex.value().format();
-			switch (gliFmt) {
-			// See "Khronos Data Format Specification": https://www.khronos.org/registry/DataFormat/specs/1.3/dataformat.1.3.html#S3TC
-			// And Vulkan specification: https://www.khronos.org/registry/vulkan/specs/1.2-khr-extensions/html/chap42.html#appendix-compressedtex-bc
-			case gli::format::FORMAT_RGB_DXT1_UNORM_BLOCK8:
-				imFmt = vk::Format::eBc1RgbUnormBlock;
-				break;
-			case gli::format::FORMAT_RGB_DXT1_SRGB_BLOCK8:
-				imFmt = vk::Format::eBc1RgbSrgbBlock;
-				break;
-			case gli::format::FORMAT_RGBA_DXT1_UNORM_BLOCK8:
-				imFmt = vk::Format::eBc1RgbaUnormBlock;
-				break;
-			case gli::format::FORMAT_RGBA_DXT1_SRGB_BLOCK8:
-				imFmt = vk::Format::eBc1RgbaSrgbBlock;
-				break;
-			case gli::format::FORMAT_RGBA_DXT3_UNORM_BLOCK16:
-				imFmt = vk::Format::eBc2UnormBlock;
-				break;
-			case gli::format::FORMAT_RGBA_DXT3_SRGB_BLOCK16:
-				imFmt = vk::Format::eBc2SrgbBlock; 
-				break;
-			case gli::format::FORMAT_RGBA_DXT5_UNORM_BLOCK16:
-				imFmt = vk::Format::eBc3UnormBlock;
-				break;
-			case gli::format::FORMAT_RGBA_DXT5_SRGB_BLOCK16:
-				imFmt = vk::Format::eBc3SrgbBlock;
-				break;
-			case gli::format::FORMAT_R_ATI1N_UNORM_BLOCK8:
-				imFmt = vk::Format::eBc4UnormBlock;
-				break;
-			// See "Khronos Data Format Specification": https://www.khronos.org/registry/DataFormat/specs/1.3/dataformat.1.3.html#RGTC
-			// And Vulkan specification: https://www.khronos.org/registry/vulkan/specs/1.2-khr-extensions/html/chap42.html#appendix-compressedtex-bc
-			case gli::format::FORMAT_R_ATI1N_SNORM_BLOCK8:
-				imFmt = vk::Format::eBc4SnormBlock;
-				break;
-			case gli::format::FORMAT_RG_ATI2N_UNORM_BLOCK16:
-				imFmt = vk::Format::eBc5UnormBlock;
-				break;
-			case gli::format::FORMAT_RG_ATI2N_SNORM_BLOCK16:
-				imFmt = vk::Format::eBc5SnormBlock;
-			}
+			imFmt = vk_format_from_gli_format(gliTex.value().format());
 		}
 		else {
 			gliTex.reset();
@@ -348,9 +386,45 @@ namespace gvk
 			throw gvk::runtime_error(fmt::format("Could not determine the image format of image '{}'", aPath));
 		}
 		
-		return create_image_from_file(aPath, imFmt.value(), aFlip, aMemoryUsage, aImageUsage, std::move(aSyncHandler), std::move(gliTex));
+		return decode_image_file(aPath, imFmt.value(), aFlip, std::move(gliTex));
 	}
 
+	static avk::image create_image_from_file(const std::string& aPath, bool aLoadHdrIfPossible = true, bool aLoadSrgbIfApplicable = true, bool aFlip = true, int aPreferredNumberOfTextureComponents = 4, avk::memory_usage aMemoryUsage = avk::memory_usage::device, avk::image_usage aImageUsage = avk::image_usage::general_texture, avk::sync aSyncHandler = avk::sync::wait_idle())
+	{
+		return create_image_from_decoded_image(decode_image_file(aPath, aLoadHdrIfPossible, aLoadSrgbIfApplicable, aFlip, aPreferredNumberOfTextureComponents), aMemoryUsage, aImageUsage, std::move(aSyncHandler));
+	}
+
+	/** Describes a texture which is referenced from material_gpu_data entries, c.f. get_material_gpu_data_and_textures */
+	struct material_texture_info
+	{
+		enum struct texture_type
+		{
+			/** 1x1 pure white texture, which replaces missing textures */
+			white_1px,
+			/** 1x1 texture containing a normal pointing straight up, which replaces missing normal maps */
+			straight_up_normal_1px,
+			/** Texture which is loaded from mPath */
+			from_file
+		};
+
+		texture_type mType;
+		std::string mPath;
+		/** True if the texture shall be loaded in an sRGB format, if applicable */
+		bool mSrgb;
+	};
+
+	/**	Converts material_config entries into material_gpu_data entries like convert_for_gpu_usage, but
+	 *	without creating any textures. Instead, a description of each texture is returned, and every
+	 *	texture index in the material_gpu_data entries refers to an element of the returned textures.
+	 *	This is the CPU-side part of convert_for_gpu_usage, which uses the same order of textures.
+	 *	@param	aMaterialConfigs		The materials to be converted
+	 *	@param	aLoadTexturesInSrgb		C.f. convert_for_gpu_usage
+	 *	@return	A tuple of the material_gpu_data entries and the descriptions of all referenced textures.
+	 */
+	extern std::tuple<std::vector<material_gpu_data>, std::vector<material_texture_info>> get_material_gpu_data_and_textures(
+		const std::vector<gvk::material_config>& aMaterialConfigs,
+		bool aLoadTexturesInSrgb = false);
+
 	/**	Takes a vector of gvk::material_config elements and converts it into a format that is usable
 	 *	in shaders. Concretely, this means that each input gvk::material_config is transformed into
 	 *	a gvk::material_gpu_data struct. The latter no longer contains the paths to images, but
@@ -386,6 +460,8 @@ namespace gvk
 	 *	@param	aTextureFilterMode		Texture filter mode for all the textures that are loaded.
 	 *	@param	aBorderHandlingMode		Border handling mode for all the textures that are loaded.
 	 *	@param	aSyncHandler			How to synchronize the GPU-upload of texture memory.
+	 *	@param	aTextureCache			If set, textures loaded from file are shared with all other users of this cache,
+	 *									e.g. &default_texture_cache(). Give them back via texture_cache::release.
 	 *	@return	A tuple of two elements: The first element contains a vector of gvk::material_gpu_data
 	 *			entries, which are gvk::material_config entries converted into a format suitable to be
 	 *			used in UBOs or SSBOs, and the second element contains a vector of avk::image_samplers,
@@ -400,7 +476,8 @@ namespace gvk
 		avk::image_usage aImageUsage = avk::image_usage::general_texture,
 		avk::filter_mode aTextureFilterMode = avk::filter_mode::trilinear,
 		avk::border_handling_mode aBorderHandlingMode = avk::border_handling_mode::repeat,
-		avk::sync aSyncHandler = avk::sync::wait_idle());
+		avk::sync aSyncHandler = avk::sync::wait_idle(),
+		texture_cache* aTextureCache = nullptr);
 
 	template <typename... Rest>
 	void add_tuple_or_indices(std::vector<std::tuple<std::reference_wrapper<const gvk::model_t>, std::vector<size_t>>>& aResult)
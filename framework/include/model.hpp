@@ -23,6 +23,27 @@ namespace gvk
 		
 		static avk::owning_resource<model_t> load_from_memory(const std::string& aMemory, aiProcessFlagsType aAssimpFlags = aiProcess_Triangulate);
 
+		/**	Joins identical vertices of all meshes of this model, using @ref weld_identical_vertices.
+		 *	The meshes are processed in parallel on the @ref default_thread_pool.
+		 *	This is intended as a faster alternative to Assimp's aiProcess_JoinIdenticalVertices
+		 *	post-processing step, i.e. load the model without that flag and invoke this afterwards.
+		 *	@return	The total number of vertices that have been removed.
+		 */
+		size_t weld_identical_vertices();
+
+		/**	Generates MikkTSpace-compatible tangents for the meshes of this model, using
+		 *	@ref generate_tangents_with_handedness. The meshes are processed in parallel on the
+		 *	@ref default_thread_pool. This is intended as a faster alternative to Assimp's
+		 *	aiProcess_CalcTangentSpace post-processing step.
+		 *	The generated tangents are stored with this model and are subsequently returned by
+		 *	`tangents_for_mesh`, `bitangents_for_mesh`, and `tangents_and_handedness_for_mesh`.
+		 *	@param	aOverwriteExisting	If false, only meshes without tangents are processed.
+		 *								If true, also the tangents which have been imported by Assimp are replaced.
+		 *	@param	aTexCoordSet		The set of texture coordinates to derive the tangents from.
+		 *	@return	The number of meshes for which tangents have been generated.
+		 */
+		size_t generate_tangents(bool aOverwriteExisting = false, int aTexCoordSet = 0);
+
 		/** Returns this model's path where it has been loaded from */
 		auto path() const { return mModelPath; }
 
@@ -124,6 +145,16 @@ namespace gvk
 		 */
 		std::vector<glm::vec3> bitangents_for_mesh(mesh_index_t aMeshIndex) const;
 
+		/** Gets all the tangents for the mesh at the given index, with the handedness stored in w,
+		 *	s.t. bitangent = w * cross(normal, tangent).
+		 *	If the mesh has no tangents, a vector filled with values is
+		 *	returned regardless. All the values will be set to (1,0,0,1) in this case.
+		 *	@param		aMeshIndex		The index corresponding to the mesh
+		 *	@return		Vector of tangents and handedness, converted to `glm::vec4`
+		 *				of length `number_of_vertices_for_mesh()`
+		 */
+		std::vector<glm::vec4> tangents_and_handedness_for_mesh(mesh_index_t aMeshIndex) const;
+
 		/** Gets all the colors of a specific color set for the mesh at the given index.
 		 *	If the mesh has no colors for the given set index, a vector filled with values is
 		 *	returned regardless. All the values will be set to (1,0,1,1) in this case (magenta).
@@ -253,6 +284,7 @@ namespace gvk
 		std::vector<glm::vec3> normals_for_meshes(std::vector<mesh_index_t> aMeshIndices) const;
 		std::vector<glm::vec3> tangents_for_meshes(std::vector<mesh_index_t> aMeshIndices) const;
 		std::vector<glm::vec3> bitangents_for_meshes(std::vector<mesh_index_t> aMeshIndices) const;
+		std::vector<glm::vec4> tangents_and_handedness_for_meshes(std::vector<mesh_index_t> aMeshIndices) const;
 		std::vector<glm::vec4> colors_for_meshes(std::vector<mesh_index_t> aMeshIndices, int aSet = 0) const;
 		std::vector<glm::vec4> bone_weights_for_meshes(std::vector<mesh_index_t> aMeshIndices) const;
 		std::vector<glm::uvec4> bone_indices_for_meshes(std::vector<mesh_index_t> aMeshIndices) const;
@@ -350,6 +382,8 @@ namespace gvk
 		std::string mModelPath;
 		const aiScene* mScene;
 		std::vector<std::optional<material_config>> mMaterialConfigPerMesh;
+		// Tangents which have been generated via generate_tangents, empty for meshes without generated tangents:
+		std::vector<std::vector<glm::vec4>> mGeneratedTangentsPerMesh;
 	};
 
 	using model = avk::owning_resource<model_t>;
@@ -0,0 +1,118 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Geometry of an occluder in mesh space, i.e. a (preferably low-poly) mesh which hides other objects. */
+	struct occluder_mesh
+	{
+		std::vector<glm::vec3> mPositions;
+		std::vector<uint32_t> mIndices;
+		bounding_box mBounds;
+	};
+
+	/**	Selects the meshes of a model which are suitable as occluders: those which are large
+	 *	compared to the whole model, but have only few triangles.
+	 *	@param	aModel				The model to select meshes from
+	 *	@param	aMinRelativeSize	Minimum length of a mesh's bounding box diagonal, relative to the diagonal of the whole model's bounding box
+	 *	@param	aMaxTriangles		Maximum number of triangles of a mesh
+	 *	@return	The geometry of the selected meshes, in mesh space
+	 */
+	extern std::vector<occluder_mesh> select_occluders(const model_t& aModel, float aMinRelativeSize = 0.2f, size_t aMaxTriangles = 4096);
+
+	/**	Software occlusion culling on the CPU.
+	 *
+	 *	Occluders are rasterized into a small depth buffer, 8 pixels at a time if AVX2 is
+	 *	available (c.f. active_simd_instruction_set). The depth buffer is organized in tiles
+	 *	of 8x4 pixels, for each of which the farthest depth is stored, which forms a coarse
+	 *	second level of a hierarchical depth buffer. Bounding boxes are tested against the
+	 *	coarse level first and only against the pixels of tiles which are not conclusive.
+	 *
+	 *	Usage per frame:
+	 *	 1. begin_frame with the camera's projection_and_view_matrix()
+	 *	 2. add_occluder for all occluders
+	 *	 3. rasterize
+	 *	 4. remove_occluded with the candidates which have passed frustum culling
+	 *	 5. draw the remaining ones, e.g. via draw_scene_batch(..., aVisibleDrawIndices)
+	 *
+	 *	Depth values are in Vulkan's range [0, 1], where smaller values are closer.
+	 *	The test is conservative: Objects which intersect the near plane are always visible.
+	 */
+	class occlusion_culler
+	{
+	public:
+		static constexpr uint32_t sTileWidth = 8;
+		static constexpr uint32_t sTileHeight = 4;
+
+		/**	Creates a culler with a depth buffer of the given resolution,
+		 *	which is rounded up to multiples of the tile size.
+		 */
+		explicit occlusion_culler(uint32_t aWidth = 256, uint32_t aHeight = 128);
+		occlusion_culler(occlusion_culler&&) noexcept = default;
+		occlusion_culler(const occlusion_culler&) = default;
+		occlusion_culler& operator=(occlusion_culler&&) noexcept = default;
+		occlusion_culler& operator=(const occlusion_culler&) = default;
+		~occlusion_culler() = default;
+
+		/** Width of the depth buffer in pixels */
+		uint32_t width() const { return mWidth; }
+		/** Height of the depth buffer in pixels */
+		uint32_t height() const { return mHeight; }
+
+		/** Removes all occluders and sets the view and projection for the following occluders and tests. */
+		void begin_frame(const glm::mat4& aProjectionAndViewMatrix);
+
+		/**	Adds an occluder, which is transformed, clipped against the near plane, and set up for rasterization.
+		 *	@param	aPositions		Vertex positions in mesh space
+		 *	@param	aIndices		Pointer to aNumIndices indices, three per triangle
+		 *	@param	aNumIndices		Number of indices
+		 *	@param	aModelMatrix	Transforms the positions into world space
+		 */
+		void add_occluder(const glm::vec3* aPositions, const uint32_t* aIndices, size_t aNumIndices, const glm::mat4& aModelMatrix);
+
+		/** Adds an occluder, c.f. the other overload */
+		void add_occluder(const occluder_mesh& aOccluder, const glm::mat4& aModelMatrix) { add_occluder(aOccluder.mPositions.data(), aOccluder.mIndices.data(), aOccluder.mIndices.size(), aModelMatrix); }
+
+		/** Rasterizes all occluders which have been added since begin_frame */
+		void rasterize();
+
+		/** Rasterizes all occluders which have been added since begin_frame, in parallel: Each task rasterizes all occluders into a horizontal band. */
+		void rasterize(thread_pool& aThreadPool);
+
+		/** Returns false if the given bounding box (in world space) is completely hidden by the rasterized occluders or off screen, true otherwise */
+		bool is_visible(const bounding_box& aBox) const;
+
+		/**	Removes the indices of all bounding boxes which are completely hidden by the rasterized occluders.
+		 *	@param	aBoxes				Bounding boxes in world space
+		 *	@param	aIndicesInOut		Indices into aBoxes which shall be tested, e.g. the result of cull_bounding_boxes.
+		 *								The indices of hidden boxes are removed, the order of the others is kept.
+		 */
+		void remove_occluded(const bounding_box* aBoxes, std::vector<uint32_t>& aIndicesInOut) const;
+
+		/** Parallel version of remove_occluded, which tests chunks of aBoxesPerTask indices on the given thread pool. */
+		void remove_occluded(thread_pool& aThreadPool, const bounding_box* aBoxes, std::vector<uint32_t>& aIndicesInOut, size_t aBoxesPerTask = 4096) const;
+
+		/** Returns the depth buffer (row by row, width() * height() values), e.g. for debugging */
+		const std::vector<float>& depth_buffer() const { return mDepth; }
+
+	private:
+		/** A triangle in screen space, given by its edge functions (A*x + B*y + C >= 0 inside) and its depth plane */
+		struct raster_triangle
+		{
+			std::array<float, 3> mEdgeA, mEdgeB, mEdgeC;
+			float mDepthA, mDepthB, mDepthC;
+			float mMinX, mMaxX, mMinY, mMaxY;
+		};
+
+		void add_screen_triangle(const glm::vec4& aClip0, const glm::vec4& aClip1, const glm::vec4& aClip2);
+		void rasterize_rows(uint32_t aRowBegin, uint32_t aRowEnd);
+		void update_tile_depths(uint32_t aRowBegin, uint32_t aRowEnd);
+
+		uint32_t mWidth;
+		uint32_t mHeight;
+		glm::mat4 mProjectionAndViewMatrix;
+		std::vector<raster_triangle> mTriangles;
+		std::vector<float> mDepth;
+		std::vector<float> mTileMaxDepth;
+	};
+}
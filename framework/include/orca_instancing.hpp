@@ -0,0 +1,86 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** One instanced draw call: all meshes of one model which share the same material,
+	 *	drawn once for every instance of the model.
+	 */
+	struct orca_instanced_draw
+	{
+		/** Index of the model in orca_scene_t::models() */
+		model_index_t mModelIndex;
+		/** The model's meshes which are drawn by this draw call */
+		std::vector<mesh_index_t> mMeshIndices;
+		/** Index into orca_instanced_draws::mMaterialConfigs */
+		uint32_t mMaterialIndex;
+		/** Index of the first instance's transform in the instance transforms buffer, passed as firstInstance */
+		uint32_t mFirstInstance;
+		/** Number of instances, i.e. the model's number of model_instance_data entries */
+		uint32_t mInstanceCount;
+		/** Number of indices of all the meshes */
+		uint32_t mIndexCount;
+
+		avk::buffer mPositionsBuffer;
+		avk::buffer mTexCoordsBuffer;
+		avk::buffer mNormalsBuffer;
+		avk::buffer mIndexBuffer;
+	};
+
+	/** All draw calls of an ORCA scene, with one draw call per model and material, instead of one per model instance.
+	 *	The transforms of all instances of all models are stored in one buffer. The instances of each model are
+	 *	stored consecutively, and since every draw call passes mFirstInstance as firstInstance, a vertex shader
+	 *	can fetch its instance's model matrix via gl_InstanceIndex.
+	 */
+	struct orca_instanced_draws
+	{
+		/** The distinct materials of all the draw calls, which can be converted via convert_for_gpu_usage */
+		std::vector<material_config> mMaterialConfigs;
+		/** The model matrices of all instances, as stored in mInstanceTransformsBuffer */
+		std::vector<glm::mat4> mInstanceTransforms;
+		/** Storage buffer containing mInstanceTransforms. It can also be bound as a vertex buffer with per-instance input rate. */
+		avk::buffer mInstanceTransformsBuffer;
+		std::vector<orca_instanced_draw> mDraws;
+	};
+
+	/** One mesh of one model instance of an ORCA scene, e.g. a primitive of a bounding_volume_hierarchy */
+	struct orca_mesh_instance
+	{
+		/** Index of the model in orca_scene_t::models() */
+		model_index_t mModelIndex;
+		/** Index of the instance in the model's model_data::mInstances */
+		size_t mInstanceIndex;
+		mesh_index_t mMeshIndex;
+		/** Bounding box of the mesh in mesh space, i.e. the same for all instances of the model */
+		bounding_box mMeshBounds;
+	};
+
+	/** Returns the model matrices of all instances of the given model, in the order of model_data::mInstances. */
+	extern std::vector<glm::mat4> instance_transforms(const model_data& aModelData);
+
+	/**	Returns all meshes of all instances of all models of the given ORCA scene, where the meshes of each
+	 *	instance are stored consecutively. The bounding box of every mesh is computed only once per model.
+	 *	@param	aScene			The scene, whose models must have been loaded
+	 */
+	extern std::vector<orca_mesh_instance> get_orca_mesh_instances(const orca_scene_t& aScene);
+
+	/**	Returns the world space bounding box of each of the given mesh instances, based on the current
+	 *	transforms of the instances in aScene, e.g. to build or refit a bounding_volume_hierarchy.
+	 *	@param	aScene			The scene which aMeshInstances have been gathered from
+	 *	@param	aMeshInstances	C.f. get_orca_mesh_instances
+	 */
+	extern std::vector<bounding_box> get_world_space_bounds(const orca_scene_t& aScene, const std::vector<orca_mesh_instance>& aMeshInstances);
+
+	/**	Groups all the meshes of all models of the given ORCA scene by model and material, creates their
+	 *	vertex and index buffers, and uploads the model matrices of all instances into one buffer.
+	 *	@param	aScene			The scene, whose models must have been loaded
+	 *	@param	aSyncHandler	How to synchronize the GPU-upload of all the buffers
+	 */
+	extern orca_instanced_draws create_orca_instanced_draws(orca_scene_t& aScene, avk::sync aSyncHandler = avk::sync::wait_idle());
+
+	/**	Records one instanced draw call into the given command buffer. The vertex buffers are bound to the
+	 *	vertex input bindings 0 (positions), 1 (texture coordinates), and 2 (normals).
+	 *	A graphics pipeline (and its descriptors, containing mInstanceTransformsBuffer) must have been bound before.
+	 */
+	extern void draw_orca_instanced(avk::command_buffer_t& aCommandBuffer, const orca_instanced_draw& aDraw);
+}
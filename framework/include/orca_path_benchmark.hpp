@@ -0,0 +1,153 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Returns the path with the given name of the given ORCA scene, or throws if there is no such path. */
+	extern const path_data& find_path(const orca_scene_t& aScene, std::string_view aPathName);
+
+	/** Returns the duration of the given path, i.e. the time between its first and its last frame */
+	extern float path_duration(const path_data& aPath);
+
+	/**	Samples a camera path at the given time by interpolating linearly between the two frames around it.
+	 *	Looping paths wrap around, all other paths are clamped to their first and last frames.
+	 */
+	extern frame_data sample_path(const path_data& aPath, float aTime);
+
+	/** Moves the camera to the frame's position and orients it towards the frame's target */
+	extern void apply_path_frame(camera& aCamera, const frame_data& aFrame);
+
+	/** The measurements of one frame of an orca_path_benchmark */
+	struct path_benchmark_frame
+	{
+		/** The point in time of the path at which this frame has been rendered */
+		float mPathTime;
+		/** Wall-clock time from the start of this frame to the start of the next one, in milliseconds */
+		double mCpuFrameTimeMs;
+		/** Time between the two timestamps written by record_gpu_begin and record_gpu_end, in milliseconds. Not set if they have not been recorded. */
+		std::optional<double> mGpuTimeMs;
+		/** Number of draw calls which have been reported via add_draw_calls */
+		uint32_t mDrawCalls;
+	};
+
+	/** Summary of one measured quantity over all frames of a benchmark */
+	struct path_benchmark_statistics
+	{
+		double mMin;
+		double mMean;
+		double mMax;
+		double mP50;
+		double mP90;
+		double mP95;
+		double mP99;
+	};
+
+	/** Computes the statistics of the given values, where percentiles are interpolated linearly between the closest ranks. */
+	extern path_benchmark_statistics compute_benchmark_statistics(std::vector<double> aValues);
+
+	/**	Plays a camera path of an ORCA scene deterministically and measures the performance of every frame.
+	 *
+	 *	The camera is placed at the path's time `i * aTimeStep` (relative to the path's first frame) in the
+	 *	i-th measured frame, regardless of how long rendering actually takes. Therefore, every run renders
+	 *	exactly the same sequence of views, which makes the results comparable between runs, e.g. for
+	 *	regression testing. The path is played once, even if it loops. Before the measurement starts, the first frame of the path is
+	 *	rendered aNumWarmupFrames times to fill caches and to let the clocks of the GPU settle.
+	 *
+	 *	The renderer reports its work to the benchmark:
+	 *	  - GPU time: Call record_gpu_begin and record_gpu_end at the beginning and end of the command
+	 *	    buffer(s) of each frame. The timestamps are written into one query pool with a pair of queries
+	 *	    per frame in flight, whose results are read before the pair is reused, i.e. when the frame in
+	 *	    flight has completed already. Both calls must be recorded into command buffers which are
+	 *	    submitted in the same frame, to the queue passed to the constructor. If that queue's family
+	 *	    does not support timestamps, no GPU times are measured.
+	 *	  - Draw counts: Call add_draw_calls while recording.
+	 *
+	 *	Once the path has been played, the report is written to aReportPath + ".csv" (one line per frame)
+	 *	and aReportPath + ".json" (statistics), and the composition is stopped if aStopWhenFinished is set.
+	 */
+	class orca_path_benchmark : public invokee
+	{
+	public:
+		/**	@param	aCamera				The camera which is moved along the path. It must outlive this invokee.
+		 *	@param	aPath				The path to play, c.f. find_path
+		 *	@param	aReportPath			Path and file name of the report files without extension
+		 *	@param	aTimeStep			Fixed time step in seconds at which the path is sampled
+		 *	@param	aNumWarmupFrames	Number of frames which are rendered before measuring
+		 *	@param	aStopWhenFinished	Stop the current composition after the report has been written
+		 *	@param	aQueue				The queue which the command buffers containing the timestamps are submitted to.
+		 *								If not set, the first queue which has been created in the context is assumed.
+		 */
+		orca_path_benchmark(camera& aCamera, path_data aPath, std::string aReportPath, float aTimeStep = 1.0f / 60.0f, uint32_t aNumWarmupFrames = 60, bool aStopWhenFinished = true, const avk::queue* aQueue = nullptr);
+		orca_path_benchmark(orca_path_benchmark&&) noexcept = default;
+		orca_path_benchmark(const orca_path_benchmark&) = delete;
+		orca_path_benchmark& operator=(orca_path_benchmark&&) noexcept = default;
+		orca_path_benchmark& operator=(const orca_path_benchmark&) = delete;
+		~orca_path_benchmark() = default;
+
+		/** The camera has to be placed before any other invokee uses it */
+		int execution_order() const override { return std::numeric_limits<int>::min(); }
+
+		/** Creates the timestamp query pool, if the queue supports timestamps */
+		void initialize() override;
+
+		/** Places the camera for the current frame and finishes the measurement of the previous frame */
+		void update() override;
+
+		/**	Resets this frame's pair of timestamp queries and writes the first timestamp.
+		 *	The results of the frame which has used the pair before are read first.
+		 *	Must be recorded outside of a render pass.
+		 */
+		void record_gpu_begin(avk::command_buffer_t& aCommandBuffer);
+
+		/** Writes the second timestamp of this frame. */
+		void record_gpu_end(avk::command_buffer_t& aCommandBuffer);
+
+		/** Adds to the number of draw calls of the current frame */
+		void add_draw_calls(uint32_t aNumDrawCalls) { mCurrentDrawCalls += aNumDrawCalls; }
+
+		/** True once all frames have been measured and the report has been written */
+		bool finished() const { return mFinished; }
+
+		/** The measured frames so far */
+		const std::vector<path_benchmark_frame>& frames() const { return mFrames; }
+
+		/** Writes the measured frames to aReportPath + ".csv" and their statistics to aReportPath + ".json" */
+		void write_report(const std::string& aReportPath) const;
+
+	private:
+		/** Index into mFrames of the current frame, or nothing during the warmup */
+		std::optional<size_t> current_measured_frame() const;
+
+		/** Waits for the GPU, reads all outstanding timestamps, writes the report, and disables this invokee */
+		void finish();
+
+		/** Reads the timestamps of the given query pair, which must have been written by a completed frame. */
+		void read_gpu_time(uint32_t aQueryPair);
+
+		camera* mCamera;
+		path_data mPath;
+		std::string mReportPath;
+		float mTimeStep;
+		uint32_t mNumWarmupFrames;
+		uint32_t mNumMeasuredFrames;
+		bool mStopWhenFinished;
+		const avk::queue* mQueue;
+
+		/** Number of update() calls so far, including the warmup frames */
+		uint32_t mFrameCounter = 0;
+		std::optional<std::chrono::steady_clock::time_point> mFrameStart;
+		uint32_t mCurrentDrawCalls = 0;
+		std::vector<path_benchmark_frame> mFrames;
+		bool mFinished = false;
+
+		vk::UniqueQueryPool mTimestampQueries;
+		/** Nanoseconds per timestamp tick */
+		double mTimestampPeriod = 1.0;
+		/** Mask of the bits of a timestamp which are valid on the queue, c.f. timestampValidBits */
+		uint64_t mTimestampMask = ~uint64_t{ 0 };
+		/** For every query pair, the index into mFrames of the measured frame which has written both of its timestamps last */
+		std::vector<std::optional<size_t>> mFrameOfQueryPair;
+		/** The query pair which record_gpu_begin has written in the current frame */
+		std::optional<uint32_t> mCurrentQueryPair;
+	};
+}
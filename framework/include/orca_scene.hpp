@@ -134,7 +134,16 @@ namespace gvk
 		 */
 		std::unordered_map<material_config, std::vector<model_and_mesh_indices>> distinct_material_configs_for_all_models(bool aAlsoConsiderCpuOnlyDataForDistinctMaterials = false);
 
-		static avk::owning_resource<orca_scene_t> load_from_file(const std::string& aPath, model_t::aiProcessFlagsType aAssimpFlags = aiProcess_Triangulate | aiProcess_PreTransformVertices);
+		/**	Loads an ORCA scene from its JSON file and all the models it references.
+		 *	The models are imported concurrently on default_thread_pool(), each one with its own
+		 *	Assimp::Importer. The order of models() is the order of the models in the file.
+		 *	@param	aPath						Path to the scene's JSON file
+		 *	@param	aAssimpFlags				Flags which are passed to Assimp for every model
+		 *	@param	aShareIdenticalModelFiles	If true, every distinct model file is loaded only once, and all
+		 *										model_data entries referring to it share the same model_t
+		 *										(with shared ownership enabled on its mLoadedModel).
+		 */
+		static avk::owning_resource<orca_scene_t> load_from_file(const std::string& aPath, model_t::aiProcessFlagsType aAssimpFlags = aiProcess_Triangulate | aiProcess_PreTransformVertices, bool aShareIdenticalModelFiles = false);
 
 	private:
 		std::string mLoadPath;
@@ -148,8 +157,4 @@ namespace gvk
 	};
 
 	using orca_scene = avk::owning_resource<orca_scene_t>;
-
-	// JSON helper functions:
-	static glm::vec3 convert_json_to_vec3(nlohmann::json& j);
-	static std::string convert_json_to_string(nlohmann::json& j);
 }
@@ -0,0 +1,83 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** A model of an ORCA scene package, i.e. the range of instances and draw commands which belong to it */
+	struct orca_scene_package_model
+	{
+		std::string mName;
+		std::string mFileName;
+		/** Index of the model's first instance in orca_scene_package::mInstanceTransforms */
+		uint32_t mFirstInstance;
+		uint32_t mInstanceCount;
+		/** Index of the model's first draw command in orca_scene_package::mBatch. There is one draw
+		 *	command per mesh and instance, where all meshes of an instance are stored consecutively. */
+		uint32_t mFirstDrawCommand;
+		uint32_t mDrawCommandCount;
+	};
+
+	/**	The contents of an ORCA scene package, after it has been loaded and uploaded to the GPU.
+	 *
+	 *	All meshes of all models are stored in the mega-buffers of one scene_batch. The geometry
+	 *	of each model is stored only once, but there is a draw command for every mesh of every
+	 *	instance, whose scene_batch_draw_data::mTransformIndex refers to the instance's model
+	 *	matrix in mInstanceTransformsBuffer and whose scene_batch_draw_data::mMaterialIndex
+	 *	refers to an entry of mMaterialsBuffer.
+	 */
+	struct orca_scene_package
+	{
+		scene_batch mBatch;
+		/** The per-draw data of mBatch, e.g. for culling on the CPU */
+		std::vector<scene_batch_draw_data> mDrawData;
+		std::vector<glm::mat4> mInstanceTransforms;
+		/** Storage buffer containing mInstanceTransforms */
+		avk::buffer mInstanceTransformsBuffer;
+		std::vector<material_gpu_data> mMaterials;
+		/** Storage buffer containing mMaterials */
+		avk::buffer mMaterialsBuffer;
+		/** The textures which are referenced by the texture indices of mMaterials */
+		std::vector<avk::image_sampler> mImageSamplers;
+		std::vector<orca_scene_package_model> mModels;
+		std::vector<direct_light_data> mDirLightsData;
+		std::vector<point_light_data> mPointLightsData;
+		std::vector<camera_data> mCamerasData;
+		std::vector<path_data> mPathsData;
+	};
+
+	/**	Bakes an ORCA scene into one binary package file, which can be loaded via load_orca_scene_package
+	 *	without parsing JSON, importing models with Assimp, or decoding any images.
+	 *
+	 *	The package contains the geometry of all models in the layout of scene_batch_data, the model
+	 *	matrices of all instances, the materials as material_gpu_data, all textures in their final
+	 *	Vulkan format including their complete mip chains, the lights, the cameras, and the paths.
+	 *	Every section is aligned to 256 bytes. The package stores the data in the memory layout of
+	 *	the host, i.e., it is not portable between platforms with a different ABI.
+	 *	Mip chains are created and compressed concurrently on default_thread_pool().
+	 *
+	 *	@param	aScene					The scene, whose models must have been loaded
+	 *	@param	aPackagePath			Path of the package file which is (over)written
+	 *	@param	aLoadTexturesInSrgb		C.f. convert_for_gpu_usage
+	 *	@param	aFlipTextures			C.f. convert_for_gpu_usage
+	 *	@param	aCompressTextures		If true, all 8-bit textures are compressed into BC3 (which requires
+	 *									the textureCompressionBC feature when the package is loaded).
+	 *									HDR textures and textures which are block-compressed already are
+	 *									never (re)compressed.
+	 */
+	extern void bake_orca_scene_package(orca_scene_t& aScene, const std::string& aPackagePath, bool aLoadTexturesInSrgb = false, bool aFlipTextures = false, bool aCompressTextures = true);
+
+	/**	Loads an ORCA scene package which has been created via bake_orca_scene_package, and uploads its
+	 *	geometry, instance transforms, materials, and textures to the GPU.
+	 *	@param	aPackagePath			Path to the package file
+	 *	@param	aImageUsage				Image usage for all the textures
+	 *	@param	aTextureFilterMode		Texture filter mode for all the textures
+	 *	@param	aBorderHandlingMode		Border handling mode for all the textures
+	 *	@param	aSyncHandler			How to synchronize the GPU-upload of all the buffers and images
+	 */
+	extern orca_scene_package load_orca_scene_package(
+		const std::string& aPackagePath,
+		avk::image_usage aImageUsage = avk::image_usage::general_texture,
+		avk::filter_mode aTextureFilterMode = avk::filter_mode::trilinear,
+		avk::border_handling_mode aBorderHandlingMode = avk::border_handling_mode::repeat,
+		avk::sync aSyncHandler = avk::sync::wait_idle());
+}
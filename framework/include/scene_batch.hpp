@@ -0,0 +1,133 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Per-draw data in the right format to be uploaded to the GPU
+	 *	and to be used in a GPU buffer like an SSBO.
+	 *	There is exactly one such entry per vk::DrawIndexedIndirectCommand
+	 *	of a scene_batch, stored at the same index.
+	 */
+	struct scene_batch_draw_data
+	{
+		/** Minimum corner of the mesh's axis-aligned bounding box in mesh space, w is unused. */
+		alignas(16) glm::vec4 mBoundsMin;
+
+		/** Maximum corner of the mesh's axis-aligned bounding box in mesh space, w is unused. */
+		alignas(16) glm::vec4 mBoundsMax;
+
+		/** Index into the materials buffer, i.e. into the vector of material_gpu_data. */
+		alignas(4) uint32_t mMaterialIndex;
+
+		/** Index into a user-provided buffer of transformation matrices. */
+		alignas(4) uint32_t mTransformIndex;
+
+		alignas(4) uint32_t mPadding0;
+		alignas(4) uint32_t mPadding1;
+	};
+
+	/** CPU-side data of a scene batch: all the vertex data of all the selected meshes
+	 *	packed into one set of vertex attribute collections and one index collection
+	 *	(the mega-buffers' contents), plus one indirect draw command and one per-draw
+	 *	data entry per mesh.
+	 *
+	 *	The indices are NOT rebased. They remain relative to their mesh, and each draw
+	 *	command's vertexOffset points to the mesh's first vertex in the mega-buffers.
+	 *	Each draw command's firstInstance is set to the draw command's index, s.t. a
+	 *	vertex shader can fetch its scene_batch_draw_data via gl_InstanceIndex.
+	 */
+	struct scene_batch_data
+	{
+		std::vector<glm::vec3> mPositions;
+		std::vector<glm::vec2> mTexCoords;
+		std::vector<glm::vec3> mNormals;
+		std::vector<uint32_t> mIndices;
+		std::vector<vk::DrawIndexedIndirectCommand> mDrawCommands;
+		std::vector<scene_batch_draw_data> mDrawData;
+	};
+
+	/** GPU-side data of a scene batch, created from a scene_batch_data.
+	 *	The vertex buffers are to be bound in the following order:
+	 *	 binding 0 ... positions (glm::vec3)
+	 *	 binding 1 ... texture coordinates (glm::vec2)
+	 *	 binding 2 ... normals (glm::vec3)
+	 *	The buffer mDrawDataBuffer is a storage buffer containing one
+	 *	scene_batch_draw_data entry per draw command.
+	 *	mDrawCommands is a CPU-side copy of the draw commands, which are recorded as direct draws
+	 *	if the logical device can not use them as indirect draws, c.f. draw_scene_batch.
+	 */
+	struct scene_batch
+	{
+		avk::buffer mPositionsBuffer;
+		avk::buffer mTexCoordsBuffer;
+		avk::buffer mNormalsBuffer;
+		avk::buffer mIndexBuffer;
+		avk::buffer mDrawCommandsBuffer;
+		avk::buffer mDrawDataBuffer;
+		std::vector<vk::DrawIndexedIndirectCommand> mDrawCommands;
+		uint32_t mNumDrawCommands;
+	};
+
+	/**	Gathers the data of all the selected meshes into one scene_batch_data struct.
+	 *
+	 *	@param	aModelsAndSelectedMeshes	Selection of models and meshes, typically created via make_models_and_meshes_selection.
+	 *	@param	aMaterialIndexGetter		Function which is invoked for every selected mesh and must return the material index
+	 *										which shall be stored in the mesh's scene_batch_draw_data::mMaterialIndex.
+	 *										Function-signature: uint32_t(const model_t&, mesh_index_t)
+	 *	@param	aTransformIndexGetter		Function which is invoked for every selected mesh and must return the transform index
+	 *										which shall be stored in the mesh's scene_batch_draw_data::mTransformIndex.
+	 *										Function-signature: uint32_t(size_t, const model_t&, mesh_index_t), where the first
+	 *										parameter is the index into aModelsAndSelectedMeshes.
+	 *										If not set, the index into aModelsAndSelectedMeshes is stored as the transform index.
+	 *	@param	aFlipTexCoords				If true, the texture coordinates' v-component is flipped, i.e. set to 1-v.
+	 *	@return	The gathered data, which can be uploaded to the GPU via create_scene_batch.
+	 */
+	extern scene_batch_data get_scene_batch_data(
+		const std::vector<std::tuple<std::reference_wrapper<const gvk::model_t>, std::vector<size_t>>>& aModelsAndSelectedMeshes,
+		std::function<uint32_t(const model_t&, mesh_index_t)> aMaterialIndexGetter,
+		std::function<uint32_t(size_t, const model_t&, mesh_index_t)> aTransformIndexGetter = {},
+		bool aFlipTexCoords = true);
+
+	/**	Uploads the data of the given scene_batch_data into GPU buffers.
+	 *	@param	aBatchData		The data to be uploaded, typically created via get_scene_batch_data.
+	 *	@param	aUsageFlags		Additional usage flags for the vertex and index buffers.
+	 *	@param	aSyncHandler	How to synchronize the GPU-upload of all the buffers.
+	 *	@return	The buffers, ready to be used with draw_scene_batch.
+	 */
+	extern scene_batch create_scene_batch(const scene_batch_data& aBatchData, vk::BufferUsageFlags aUsageFlags = {}, avk::sync aSyncHandler = avk::sync::wait_idle());
+
+	/**	Gathers the data of all the selected meshes and uploads it into GPU buffers.
+	 *	This is a shortcut for calling create_scene_batch(get_scene_batch_data(...), ...).
+	 */
+	extern scene_batch create_scene_batch(
+		const std::vector<std::tuple<std::reference_wrapper<const gvk::model_t>, std::vector<size_t>>>& aModelsAndSelectedMeshes,
+		std::function<uint32_t(const model_t&, mesh_index_t)> aMaterialIndexGetter,
+		std::function<uint32_t(size_t, const model_t&, mesh_index_t)> aTransformIndexGetter = {},
+		bool aFlipTexCoords = true,
+		vk::BufferUsageFlags aUsageFlags = {},
+		avk::sync aSyncHandler = avk::sync::wait_idle());
+
+	/**	Records the commands which draw the whole scene batch into the given command buffer.
+	 *	The mega-buffers are bound to the vertex input bindings 0, 1, and 2 (see scene_batch), then
+	 *	all draw commands are issued with as few vkCmdDrawIndexedIndirect as possible. This depends on the
+	 *	features which have been enabled on the logical device (c.f. context_vulkan::requested_physical_device_features):
+	 *	 - Without multiDrawIndirect, one vkCmdDrawIndexedIndirect per draw command is recorded, and with it,
+	 *	   at most maxDrawIndirectCount draw commands are issued per call.
+	 *	 - Without drawIndirectFirstInstance, the draw commands' non-zero firstInstance values must not be
+	 *	   read from an indirect buffer. Then, one vkCmdDrawIndexed per draw command is recorded instead,
+	 *	   from the CPU-side copy of the draw commands, i.e. changes to mDrawCommandsBuffer are not regarded.
+	 *
+	 *	A graphics pipeline (and its descriptors, containing mDrawDataBuffer) must have been bound before.
+	 */
+	extern void draw_scene_batch(avk::command_buffer_t& aCommandBuffer, const scene_batch& aBatch);
+
+	/**	Records the commands which draw a subset of the scene batch's draw commands, e.g. the
+	 *	visible ones after frustum and occlusion culling. Buffers are bound like in the other overload.
+	 *	Runs of consecutive indices are drawn with one vkCmdDrawIndexedIndirect each if the
+	 *	multiDrawIndirect feature is enabled, all others with one call per draw command.
+	 *	Without the drawIndirectFirstInstance feature, direct draws are recorded like in the other overload.
+	 *
+	 *	@param	aVisibleDrawIndices		Indices of the draw commands to be drawn, preferably in ascending order.
+	 */
+	extern void draw_scene_batch(avk::command_buffer_t& aCommandBuffer, const scene_batch& aBatch, const std::vector<uint32_t>& aVisibleDrawIndices);
+}
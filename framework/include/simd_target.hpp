@@ -0,0 +1,14 @@
+#pragma once
+
+// Shared by the framework's implementation files which contain SIMD code paths, which are selected at runtime via active_simd_instruction_set().
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define GVK_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// MSVC allows the use of any intrinsics in any function; GCC and Clang require the target to be specified per function:
+#if defined(__GNUC__) || defined(__clang__)
+#define GVK_TARGET(x) __attribute__((target(x)))
+#else
+#define GVK_TARGET(x)
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Generates per-vertex tangents for the given mesh, following the MikkTSpace
+	 *	algorithm, s.t. the results are consistent with those of normal map bakers:
+	 *	 - Per triangle, the tangent direction is derived from the texture coordinates'
+	 *	   derivatives and the triangle's orientation in texture space is determined.
+	 *	 - Per corner, the triangle's tangent is projected into the plane of the vertex
+	 *	   normal, and accumulated, weighted by the corner's angle.
+	 *	 - The accumulated tangents are normalized. The handedness (+1 or -1) is stored
+	 *	   in w, s.t. bitangent = w * cross(normal, tangent).
+	 *
+	 *	Other than the reference implementation, vertices are never split. If a vertex
+	 *	is shared by triangles with different texture space orientations (i.e. at a UV
+	 *	mirror seam without separate vertices), the orientation with the larger angle
+	 *	sum wins. Meshes which have been imported with aiProcess_JoinIdenticalVertices,
+	 *	or welded with @ref weld_identical_vertices, produce the same tangents as MikkTSpace
+	 *	for all other vertices.
+	 *
+	 *	@param	aMesh			The mesh to generate tangents for. It must have normals
+	 *							and texture coordinates of the given set.
+	 *	@param	aTexCoordSet	The set of texture coordinates to derive the tangents from.
+	 *	@return	Tangents with handedness in w of length aMesh->mNumVertices, or an empty
+	 *			vector if the mesh has no normals or no texture coordinates.
+	 */
+	extern std::vector<glm::vec4> generate_tangents_with_handedness(const aiMesh* aMesh, int aTexCoordSet = 0);
+}
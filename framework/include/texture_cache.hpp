@@ -0,0 +1,138 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Identifies a texture which has been loaded from file, c.f. texture_cache */
+	struct texture_cache_key
+	{
+		/** Path of the image file, cleaned up via avk::clean_up_path */
+		std::string mPath;
+		/** Format of the image, or vk::Format::eUndefined if it is determined from the file like convert_for_gpu_usage does */
+		vk::Format mFormat;
+		/** True if the texture has been loaded in an sRGB format, if applicable. Only relevant if mFormat is vk::Format::eUndefined. */
+		bool mSrgb;
+		/** True if the image has been flipped vertically */
+		bool mFlip;
+		avk::image_usage mImageUsage;
+	};
+
+	static bool operator ==(const texture_cache_key& left, const texture_cache_key& right)
+	{
+		return left.mPath == right.mPath
+			&& left.mFormat == right.mFormat
+			&& left.mSrgb == right.mSrgb
+			&& left.mFlip == right.mFlip
+			&& left.mImageUsage == right.mImageUsage;
+	}
+
+	static bool operator !=(const texture_cache_key& left, const texture_cache_key& right)
+	{
+		return !(left == right);
+	}
+}
+
+namespace std // Inject hash for `gvk::texture_cache_key` into std::
+{
+	template<> struct hash<gvk::texture_cache_key>
+	{
+		std::size_t operator()(gvk::texture_cache_key const& o) const noexcept
+		{
+			std::size_t h = 0;
+			avk::hash_combine(h,
+				o.mPath,
+				o.mFormat,
+				o.mSrgb,
+				o.mFlip,
+				o.mImageUsage
+			);
+			return h;
+		}
+	};
+}
+
+namespace gvk
+{
+	/**	@brief Shares textures which are loaded from the same file between all of their users
+	 *
+	 *	Models and ORCA scenes often use the same texture files, e.g. when they share a material library.
+	 *	Instead of loading and uploading such a file once per user, the image view which has been created
+	 *	for it is stored in shared ownership, and every user gets a copy of it.
+	 *
+	 *	Every entry counts the references which have been handed out via try_acquire, insert, and acquire.
+	 *	Users give them back via release. Once an entry has no references left, the cache drops its copy of
+	 *	the image view, i.e. the image is destroyed as soon as the last of its users' copies is gone.
+	 *
+	 *	All methods can be called from multiple threads concurrently.
+	 *	Use @ref default_texture_cache() to get the context-wide instance.
+	 */
+	class texture_cache
+	{
+	public:
+		texture_cache() = default;
+		texture_cache(texture_cache&&) = delete;
+		texture_cache(const texture_cache&) = delete;
+		texture_cache& operator=(texture_cache&&) = delete;
+		texture_cache& operator=(const texture_cache&) = delete;
+		~texture_cache() = default;
+
+		/** Returns a copy of the cached image view and adds a reference to it, or nothing if there is none for the given key */
+		std::optional<avk::image_view> try_acquire(const texture_cache_key& aKey);
+
+		/**	Adds an image view to the cache with one reference, and returns a copy of it.
+		 *	If an image view has been added for the same key in the meantime, that one gets the reference and is returned instead.
+		 */
+		avk::image_view insert(const texture_cache_key& aKey, avk::image_view aImageView);
+
+		/**	Returns the cached image view like try_acquire, or creates it via aCreateImageView and adds it like insert.
+		 *	aCreateImageView is invoked without locking the cache, i.e. other textures can be acquired concurrently.
+		 */
+		avk::image_view acquire(const texture_cache_key& aKey, const std::function<avk::image_view()>& aCreateImageView);
+
+		/**	Gives back one reference to the given image view. Image views which are not in the cache are ignored,
+		 *	i.e. it is fine to release all the image views of the result of convert_for_gpu_usage.
+		 */
+		void release(const avk::image_view& aImageView);
+
+		/** Returns the number of references to the image view for the given key, which is 0 if there is none */
+		size_t reference_count(const texture_cache_key& aKey) const;
+
+		/** Returns the number of cached image views */
+		size_t size() const;
+
+		/** Drops all of the cache's copies of image views, regardless of their references */
+		void clear();
+
+	private:
+		struct entry
+		{
+			avk::image_view mImageView;
+			size_t mReferenceCount;
+		};
+
+		mutable std::mutex mMutex;
+		std::unordered_map<texture_cache_key, entry> mEntries;
+		std::unordered_map<VkImageView, texture_cache_key> mKeysOfImageViews;
+	};
+
+	/**	@brief Get the context-wide texture cache
+	 *	It is created upon the first call, and cleared when the context is destroyed.
+	 */
+	inline texture_cache& default_texture_cache()
+	{
+		static texture_cache sTextureCache;
+		return sTextureCache;
+	}
+
+	/**	Loads an image file like create_image_from_file, and creates an image view for it, unless the
+	 *	given cache contains one for the same file, format, flip, and usage already.
+	 *	Give the returned image view back to the cache via texture_cache::release.
+	 */
+	extern avk::image_view create_image_view_from_file_cached(const std::string& aPath, vk::Format aFormat, bool aFlip = true, avk::image_usage aImageUsage = avk::image_usage::general_texture, avk::sync aSyncHandler = avk::sync::wait_idle(), texture_cache& aTextureCache = default_texture_cache());
+
+	/**	Loads an image file like convert_for_gpu_usage does, i.e. its format is determined from the file, and creates
+	 *	an image view for it, unless the given cache contains one for the same file, sRGB state, flip, and usage already.
+	 *	Give the returned image view back to the cache via texture_cache::release.
+	 */
+	extern avk::image_view create_image_view_from_file_cached(const std::string& aPath, bool aLoadSrgbIfApplicable, bool aFlip = true, avk::image_usage aImageUsage = avk::image_usage::general_texture, avk::sync aSyncHandler = avk::sync::wait_idle(), texture_cache& aTextureCache = default_texture_cache());
+}
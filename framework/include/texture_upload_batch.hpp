@@ -0,0 +1,92 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Uploads many images at once: The data of all images is sub-allocated from one host-coherent staging
+	 *	arena, and all the layout transitions, copies, and MIP-map generations are recorded into one command
+	 *	buffer, which is submitted once for the whole batch. This avoids creating a staging buffer and
+	 *	synchronizing separately for every single image, e.g. when uploading all textures of a material set.
+	 *
+	 *	Usage: Add all images via add_image, add_decoded_image, or add_1px_texture, which copy their data into
+	 *	the staging arena right away. Then, call submit, which creates and returns the images in the order in
+	 *	which they have been added, i.e. the index returned by an add_* method is the index of its image.
+	 *
+	 *	The arena consists of blocks, where a new block is only created if an image does not fit into the
+	 *	current one anymore (all levels of an image are stored in the same block). The first block is small,
+	 *	and every further block is twice as large as the previous one, up to aMaxArenaBlockSize bytes, s.t. a
+	 *	small batch does not reserve much more staging memory than it needs. A block is never smaller than
+	 *	the image which it is created for.
+	 */
+	class texture_upload_batch
+	{
+	public:
+		/** @param	aMaxArenaBlockSize	Maximum size of the blocks of the staging arena in bytes, unless a single image is larger */
+		explicit texture_upload_batch(size_t aMaxArenaBlockSize = 128 * 1024 * 1024);
+		texture_upload_batch(texture_upload_batch&&) noexcept = default;
+		texture_upload_batch(const texture_upload_batch&) = delete;
+		texture_upload_batch& operator=(texture_upload_batch&&) noexcept = default;
+		texture_upload_batch& operator=(const texture_upload_batch&) = delete;
+		~texture_upload_batch();
+
+		/**	Adds a 2D image and copies its data into the staging arena.
+		 *	@param	aWidth			Width of the first level
+		 *	@param	aHeight			Height of the first level
+		 *	@param	aFormat			Format of the image and of its data
+		 *	@param	aImageUsage		Usage of the image, which also determines if it has MIP-maps
+		 *	@param	aLevels			Pointer and size in bytes of the data of each of the first MIP levels. If the image has more
+		 *							levels than given, and only one level is given, the others are created on the GPU via blit.
+		 *	@return	The index of the image in the result of submit
+		 */
+		size_t add_image(uint32_t aWidth, uint32_t aHeight, vk::Format aFormat, avk::image_usage aImageUsage, const std::vector<std::tuple<const void*, size_t>>& aLevels);
+
+		/** Adds an image which has been decoded via decode_image_file, c.f. add_image */
+		size_t add_decoded_image(const decoded_image& aImage, avk::image_usage aImageUsage = avk::image_usage::general_texture);
+
+		/** Adds a 1x1 image of the given color, c.f. create_1px_texture */
+		size_t add_1px_texture(std::array<uint8_t, 4> aColor, vk::Format aFormat = vk::Format::eR8G8B8A8Unorm, avk::image_usage aImageUsage = avk::image_usage::general_texture);
+
+		/** Returns the number of images which have been added since the last submit */
+		size_t size() const { return mUploads.size(); }
+
+		/** Returns the number of bytes which are used in the staging arena */
+		size_t staging_size() const;
+
+		/**	Records the uploads of all added images into one command buffer, and submits it once.
+		 *	The staging arena is released when the command buffer's lifetime ends. If no images have been
+		 *	added, an empty command buffer is submitted, s.t. the sync handler is consumed nevertheless.
+		 *	@param	aSyncHandler	How to synchronize the upload of the whole batch. With the default, the
+		 *							calling thread waits (once) until all images have been uploaded.
+		 *	@return	All the images which have been added, in the order in which they have been added.
+		 */
+		std::vector<avk::image> submit(avk::sync aSyncHandler = avk::sync::wait_idle());
+
+	private:
+		/** A block of the staging arena, which is mapped until submit */
+		struct arena_block
+		{
+			avk::buffer mBuffer;
+			uint8_t* mMapped;
+			size_t mSize;
+			size_t mUsed;
+		};
+
+		/** An image, whose data has been copied into the arena already */
+		struct pending_upload
+		{
+			avk::image mImage;
+			size_t mBlockIndex;
+			std::vector<vk::BufferImageCopy> mRegions;
+			bool mGenerateMipMaps;
+		};
+
+		/** Returns the block index and the offset of aSize bytes in the arena */
+		std::tuple<size_t, size_t> allocate(size_t aSize);
+
+		void unmap_arena();
+
+		size_t mMaxArenaBlockSize;
+		std::vector<arena_block> mArena;
+		std::vector<pending_upload> mUploads;
+	};
+}
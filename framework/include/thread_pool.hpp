@@ -0,0 +1,148 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	@brief A fixed set of worker threads which execute tasks
+	 *
+	 *	Used for CPU-heavy work that can be split into independent parts,
+	 *	like processing the meshes of a model or the images of a material
+	 *	in parallel. The worker threads are created upon construction and
+	 *	live until the thread_pool is destroyed.
+	 *
+	 *	Use @ref default_thread_pool() to get the framework-wide instance.
+	 */
+	class thread_pool
+	{
+	public:
+		/**	Creates the worker threads.
+		 *	@param	aNumWorkers		Number of worker threads. If 0, one less than
+		 *							std::thread::hardware_concurrency() is used,
+		 *							but at least one.
+		 */
+		explicit thread_pool(uint32_t aNumWorkers = 0);
+		thread_pool(thread_pool&&) = delete;
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(thread_pool&&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+		~thread_pool();
+
+		/** Returns the number of worker threads, not including the calling thread. */
+		uint32_t number_of_workers() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+		/**	Enqueues a task which is executed by one of the worker threads.
+		 *	@param	aTask	Function-signature: R()
+		 *	@return	A future which receives the task's result or the exception it has thrown.
+		 */
+		template <typename F>
+		auto submit(F aTask) -> std::future<std::invoke_result_t<F>>
+		{
+			using result_t = std::invoke_result_t<F>;
+			auto task = std::make_shared<std::packaged_task<result_t()>>(std::move(aTask));
+			auto future = task->get_future();
+			enqueue([task]() { (*task)(); });
+			return future;
+		}
+
+		/**	Invokes aFunc for every index in the range [aBegin, aEnd) and returns
+		 *	after all invocations have completed. The calling thread takes part in
+		 *	the work, and it also executes other pending tasks while waiting for the
+		 *	workers. Therefore, it is safe to call parallel_for from within a task
+		 *	which is executed by this thread_pool.
+		 *	If any invocation throws, the first exception is rethrown after all
+		 *	workers have stopped working on the range.
+		 *
+		 *	@param	aBegin		First index
+		 *	@param	aEnd		One past the last index
+		 *	@param	aFunc		Function-signature: void(size_t)
+		 *	@param	aGrainSize	Number of consecutive indices which are processed as one
+		 *						chunk by the same thread.
+		 */
+		template <typename F>
+		void parallel_for(size_t aBegin, size_t aEnd, F aFunc, size_t aGrainSize = 1)
+		{
+			if (aEnd <= aBegin) {
+				return;
+			}
+			aGrainSize = std::max(aGrainSize, size_t{ 1 });
+			const size_t numChunks = (aEnd - aBegin + aGrainSize - 1) / aGrainSize;
+			if (1 == numChunks || mWorkers.empty()) {
+				for (size_t i = aBegin; i < aEnd; ++i) {
+					aFunc(i);
+				}
+				return;
+			}
+
+			struct shared_state
+			{
+				std::atomic<size_t> mNextChunk = 0;
+				std::atomic<size_t> mHelpersRunning = 0;
+				std::mutex mExceptionMutex;
+				std::exception_ptr mException;
+			};
+			auto state = std::make_shared<shared_state>();
+
+			auto processChunks = [state, &aFunc, aBegin, aEnd, aGrainSize, numChunks]() {
+				for (size_t chunk = state->mNextChunk++; chunk < numChunks; chunk = state->mNextChunk++) {
+					const size_t from = aBegin + chunk * aGrainSize;
+					const size_t to = std::min(from + aGrainSize, aEnd);
+					try {
+						for (size_t i = from; i < to; ++i) {
+							aFunc(i);
+						}
+					}
+					catch (...) {
+						std::scoped_lock<std::mutex> guard(state->mExceptionMutex);
+						if (!state->mException) {
+							state->mException = std::current_exception();
+						}
+						// Make all other threads stop grabbing further chunks:
+						state->mNextChunk = numChunks;
+					}
+				}
+			};
+
+			const auto numHelpers = std::min(static_cast<size_t>(mWorkers.size()), numChunks - 1);
+			state->mHelpersRunning = numHelpers;
+			for (size_t h = 0; h < numHelpers; ++h) {
+				enqueue([state, processChunks]() {
+					processChunks();
+					--state->mHelpersRunning;
+				});
+			}
+
+			processChunks();
+
+			// aFunc is referenced by the helpers => they must have finished before we may return
+			while (state->mHelpersRunning.load() > 0) {
+				if (!try_execute_one_pending_task()) {
+					std::this_thread::yield();
+				}
+			}
+
+			if (state->mException) {
+				std::rethrow_exception(state->mException);
+			}
+		}
+
+	private:
+		void enqueue(std::function<void()> aTask);
+		bool try_execute_one_pending_task();
+		void worker_loop();
+
+		std::vector<std::thread> mWorkers;
+		std::deque<std::function<void()>> mTasks;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		bool mStopRequested = false;
+	};
+
+	/**	@brief Get the framework-wide thread pool
+	 *	It is created upon the first call with the default number of worker threads.
+	 */
+	inline thread_pool& default_thread_pool()
+	{
+		static thread_pool sThreadPool;
+		return sThreadPool;
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Instruction sets which the batch transform functions can use */
+	enum struct simd_instruction_set
+	{
+		/** Plain scalar code, c.f. matrix_from_transforms and transforms_from_matrix */
+		scalar,
+		/** 4 transforms at a time, requires SSE4.1 */
+		sse4_1,
+		/** 8 transforms at a time, requires AVX2 and FMA */
+		avx2
+	};
+
+	/** Returns the best instruction set which is supported by the CPU (and the OS), determined once at runtime. */
+	extern simd_instruction_set supported_simd_instruction_set();
+
+	/** Returns the instruction set which is currently used by matrices_from_transforms and transforms_from_matrices. */
+	extern simd_instruction_set active_simd_instruction_set();
+
+	/**	Overrides the instruction set which is used by matrices_from_transforms and transforms_from_matrices,
+	 *	e.g. for comparing the different implementations. Instruction sets which are not supported by the
+	 *	CPU fall back to the best supported one.
+	 *	By default, supported_simd_instruction_set() is used.
+	 */
+	extern void set_simd_instruction_set(simd_instruction_set aInstructionSet);
+
+	/**	Batch version of matrix_from_transforms: Computes aCount transformation matrices at once.
+	 *	The results are the same as those of matrix_from_transforms up to floating point rounding.
+	 *	@param	aTranslations	Pointer to aCount translations
+	 *	@param	aRotations		Pointer to aCount rotations
+	 *	@param	aScales			Pointer to aCount scales
+	 *	@param	aCount			Number of transforms
+	 *	@param	aMatricesOut	Pointer to aCount matrices, which the results are written to
+	 */
+	extern void matrices_from_transforms(const glm::vec3* aTranslations, const glm::quat* aRotations, const glm::vec3* aScales, size_t aCount, glm::mat4* aMatricesOut);
+
+	/**	Batch version of transforms_from_matrix: Decomposes aCount transformation matrices at once.
+	 *	The results are the same as those of transforms_from_matrix up to floating point rounding.
+	 *	@param	aMatrices			Pointer to aCount matrices
+	 *	@param	aCount				Number of matrices
+	 *	@param	aTranslationsOut	Pointer to aCount translations, which the results are written to
+	 *	@param	aRotationsOut		Pointer to aCount rotations, which the results are written to
+	 *	@param	aScalesOut			Pointer to aCount scales, which the results are written to
+	 */
+	extern void transforms_from_matrices(const glm::mat4* aMatrices, size_t aCount, glm::vec3* aTranslationsOut, glm::quat* aRotationsOut, glm::vec3* aScalesOut);
+}
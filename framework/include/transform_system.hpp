@@ -0,0 +1,144 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Data-oriented alternative to class transform for large numbers of transforms.
+	 *
+	 *	All transforms' translations, rotations, scales, parent indices, and dirty flags are
+	 *	stored in contiguous arrays (structure of arrays), which are sorted by the depth of the
+	 *	transforms in the hierarchy, i.e. parents are always stored before their children.
+	 *	Setters only flag a transform as dirty; the local and world matrices are recomputed in
+	 *	update(), which is one linear pass over all transforms. Only the dirty transforms and
+	 *	their descendants are recomputed. The parallel variant of update() processes one depth
+	 *	level after the other and splits each level into chunks which run on a thread pool.
+	 *
+	 *	Transforms are referred to by ids, which remain valid until the transform is destroyed.
+	 *	Ids of destroyed transforms are reused. Internally, ids are mapped to indices into the
+	 *	sorted arrays, which change whenever the hierarchy changes (c.f. index_of).
+	 */
+	class transform_system
+	{
+	public:
+		using transform_id = uint32_t;
+
+		transform_system() = default;
+		transform_system(transform_system&&) noexcept = default;
+		transform_system(const transform_system&) = delete;
+		transform_system& operator=(transform_system&&) noexcept = default;
+		transform_system& operator=(const transform_system&) = delete;
+		~transform_system() = default;
+
+		/**	Creates a new transform, which is dirty until the next update().
+		 *	@param	aTranslation	Local translation
+		 *	@param	aRotation		Local rotation
+		 *	@param	aScale			Local scale
+		 *	@param	aParent			Optional parent transform
+		 *	@return	The id of the new transform
+		 */
+		transform_id create(glm::vec3 aTranslation = { 0.f, 0.f, 0.f }, glm::quat aRotation = { 1.f, 0.f, 0.f, 0.f }, glm::vec3 aScale = { 1.f, 1.f, 1.f }, std::optional<transform_id> aParent = {});
+
+		/**	Destroys the given transform. Its children are attached to its parent (or become
+		 *	root transforms if it has none), keeping their local transforms.
+		 */
+		void destroy(transform_id aId);
+
+		/** Returns true if the given id refers to an existing transform */
+		bool exists(transform_id aId) const { return aId < mIndexOfId.size() && sInvalidIndex != mIndexOfId[aId]; }
+
+		/** Returns the number of transforms */
+		size_t size() const { return mNumAlive; }
+
+		/**	Attaches the given transform to a new parent, or detaches it from its parent if aParent is empty.
+		 *	Throws if the new parent is the transform itself or one of its descendants.
+		 */
+		void set_parent(transform_id aId, std::optional<transform_id> aParent);
+
+		/** Returns the parent of the given transform, if it has one */
+		std::optional<transform_id> parent(transform_id aId) const;
+
+		/** Sets the local translation of the given transform and flags it as dirty */
+		void set_translation(transform_id aId, const glm::vec3& aValue) { auto i = index_of(aId); mTranslations[i] = aValue; mDirty[i] = 1; }
+
+		/** Sets the local rotation of the given transform and flags it as dirty */
+		void set_rotation(transform_id aId, const glm::quat& aValue) { auto i = index_of(aId); mRotations[i] = aValue; mDirty[i] = 1; }
+
+		/** Sets the local scale of the given transform and flags it as dirty */
+		void set_scale(transform_id aId, const glm::vec3& aValue) { auto i = index_of(aId); mScales[i] = aValue; mDirty[i] = 1; }
+
+		/** Gets the local translation of the given transform */
+		const glm::vec3& translation(transform_id aId) const { return mTranslations[index_of(aId)]; }
+
+		/** Gets the local rotation of the given transform */
+		const glm::quat& rotation(transform_id aId) const { return mRotations[index_of(aId)]; }
+
+		/** Gets the local scale of the given transform */
+		const glm::vec3& scale(transform_id aId) const { return mScales[index_of(aId)]; }
+
+		/** Returns the local transformation matrix, as of the latest update() */
+		const glm::mat4& local_transformation_matrix(transform_id aId) const { return mLocalMatrices[index_of(aId)]; }
+
+		/** Returns the global transformation matrix, as of the latest update() */
+		const glm::mat4& global_transformation_matrix(transform_id aId) const { return mWorldMatrices[index_of(aId)]; }
+
+		/** Returns true if the global transformation matrix of the given transform has been recomputed in the latest update() */
+		bool changed_in_latest_update(transform_id aId) const { return 0 != mChanged[index_of(aId)]; }
+
+		/**	Recomputes the local and global matrices of all dirty transforms and their descendants.
+		 *	If the hierarchy has changed, the arrays are sorted by depth first.
+		 */
+		void update();
+
+		/**	Recomputes the local and global matrices of all dirty transforms and their descendants,
+		 *	in parallel: The transforms of each depth level are split into chunks of aGrainSize,
+		 *	which are processed on the given thread pool.
+		 *	@param	aThreadPool		The thread pool to use
+		 *	@param	aGrainSize		Number of transforms per chunk. If 0, it is derived from the number of worker threads.
+		 */
+		void update(thread_pool& aThreadPool, size_t aGrainSize = 0);
+
+		/**	Returns the index of the given transform in the sorted arrays, e.g. for accessing
+		 *	global_transformation_matrices(). Indices change whenever the hierarchy changes.
+		 */
+		uint32_t index_of(transform_id aId) const;
+
+		/** Returns the id of the transform at the given index of the sorted arrays */
+		transform_id id_at(uint32_t aIndex) const { return mIdAtIndex[aIndex]; }
+
+		/** Returns all global transformation matrices in the order of the sorted arrays, e.g. for uploading them to the GPU */
+		const std::vector<glm::mat4>& global_transformation_matrices() const { return mWorldMatrices; }
+
+	private:
+		static constexpr uint32_t sInvalidIndex = std::numeric_limits<uint32_t>::max();
+		static constexpr int32_t sNoParent = -1;
+
+		/** Removes destroyed transforms, sorts the arrays by depth, and determines the depth levels */
+		void rebuild();
+
+		/** Updates the transforms in the range [aBegin, aEnd), whose parents must already be up to date */
+		void update_range(size_t aBegin, size_t aEnd);
+
+		// Sorted arrays (structure of arrays), indexed by transform index:
+		std::vector<glm::vec3> mTranslations;
+		std::vector<glm::quat> mRotations;
+		std::vector<glm::vec3> mScales;
+		std::vector<int32_t> mParentIndices;
+		std::vector<glm::mat4> mLocalMatrices;
+		std::vector<glm::mat4> mWorldMatrices;
+		std::vector<uint8_t> mDirty;
+		std::vector<uint8_t> mChanged;
+		std::vector<uint8_t> mAlive;
+		std::vector<transform_id> mIdAtIndex;
+
+		// Indexed by transform id:
+		std::vector<uint32_t> mIndexOfId;
+		std::vector<transform_id> mFreeIds;
+
+		/** Offsets of the depth levels into the sorted arrays, with one additional element at the end */
+		std::vector<uint32_t> mLevels;
+		size_t mNumAlive = 0;
+
+		/** True if the arrays are not sorted by depth, or if they contain destroyed transforms */
+		bool mHierarchyChanged = false;
+	};
+}
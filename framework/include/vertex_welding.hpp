@@ -0,0 +1,24 @@
+#pragma once
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Joins bitwise identical vertices of the given mesh, i.e. a replacement for
+	 *	Assimp's aiProcess_JoinIdenticalVertices post-processing step.
+	 *
+	 *	All vertex attributes are considered for determining whether two vertices
+	 *	are identical: positions, normals, tangents, bitangents, all color sets,
+	 *	all texture coordinate sets, and the bone influences. Each vertex' full
+	 *	attribute tuple is hashed into an open-addressing hash table.
+	 *
+	 *	The mesh is modified in place: The vertex attribute arrays are compacted,
+	 *	the faces' indices are remapped, the bones' vertex weights are remapped,
+	 *	and duplicate weights are removed. No memory is reallocated, which means
+	 *	that the arrays remain owned by Assimp. Meshes with morph targets
+	 *	(i.e. with aiMesh::mNumAnimMeshes > 0) are left untouched.
+	 *
+	 *	@param	aMesh	The mesh to be welded.
+	 *	@return	The number of vertices that have been removed.
+	 */
+	extern uint32_t weld_identical_vertices(aiMesh* aMesh);
+}
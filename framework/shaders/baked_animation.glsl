@@ -0,0 +1,72 @@
+// Fetches and interpolates bone matrices from a baked animation, c.f. gvk::bake_animation
+// and gvk::create_baked_animation_buffer.
+//
+// Usage: Include this file into a vertex shader via
+//   #extension GL_GOOGLE_include_directive : enable
+//   #include "path/to/framework/shaders/baked_animation.glsl"
+// The buffer is declared at set BAKED_ANIMATION_SET and binding BAKED_ANIMATION_BINDING,
+// which can be defined before including this file. The time passed to baked_bone_matrix is
+// relative to the start of the baked clip; per-instance time offsets can just be added to it.
+
+#include "bone_matrix_encoding.glsl"
+
+#ifndef BAKED_ANIMATION_SET
+#define BAKED_ANIMATION_SET 0
+#endif
+#ifndef BAKED_ANIMATION_BINDING
+#define BAKED_ANIMATION_BINDING 0
+#endif
+
+layout (std430, set = BAKED_ANIMATION_SET, binding = BAKED_ANIMATION_BINDING) readonly buffer BakedAnimationBuffer
+{
+	// [0]: (number of frames, bones per frame, effective frames per second, encoding), followed by the frames.
+	// The effective rate places the last frame at exactly the end of the clip, c.f. gvk::baked_animation_frames.
+	vec4 bakedAnimationData[];
+};
+
+// Reads one matrix-encoded bone (mat4 or mat3x4) starting at the given element
+mat4 baked_animation_fetch_matrix(uint aIndex, uint aEncoding)
+{
+	if (aEncoding == BONE_MATRIX_ENCODING_MAT4) {
+		return mat4(bakedAnimationData[aIndex], bakedAnimationData[aIndex + 1u], bakedAnimationData[aIndex + 2u], bakedAnimationData[aIndex + 3u]);
+	}
+	return bone_matrix_from_mat3x4(bakedAnimationData[aIndex], bakedAnimationData[aIndex + 1u], bakedAnimationData[aIndex + 2u]);
+}
+
+// Returns the bone matrix of the given bone at the given time (in seconds), interpolated
+// between the two closest frames. If aLoop is true, the time wraps around at the end of
+// the clip, otherwise it is clamped.
+mat4 baked_bone_matrix(uint aBoneIndex, float aTime, bool aLoop)
+{
+	vec4 header = bakedAnimationData[0];
+	uint numFrames = floatBitsToUint(header.x);
+	uint bonesPerFrame = floatBitsToUint(header.y);
+	float framesPerSecond = header.z; // (number of frames - 1) / duration => loops wrap around at exactly the clip's duration
+	uint encoding = floatBitsToUint(header.w);
+	uint vec4sPerBone = bone_matrix_vec4s_per_bone(encoding);
+
+	float lastFrame = float(numFrames - 1u);
+	float frame = aTime * framesPerSecond;
+	frame = aLoop && lastFrame > 0.0 ? mod(frame, lastFrame) : clamp(frame, 0.0, lastFrame);
+	uint frame0 = min(uint(frame), numFrames - 1u);
+	uint frame1 = min(frame0 + 1u, numFrames - 1u);
+	float f = frame - float(frame0);
+
+	uint index0 = 1u + (frame0 * bonesPerFrame + aBoneIndex) * vec4sPerBone;
+	uint index1 = 1u + (frame1 * bonesPerFrame + aBoneIndex) * vec4sPerBone;
+	if (encoding == BONE_MATRIX_ENCODING_DUAL_QUATERNION) {
+		vec4 real0 = bakedAnimationData[index0], dual0 = bakedAnimationData[index0 + 1u];
+		vec4 real1 = bakedAnimationData[index1], dual1 = bakedAnimationData[index1 + 1u];
+		// Blend along the shortest path:
+		float s = dot(real0, real1) < 0.0 ? -1.0 : 1.0;
+		return bone_matrix_from_dual_quaternion(mix(real0, s * real1, f), mix(dual0, s * dual1, f));
+	}
+	mat4 m0 = baked_animation_fetch_matrix(index0, encoding);
+	mat4 m1 = baked_animation_fetch_matrix(index1, encoding);
+	return m0 * (1.0 - f) + m1 * f;
+}
+
+mat4 baked_bone_matrix(uint aBoneIndex, float aTime)
+{
+	return baked_bone_matrix(aBoneIndex, aTime, true);
+}
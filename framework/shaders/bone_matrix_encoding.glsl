@@ -0,0 +1,97 @@
+// Decodes bone matrices which have been written in one of the formats of gvk::bone_matrix_encoding,
+// c.f. gvk::animation::set_output_encoding.
+//
+// Usage: Include this file into a vertex shader via
+//   #extension GL_GOOGLE_include_directive : enable
+//   #include "path/to/framework/shaders/bone_matrix_encoding.glsl"
+// and declare the bone matrices buffer as an array of vec4, e.g.
+//   layout (std430, set = 0, binding = 0) readonly buffer BoneMatricesBuffer { vec4 boneData[]; };
+// The bone with index i then starts at boneData[i * 4] (mat4), boneData[i * 3] (mat3x4),
+// or boneData[i * 2] (dual quaternion).
+
+#ifndef BONE_MATRIX_ENCODING_GLSL
+#define BONE_MATRIX_ENCODING_GLSL
+
+// Values of gvk::bone_matrix_encoding:
+#define BONE_MATRIX_ENCODING_MAT4            0
+#define BONE_MATRIX_ENCODING_MAT3X4          1
+#define BONE_MATRIX_ENCODING_DUAL_QUATERNION 2
+
+uint bone_matrix_vec4s_per_bone(uint aEncoding)
+{
+	return aEncoding == BONE_MATRIX_ENCODING_MAT4 ? 4u : (aEncoding == BONE_MATRIX_ENCODING_MAT3X4 ? 3u : 2u);
+}
+
+// Creates a bone matrix from the three rows of a row-major 3x4 matrix
+mat4 bone_matrix_from_mat3x4(vec4 aRow0, vec4 aRow1, vec4 aRow2)
+{
+	return transpose(mat4(aRow0, aRow1, aRow2, vec4(0.0, 0.0, 0.0, 1.0)));
+}
+
+// Creates a bone matrix from a dual quaternion, given as real part (x, y, z, w) and dual part (x, y, z, w).
+// The dual quaternion does not have to be normalized, s.t. blended dual quaternions can be passed directly.
+mat4 bone_matrix_from_dual_quaternion(vec4 aReal, vec4 aDual)
+{
+	float len = length(aReal);
+	vec4 r = aReal / len;
+	vec4 d = aDual / len;
+	float x = r.x, y = r.y, z = r.z, w = r.w;
+	vec3 t = 2.0 * (w * d.xyz - d.w * r.xyz + cross(r.xyz, d.xyz));
+	return mat4(
+		vec4(1.0 - 2.0 * (y*y + z*z), 2.0 * (x*y + w*z),       2.0 * (x*z - w*y),       0.0),
+		vec4(2.0 * (x*y - w*z),       1.0 - 2.0 * (x*x + z*z), 2.0 * (y*z + w*x),       0.0),
+		vec4(2.0 * (x*z + w*y),       2.0 * (y*z - w*x),       1.0 - 2.0 * (x*x + y*y), 0.0),
+		vec4(t, 1.0)
+	);
+}
+
+// Creates a dual quaternion, given as real part (x, y, z, w) and dual part (x, y, z, w), from a bone matrix
+// in the same way as gvk::encode_bone_matrix does. Scaling is removed from the basis vectors, i.e. it is lost.
+void dual_quaternion_from_bone_matrix(mat4 aMatrix, out vec4 aReal, out vec4 aDual)
+{
+	mat3 m = mat3(normalize(aMatrix[0].xyz), normalize(aMatrix[1].xyz), normalize(aMatrix[2].xyz));
+	// Rotation matrix to quaternion, choosing the largest component like glm::quat_cast:
+	float fourXSquaredMinus1 = m[0][0] - m[1][1] - m[2][2];
+	float fourYSquaredMinus1 = m[1][1] - m[0][0] - m[2][2];
+	float fourZSquaredMinus1 = m[2][2] - m[0][0] - m[1][1];
+	float fourWSquaredMinus1 = m[0][0] + m[1][1] + m[2][2];
+	int biggestIndex = 0;
+	float fourBiggestSquaredMinus1 = fourWSquaredMinus1;
+	if (fourXSquaredMinus1 > fourBiggestSquaredMinus1) { fourBiggestSquaredMinus1 = fourXSquaredMinus1; biggestIndex = 1; }
+	if (fourYSquaredMinus1 > fourBiggestSquaredMinus1) { fourBiggestSquaredMinus1 = fourYSquaredMinus1; biggestIndex = 2; }
+	if (fourZSquaredMinus1 > fourBiggestSquaredMinus1) { fourBiggestSquaredMinus1 = fourZSquaredMinus1; biggestIndex = 3; }
+	float biggestVal = sqrt(fourBiggestSquaredMinus1 + 1.0) * 0.5;
+	float mult = 0.25 / biggestVal;
+	vec4 q; // (x, y, z, w)
+	if (biggestIndex == 0) {
+		q = vec4((m[1][2] - m[2][1]) * mult, (m[2][0] - m[0][2]) * mult, (m[0][1] - m[1][0]) * mult, biggestVal);
+	}
+	else if (biggestIndex == 1) {
+		q = vec4(biggestVal, (m[0][1] + m[1][0]) * mult, (m[2][0] + m[0][2]) * mult, (m[1][2] - m[2][1]) * mult);
+	}
+	else if (biggestIndex == 2) {
+		q = vec4((m[0][1] + m[1][0]) * mult, biggestVal, (m[1][2] + m[2][1]) * mult, (m[2][0] - m[0][2]) * mult);
+	}
+	else {
+		q = vec4((m[2][0] + m[0][2]) * mult, (m[1][2] + m[2][1]) * mult, biggestVal, (m[0][1] - m[1][0]) * mult);
+	}
+	aReal = normalize(q);
+	// dual = 0.5 * (0, t) * real
+	vec3 t = aMatrix[3].xyz;
+	aDual = vec4(0.5 * (aReal.w * t + cross(t, aReal.xyz)), -0.5 * dot(t, aReal.xyz));
+}
+
+// Dual quaternion linear blending of four bones, with the first bone's rotation as reference
+// for the shortest path. The result can be converted with bone_matrix_from_dual_quaternion.
+void blend_dual_quaternions(vec4 aReals[4], vec4 aDuals[4], vec4 aWeights, out vec4 aReal, out vec4 aDual)
+{
+	aReal = vec4(0.0);
+	aDual = vec4(0.0);
+	for (int i = 0; i < 4; ++i) {
+		float w = dot(aReals[0], aReals[i]) < 0.0 ? -aWeights[i] : aWeights[i];
+		aReal += aReals[i] * w;
+		aDual += aDuals[i] * w;
+	}
+}
+
+#endif
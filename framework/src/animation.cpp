@@ -12,22 +12,27 @@ namespace gvk
 		}
 
 		double timeInTicks = mTime * aClip.mTicksPerSecond;
+		auto* targetStorageBegin = target_storage_begin();
 
 		for (auto& anode : mAnimationData) {
 			// First, calculate the local transform
 			glm::mat4 localTransform{1.0f};
 
 			// The localTransform can only be different than the identity if there are animation keys.
-			if (anode.mPositionKeys.size() + anode.mRotationKeys.size() + anode.mScalingKeys.size() > 0) {
+			if (mSkipUnimportantNodes && anode.mUnimportant && anode.mLocalTransformEvaluated) {
+				// Keep the local transform of the previous evaluation:
+				localTransform = anode.mLocalTransform;
+			}
+			else if (anode.mPositionKeys.size() + anode.mRotationKeys.size() + anode.mScalingKeys.size() > 0) {
 				// Translation/position:
-				auto [tpos1, tpos2] = find_positions_in_keys(anode.mPositionKeys, timeInTicks);
+				auto [tpos1, tpos2] = find_positions_in_keys(anode.mPositionKeys, timeInTicks, anode.mPositionKeyCursor);
 				auto tf = get_interpolation_factor(anode.mPositionKeys[tpos1], anode.mPositionKeys[tpos2], timeInTicks);
 				auto translation = glm::lerp(anode.mPositionKeys[tpos1].mValue, anode.mPositionKeys[tpos2].mValue, tf);
 
 				// Rotation:
 				size_t rpos1 = tpos1, rpos2 = tpos2;
 				if (!anode.mSameRotationAndPositionKeyTimes) {
-					std::tie(rpos1, rpos2) = find_positions_in_keys(anode.mRotationKeys, timeInTicks);
+					std::tie(rpos1, rpos2) = find_positions_in_keys(anode.mRotationKeys, timeInTicks, anode.mRotationKeyCursor);
 				}
 				auto rf = get_interpolation_factor(anode.mRotationKeys[rpos1], anode.mRotationKeys[rpos2], timeInTicks);
 				auto rotation = glm::lerp(anode.mRotationKeys[rpos1].mValue, anode.mRotationKeys[rpos2].mValue, rf);
@@ -35,12 +40,14 @@ namespace gvk
 				// Scaling:
 				size_t spos1 = tpos1, spos2 = tpos2;
 				if (!anode.mSameScalingAndPositionKeyTimes) {
-					std::tie(spos1, spos2) = find_positions_in_keys(anode.mScalingKeys, timeInTicks);
+					std::tie(spos1, spos2) = find_positions_in_keys(anode.mScalingKeys, timeInTicks, anode.mScalingKeyCursor);
 				}
 				auto sf = get_interpolation_factor(anode.mScalingKeys[spos1], anode.mScalingKeys[spos2], timeInTicks);
 				auto scaling = glm::lerp(anode.mScalingKeys[spos1].mValue, anode.mScalingKeys[spos2].mValue, sf);
 
 				localTransform = matrix_from_transforms(translation, rotation, scaling);
+				anode.mLocalTransform = localTransform;
+				anode.mLocalTransformEvaluated = true;
 			}
 
 			// Calculate the node's global transform, using its local transform and the transforms of its parents:
@@ -62,7 +69,66 @@ namespace gvk
 				glm::mat4 boneMatrix = anode.mBoneMeshTargets[i].mInverseMeshRootMatrix * anode.mTransform * anode.
 					mBoneMeshTargets[i].mInverseBindPoseMatrix;
 				// Store into target:
-				*anode.mBoneMeshTargets[i].mBoneMatrixTarget = boneMatrix;
+				write_bone_matrix(boneMatrix, mOutputEncoding, targetStorageBegin, anode.mBoneMeshTargets[i].mBoneMatrixTarget);
+			}
+		}
+	}
+
+	std::vector<size_t> animation::leaf_node_indices() const
+	{
+		std::vector<bool> isParent(mAnimationData.size(), false);
+		for (const auto& anode : mAnimationData) {
+			if (anode.mAnimatedParentIndex.has_value()) {
+				isParent[anode.mAnimatedParentIndex.value()] = true;
+			}
+		}
+		std::vector<size_t> result;
+		for (size_t i = 0; i < isParent.size(); ++i) {
+			if (!isParent[i]) {
+				result.push_back(i);
+			}
+		}
+		return result;
+	}
+
+	void animation::set_unimportant(size_t aNodeIndex, bool aUnimportant)
+	{
+		if (aNodeIndex >= mAnimationData.size()) {
+			throw gvk::logic_error(fmt::format("Node index {} is out of bounds, the animation has only {} nodes.", aNodeIndex, mAnimationData.size()));
+		}
+		mAnimationData[aNodeIndex].mUnimportant = aUnimportant;
+	}
+
+	glm::mat4* animation::target_storage_begin() const
+	{
+		return mMeshIndicesAndTargetStorage.empty() ? nullptr : std::get<glm::mat4*>(mMeshIndicesAndTargetStorage.front());
+	}
+
+	size_t animation::target_storage_size() const
+	{
+		if (mMeshIndicesAndTargetStorage.empty()) {
+			return 0;
+		}
+		const auto* begin = target_storage_begin();
+		size_t size = 0;
+		for (const auto& [meshIndex, target] : mMeshIndicesAndTargetStorage) {
+			size = std::max(size, static_cast<size_t>(target - begin) + mMaxNumBoneMatrices);
+		}
+		return size;
+	}
+
+	void animation::retarget(glm::mat4* aNewBeginningOfTargetStorage)
+	{
+		auto* oldBegin = target_storage_begin();
+		if (nullptr == oldBegin) {
+			return;
+		}
+		for (auto& [meshIndex, target] : mMeshIndicesAndTargetStorage) {
+			target = aNewBeginningOfTargetStorage + (target - oldBegin);
+		}
+		for (auto& anode : mAnimationData) {
+			for (auto& boneMeshTarget : anode.mBoneMeshTargets) {
+				boneMeshTarget.mBoneMatrixTarget = aNewBeginningOfTargetStorage + (boneMeshTarget.mBoneMatrixTarget - oldBegin);
 			}
 		}
 	}
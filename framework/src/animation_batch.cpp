@@ -0,0 +1,198 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/**	Interpolates between two sets of aCount bone matrices, which are stored in the given encoding, c.f. write_bone_matrix.
+	 *	Matrices are interpolated component-wise, dual quaternions are blended along the shortest path and normalized.
+	 */
+	static void interpolate_bone_matrices(const glm::mat4* aFrom, const glm::mat4* aTo, float aFactor, size_t aCount, bone_matrix_encoding aEncoding, glm::mat4* aTarget)
+	{
+		// The encoded bone matrices are tightly packed vec4 elements:
+		const auto* from = reinterpret_cast<const glm::vec4*>(aFrom);
+		const auto* to = reinterpret_cast<const glm::vec4*>(aTo);
+		auto* target = reinterpret_cast<glm::vec4*>(aTarget);
+		if (bone_matrix_encoding::dual_quaternion == aEncoding) {
+			for (size_t i = 0; i < 2 * aCount; i += 2) {
+				const float sign = glm::dot(from[i], to[i]) < 0.0f ? -1.0f : 1.0f;
+				const auto real = glm::mix(from[i], sign * to[i], aFactor);
+				const auto dual = glm::mix(from[i + 1], sign * to[i + 1], aFactor);
+				const auto length = glm::length(real);
+				target[i] = real / length;
+				target[i + 1] = dual / length;
+			}
+			return;
+		}
+		const auto numVec4s = aCount * number_of_vec4s_per_bone(aEncoding);
+		for (size_t i = 0; i < numVec4s; ++i) {
+			target[i] = from[i] + (to[i] - from[i]) * aFactor;
+		}
+	}
+
+	size_t animation_batch::add_instance(animation aAnimation, animation_clip_data aClip, double aTime)
+	{
+		const auto count = aAnimation.target_storage_size();
+		return add(std::move(aAnimation), count, aClip, aTime);
+	}
+
+	size_t animation_batch::add_instance(compiled_animation aAnimation, animation_clip_data aClip, double aTime)
+	{
+		const auto count = aAnimation.target_storage_size();
+		return add(std::move(aAnimation), count, aClip, aTime);
+	}
+
+	size_t animation_batch::add(std::variant<animation, compiled_animation> aAnimation, size_t aPaletteCount, animation_clip_data aClip, double aTime)
+	{
+		const size_t offset = mInstances.empty() ? 0 : mInstances.back().mPaletteOffset + mInstances.back().mPaletteCount;
+		auto& inst = mInstances.emplace_back(instance{ std::move(aAnimation), aClip, aTime, offset, aPaletteCount });
+		inst.mPreviousTime = aTime;
+		// The palette is (re-)allocated and the animations are retargeted lazily in animate():
+		mPaletteOutdated = true;
+		return mInstances.size() - 1;
+	}
+
+	void animation_batch::advance_time(double aDeltaTime)
+	{
+		for (auto& inst : mInstances) {
+			inst.mTime += aDeltaTime;
+		}
+	}
+
+	void animation_batch::animate(thread_pool& aThreadPool, size_t aInstancesPerChunk)
+	{
+		if (mInstances.empty()) {
+			return;
+		}
+
+		if (mPaletteOutdated) {
+			mBonePalette.resize(mInstances.back().mPaletteOffset + mInstances.back().mPaletteCount, bone_palette_matrix{ glm::mat4{ 1.0f } });
+			auto* paletteBegin = &mBonePalette.data()->mMatrix;
+			for (auto& inst : mInstances) {
+				std::visit([target = paletteBegin + inst.mPaletteOffset](auto& bAnimation) {
+					bAnimation.retarget(target);
+				}, inst.mAnimation);
+			}
+			mPaletteOutdated = false;
+		}
+
+		if (0 == aInstancesPerChunk) {
+			// Aim for a few chunks per thread, s.t. instances with differing costs are balanced out:
+			const auto numThreads = static_cast<size_t>(aThreadPool.number_of_workers()) + 1;
+			aInstancesPerChunk = std::max(size_t{ 1 }, mInstances.size() / (numThreads * 4));
+		}
+
+		aThreadPool.parallel_for(0, mInstances.size(), [this](size_t bInstanceIndex) {
+			animate_instance(bInstanceIndex);
+		}, aInstancesPerChunk);
+	}
+
+	void animation_batch::animate_instance(size_t aInstanceIndex)
+	{
+		auto& inst = mInstances[aInstanceIndex];
+		const animation_lod_level level = mLodLevels.empty() ? animation_lod_level{} : mLodLevels[inst.mLodLevel];
+		auto* paletteTarget = &mBonePalette[inst.mPaletteOffset].mMatrix;
+
+		std::visit([&](auto& bAnimation) {
+			if constexpr (std::is_same_v<std::decay_t<decltype(bAnimation)>, animation>) {
+				bAnimation.set_skip_unimportant_nodes(level.mSkipUnimportantNodes);
+			}
+
+			if (level.mUpdateInterval <= 1) {
+				// Evaluate directly into the bone palette:
+				if (bAnimation.target_storage_begin() != paletteTarget) {
+					bAnimation.retarget(paletteTarget);
+				}
+				bAnimation.animate(inst.mClip, inst.mTime);
+				inst.mKeyPosesValid = false;
+				return;
+			}
+
+			auto evaluateKeyPose = [&](size_t bKeyPoseIndex, double bTime) {
+				auto& keyPose = inst.mKeyPoses[bKeyPoseIndex];
+				keyPose.resize(inst.mPaletteCount, glm::mat4{ 1.0f });
+				bAnimation.retarget(keyPose.data());
+				bAnimation.animate(inst.mClip, bTime);
+				inst.mKeyPoseTimes[bKeyPoseIndex] = bTime;
+			};
+			// Evaluate ahead of time, at the time which is expected to be reached by the next evaluation:
+			const double deltaTime = inst.mTime - inst.mPreviousTime;
+
+			if (!inst.mKeyPosesValid || deltaTime < 0.0) {
+				// (Re-)start, e.g. after the level of detail has changed, or after the time has been set backwards.
+				// Stagger the evaluations of different instances across animate() calls:
+				inst.mCallsUntilUpdate = static_cast<uint32_t>(aInstanceIndex % level.mUpdateInterval);
+				evaluateKeyPose(0, inst.mTime);
+				evaluateKeyPose(1, inst.mTime + static_cast<double>(inst.mCallsUntilUpdate + 1) * std::max(0.0, deltaTime));
+				inst.mKeyPosesValid = true;
+			}
+			else if (0 == inst.mCallsUntilUpdate) {
+				std::swap(inst.mKeyPoses[0], inst.mKeyPoses[1]);
+				std::swap(inst.mKeyPoseTimes[0], inst.mKeyPoseTimes[1]);
+				evaluateKeyPose(1, inst.mTime + static_cast<double>(level.mUpdateInterval) * deltaTime);
+				inst.mCallsUntilUpdate = level.mUpdateInterval - 1;
+			}
+			else {
+				--inst.mCallsUntilUpdate;
+			}
+		}, inst.mAnimation);
+		inst.mPreviousTime = inst.mTime;
+
+		if (!inst.mKeyPosesValid) {
+			return;
+		}
+		const auto t0 = inst.mKeyPoseTimes[0];
+		const auto t1 = inst.mKeyPoseTimes[1];
+		const auto f = t1 > t0 ? static_cast<float>(glm::clamp((inst.mTime - t0) / (t1 - t0), 0.0, 1.0)) : 1.0f;
+		const auto encoding = std::visit([](const auto& bAnimation) { return bAnimation.output_encoding(); }, inst.mAnimation);
+		interpolate_bone_matrices(inst.mKeyPoses[0].data(), inst.mKeyPoses[1].data(), f, inst.mPaletteCount, encoding, paletteTarget);
+	}
+
+	void animation_batch::set_lod_levels(std::vector<animation_lod_level> aLevels)
+	{
+		mLodLevels = std::move(aLevels);
+		for (auto& inst : mInstances) {
+			inst.mLodLevel = 0;
+			inst.mKeyPosesValid = false;
+		}
+	}
+
+	void animation_batch::set_lod_level(size_t aInstanceIndex, size_t aLevel)
+	{
+		if (aLevel >= std::max(size_t{ 1 }, mLodLevels.size())) {
+			throw gvk::logic_error(fmt::format("Level of detail {} is out of bounds, there are only {} levels.", aLevel, mLodLevels.size()));
+		}
+		auto& inst = mInstances[aInstanceIndex];
+		if (inst.mLodLevel != aLevel) {
+			inst.mLodLevel = aLevel;
+			inst.mKeyPosesValid = false;
+		}
+	}
+
+	void animation_batch::set_lod_from_distance(size_t aInstanceIndex, float aDistance)
+	{
+		if (mLodLevels.empty()) {
+			return;
+		}
+		size_t level = 0;
+		while (level + 1 < mLodLevels.size() && aDistance > mLodLevels[level].mMaxDistance) {
+			++level;
+		}
+		set_lod_level(aInstanceIndex, level);
+	}
+
+	void animation_batch::set_lod_from_screen_size(size_t aInstanceIndex, float aScreenSize)
+	{
+		if (mLodLevels.empty()) {
+			return;
+		}
+		size_t level = 0;
+		while (level + 1 < mLodLevels.size() && aScreenSize < mLodLevels[level].mMinScreenSize) {
+			++level;
+		}
+		set_lod_level(aInstanceIndex, level);
+	}
+
+	const glm::mat4* animation_batch::bone_palette() const
+	{
+		return mBonePalette.empty() ? nullptr : &mBonePalette.data()->mMatrix;
+	}
+}
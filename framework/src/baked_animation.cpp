@@ -0,0 +1,67 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	std::tuple<uint32_t, float> baked_animation_frames(double aDuration, float aFramesPerSecond)
+	{
+		const auto numFrames = static_cast<uint32_t>(std::ceil(aDuration * aFramesPerSecond)) + 1;
+		if (numFrames < 2 || aDuration <= 0.0) {
+			return std::make_tuple(numFrames, aFramesPerSecond);
+		}
+		return std::make_tuple(numFrames, static_cast<float>(static_cast<double>(numFrames - 1) / aDuration));
+	}
+
+	baked_animation_data bake_animation(animation aAnimation, const animation_clip_data& aClip, float aFramesPerSecond, bone_matrix_encoding aEncoding)
+	{
+		if (aClip.mTicksPerSecond == 0.0) {
+			throw gvk::runtime_error("mTicksPerSecond may not be 0.0 => set a different value!");
+		}
+		if (aFramesPerSecond <= 0.0f) {
+			throw gvk::runtime_error(fmt::format("Invalid sampling rate of {} frames per second.", aFramesPerSecond));
+		}
+
+		const double startTime = aClip.mStartTicks / aClip.mTicksPerSecond;
+		const double duration = std::max(0.0, (aClip.mEndTicks - aClip.mStartTicks) / aClip.mTicksPerSecond);
+		const auto [numFrames, framesPerSecond] = baked_animation_frames(duration, aFramesPerSecond);
+		const auto bonesPerFrame = static_cast<uint32_t>(aAnimation.target_storage_size());
+		const auto vec4sPerBone = number_of_vec4s_per_bone(aEncoding);
+
+		baked_animation_data result;
+		result.mEncoding = aEncoding;
+		result.mNumFrames = numFrames;
+		result.mBonesPerFrame = bonesPerFrame;
+		result.mFramesPerSecond = framesPerSecond;
+		result.mData.resize(1 + static_cast<size_t>(numFrames) * bonesPerFrame * vec4sPerBone);
+		result.mData[0] = glm::vec4{
+			glm::uintBitsToFloat(numFrames),
+			glm::uintBitsToFloat(bonesPerFrame),
+			framesPerSecond,
+			glm::uintBitsToFloat(static_cast<uint32_t>(aEncoding))
+		};
+
+		std::vector<glm::mat4> boneMatrices(bonesPerFrame, glm::mat4{ 1.0f });
+		aAnimation.retarget(boneMatrices.data());
+		aAnimation.set_output_encoding(bone_matrix_encoding::mat4);
+		auto* target = result.mData.data() + 1;
+		for (uint32_t frame = 0; frame < numFrames; ++frame) {
+			// The frames are evenly distributed over the clip, i.e. the last frame is sampled at exactly its end:
+			const double time = startTime + (numFrames > 1 ? static_cast<double>(frame) * duration / static_cast<double>(numFrames - 1) : 0.0);
+			aAnimation.animate(aClip, time);
+			for (const auto& boneMatrix : boneMatrices) {
+				encode_bone_matrix(boneMatrix, aEncoding, target);
+				target += vec4sPerBone;
+			}
+		}
+		return result;
+	}
+
+	avk::buffer create_baked_animation_buffer(const baked_animation_data& aBakedAnimation, avk::sync aSyncHandler)
+	{
+		auto buffer = context().create_buffer(
+			avk::memory_usage::device, {},
+			avk::storage_buffer_meta::create_from_data(aBakedAnimation.mData)
+		);
+		buffer->fill(aBakedAnimation.mData.data(), 0, std::move(aSyncHandler));
+		return buffer;
+	}
+}
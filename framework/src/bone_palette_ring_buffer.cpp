@@ -0,0 +1,70 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	bone_palette_ring_buffer::bone_palette_ring_buffer(bone_palette_ring_buffer&& aOther) noexcept
+		: mBuffers{ std::move(aOther.mBuffers) }
+		, mMappedSlices{ std::move(aOther.mMappedSlices) }
+		, mNumBoneMatrices{ aOther.mNumBoneMatrices }
+	{
+		aOther.mBuffers.clear();
+		aOther.mMappedSlices.clear();
+		aOther.mNumBoneMatrices = 0;
+	}
+
+	bone_palette_ring_buffer& bone_palette_ring_buffer::operator=(bone_palette_ring_buffer&& aOther) noexcept
+	{
+		if (this != &aOther) {
+			unmap_all();
+			mBuffers = std::move(aOther.mBuffers);
+			mMappedSlices = std::move(aOther.mMappedSlices);
+			mNumBoneMatrices = aOther.mNumBoneMatrices;
+			aOther.mBuffers.clear();
+			aOther.mMappedSlices.clear();
+			aOther.mNumBoneMatrices = 0;
+		}
+		return *this;
+	}
+
+	bone_palette_ring_buffer::~bone_palette_ring_buffer()
+	{
+		unmap_all();
+	}
+
+	void bone_palette_ring_buffer::unmap_all()
+	{
+		for (size_t i = 0; i < mMappedSlices.size(); ++i) {
+			if (nullptr != mMappedSlices[i]) {
+				context().device().unmapMemory(mBuffers[i]->memory_handle());
+			}
+		}
+		mMappedSlices.clear();
+	}
+
+	bone_palette_ring_buffer bone_palette_ring_buffer::create(size_t aNumBoneMatrices)
+	{
+		if (0 == aNumBoneMatrices) {
+			throw gvk::runtime_error("A bone_palette_ring_buffer must be able to hold at least one bone matrix.");
+		}
+
+		bone_palette_ring_buffer result;
+		result.mNumBoneMatrices = aNumBoneMatrices;
+		const auto numSlices = context().main_window()->number_of_frames_in_flight();
+		for (decltype(numSlices) i = 0; i < numSlices; ++i) {
+			auto& buffer = result.mBuffers.emplace_back(context().create_buffer(
+				avk::memory_usage::host_coherent, {}, // => written through the mapped pointers without flushing
+				avk::storage_buffer_meta::create_from_size(sizeof(glm::mat4) * aNumBoneMatrices)
+			));
+			// Map once and keep it mapped for the buffer's whole lifetime:
+			auto* mapped = context().device().mapMemory(buffer->memory_handle(), 0, VK_WHOLE_SIZE);
+			result.mMappedSlices.push_back(static_cast<glm::mat4*>(mapped));
+			std::fill(result.mMappedSlices.back(), result.mMappedSlices.back() + aNumBoneMatrices, glm::mat4{ 1.0f });
+		}
+		return result;
+	}
+
+	size_t bone_palette_ring_buffer::current_slice_index() const
+	{
+		return static_cast<size_t>(context().main_window()->current_in_flight_index());
+	}
+}
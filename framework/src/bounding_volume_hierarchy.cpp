@@ -0,0 +1,505 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	/** Nodes with at least this many primitives are binned in parallel, and their subtrees are built concurrently */
+	static constexpr uint32_t sParallelBuildThreshold = 4096;
+	/** Number of primitives which are binned by one task */
+	static constexpr uint32_t sPrimitivesPerBinningTask = 16384;
+
+	static bounding_box empty_bounding_box()
+	{
+		return bounding_box{ glm::vec3{ std::numeric_limits<float>::max() }, glm::vec3{ -std::numeric_limits<float>::max() } };
+	}
+
+	static void grow(bounding_box& aBox, const bounding_box& aOther)
+	{
+		aBox.mMin = glm::min(aBox.mMin, aOther.mMin);
+		aBox.mMax = glm::max(aBox.mMax, aOther.mMax);
+	}
+
+	static void grow(bounding_box& aBox, const glm::vec3& aPoint)
+	{
+		aBox.mMin = glm::min(aBox.mMin, aPoint);
+		aBox.mMax = glm::max(aBox.mMax, aPoint);
+	}
+
+	static bool are_equal(const bounding_box& aLeft, const bounding_box& aRight)
+	{
+		return aLeft.mMin == aRight.mMin && aLeft.mMax == aRight.mMax;
+	}
+
+	/** Returns half of the surface area, which is sufficient for comparing costs. Empty boxes have an area of 0. */
+	static float half_area(const bounding_box& aBox)
+	{
+		const auto e = glm::max(aBox.mMax - aBox.mMin, glm::vec3{ 0.0f });
+		return e.x * e.y + e.y * e.z + e.z * e.x;
+	}
+
+	/** Returns the distance along the ray at which it enters the box, or nothing if it misses the box within [0, aMaxDistance]. */
+	static std::optional<float> intersect_ray_box(const glm::vec3& aOrigin, const glm::vec3& aInvDirection, float aMaxDistance, const bounding_box& aBox)
+	{
+		const auto t0 = (aBox.mMin - aOrigin) * aInvDirection;
+		const auto t1 = (aBox.mMax - aOrigin) * aInvDirection;
+		const auto tNear = glm::min(t0, t1);
+		const auto tFar = glm::max(t0, t1);
+		const auto tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		const auto tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, aMaxDistance));
+		if (tEnter > tExit) {
+			return {};
+		}
+		return tEnter;
+	}
+
+	static float distance_to_box(const glm::vec3& aPoint, const bounding_box& aBox)
+	{
+		return glm::length(glm::max(glm::max(aBox.mMin - aPoint, aPoint - aBox.mMax), glm::vec3{ 0.0f }));
+	}
+
+	/** Bounds of a range of primitives, and the bounds of their centroids */
+	struct bvh_range_bounds
+	{
+		bounding_box mBounds = empty_bounding_box();
+		bounding_box mCentroidBounds = empty_bounding_box();
+	};
+
+	/** Primitive count and bounds of one bin of a node */
+	struct bvh_bin
+	{
+		uint32_t mCount = 0;
+		bounding_box mBounds = empty_bounding_box();
+	};
+
+	void bounding_volume_hierarchy::build(std::vector<bounding_box> aPrimitiveBounds, uint32_t aMaxLeafSize)
+	{
+		build(nullptr, std::move(aPrimitiveBounds), aMaxLeafSize);
+	}
+
+	void bounding_volume_hierarchy::build(thread_pool& aThreadPool, std::vector<bounding_box> aPrimitiveBounds, uint32_t aMaxLeafSize)
+	{
+		build(&aThreadPool, std::move(aPrimitiveBounds), aMaxLeafSize);
+	}
+
+	void bounding_volume_hierarchy::build(thread_pool* aThreadPool, std::vector<bounding_box> aPrimitiveBounds, uint32_t aMaxLeafSize)
+	{
+		if (aPrimitiveBounds.size() >= std::numeric_limits<uint32_t>::max() / 2) {
+			throw gvk::runtime_error(fmt::format("Can not build a bounding volume hierarchy over {} primitives.", aPrimitiveBounds.size()));
+		}
+		mPrimitiveBounds = std::move(aPrimitiveBounds);
+		mMaxLeafSize = std::max(aMaxLeafSize, 1u);
+		const auto numPrimitives = static_cast<uint32_t>(mPrimitiveBounds.size());
+
+		mNodes.clear();
+		mPrimitiveIndices.resize(numPrimitives);
+		std::iota(std::begin(mPrimitiveIndices), std::end(mPrimitiveIndices), 0u);
+		if (0 == numPrimitives) {
+			mParents.clear();
+			mLeafOfPrimitive.clear();
+			return;
+		}
+
+		std::vector<glm::vec3> centroids(numPrimitives);
+		for (uint32_t i = 0; i < numPrimitives; ++i) {
+			centroids[i] = (mPrimitiveBounds[i].mMin + mPrimitiveBounds[i].mMax) * 0.5f;
+		}
+
+		// A binary tree with N leaves has 2N-1 nodes. The children of a node are allocated after the
+		// node itself, i.e. they always have higher indices than their parent:
+		mNodes.resize(2 * static_cast<size_t>(numPrimitives) - 1);
+		std::atomic<uint32_t> nextNode{ 1u };
+		build_node(0u, 0u, numPrimitives, centroids, nextNode, aThreadPool);
+		mNodes.resize(nextNode.load());
+
+		mParents.assign(mNodes.size(), 0u);
+		mLeafOfPrimitive.resize(numPrimitives);
+		for (uint32_t n = 0; n < static_cast<uint32_t>(mNodes.size()); ++n) {
+			const auto& nd = mNodes[n];
+			if (0u != nd.mLeftChild) {
+				mParents[nd.mLeftChild] = n;
+				mParents[nd.mLeftChild + 1] = n;
+				continue;
+			}
+			for (uint32_t i = nd.mFirstPrimitive; i < nd.mFirstPrimitive + nd.mNumPrimitives; ++i) {
+				mLeafOfPrimitive[mPrimitiveIndices[i]] = n;
+			}
+		}
+		LOG_DEBUG(fmt::format("Built a bounding volume hierarchy with {} nodes over {} primitives, SAH cost: {}", mNodes.size(), numPrimitives, sah_cost()));
+	}
+
+	void bounding_volume_hierarchy::build_node(uint32_t aNodeIndex, uint32_t aFirst, uint32_t aCount, const std::vector<glm::vec3>& aCentroids, std::atomic<uint32_t>& aNextNode, thread_pool* aThreadPool)
+	{
+		const bool parallel = nullptr != aThreadPool && aCount >= sParallelBuildThreshold;
+		const auto numTasks = parallel ? (aCount + sPrimitivesPerBinningTask - 1) / sPrimitivesPerBinningTask : 1u;
+		auto forEachChunk = [&](auto bFunc) {
+			auto chunk = [&](size_t bTask) {
+				const auto begin = aFirst + static_cast<uint32_t>(bTask) * sPrimitivesPerBinningTask;
+				const auto end = numTasks > 1 ? std::min(begin + sPrimitivesPerBinningTask, aFirst + aCount) : aFirst + aCount;
+				bFunc(bTask, begin, end);
+			};
+			if (numTasks > 1) {
+				aThreadPool->parallel_for(0, numTasks, chunk);
+			}
+			else {
+				chunk(0);
+			}
+		};
+
+		// Bounds of all the primitives and of their centroids:
+		std::vector<bvh_range_bounds> rangeBounds(numTasks);
+		forEachChunk([&](size_t bTask, uint32_t bBegin, uint32_t bEnd) {
+			auto& rb = rangeBounds[bTask];
+			for (uint32_t i = bBegin; i < bEnd; ++i) {
+				const auto p = mPrimitiveIndices[i];
+				grow(rb.mBounds, mPrimitiveBounds[p]);
+				grow(rb.mCentroidBounds, aCentroids[p]);
+			}
+		});
+		for (size_t t = 1; t < rangeBounds.size(); ++t) {
+			grow(rangeBounds[0].mBounds, rangeBounds[t].mBounds);
+			grow(rangeBounds[0].mCentroidBounds, rangeBounds[t].mCentroidBounds);
+		}
+
+		auto& nd = mNodes[aNodeIndex];
+		nd.mBounds = rangeBounds[0].mBounds;
+		nd.mFirstPrimitive = aFirst;
+		nd.mNumPrimitives = aCount;
+		nd.mLeftChild = 0u;
+		if (aCount <= mMaxLeafSize) {
+			return;
+		}
+
+		const auto& centroidBounds = rangeBounds[0].mCentroidBounds;
+		const auto centroidExtent = centroidBounds.mMax - centroidBounds.mMin;
+		const int axis = centroidExtent.x >= centroidExtent.y
+			? (centroidExtent.x >= centroidExtent.z ? 0 : 2)
+			: (centroidExtent.y >= centroidExtent.z ? 1 : 2);
+
+		uint32_t numLeft = 0;
+		if (centroidExtent[axis] > 0.0f && std::isfinite(centroidExtent[axis])) {
+			// Assign the centroids to the bins:
+			const auto binMin = centroidBounds.mMin[axis];
+			const auto binScale = static_cast<float>(sNumBins) * (1.0f - 1e-5f) / centroidExtent[axis];
+			auto binOf = [&](uint32_t bPrimitive) {
+				const auto bin = (aCentroids[bPrimitive][axis] - binMin) * binScale;
+				// Non-finite centroids end up in the first or in the last bin:
+				return bin > 0.0f ? static_cast<uint32_t>(std::min(bin, static_cast<float>(sNumBins - 1))) : 0u;
+			};
+			std::vector<std::array<bvh_bin, sNumBins>> taskBins(numTasks);
+			forEachChunk([&](size_t bTask, uint32_t bBegin, uint32_t bEnd) {
+				auto& bins = taskBins[bTask];
+				for (uint32_t i = bBegin; i < bEnd; ++i) {
+					const auto p = mPrimitiveIndices[i];
+					auto& bin = bins[binOf(p)];
+					++bin.mCount;
+					grow(bin.mBounds, mPrimitiveBounds[p]);
+				}
+			});
+			auto& bins = taskBins[0];
+			for (size_t t = 1; t < taskBins.size(); ++t) {
+				for (uint32_t b = 0; b < sNumBins; ++b) {
+					bins[b].mCount += taskBins[t][b].mCount;
+					grow(bins[b].mBounds, taskBins[t][b].mBounds);
+				}
+			}
+
+			// Sweep from the right to get the cost of the right sides, then from the left to find the cheapest split,
+			// where a split after bin b puts the bins [0, b] into the left child:
+			std::array<float, sNumBins> rightCosts;
+			auto rightBounds = empty_bounding_box();
+			uint32_t rightCount = 0;
+			for (uint32_t b = sNumBins - 1; b > 0; --b) {
+				grow(rightBounds, bins[b].mBounds);
+				rightCount += bins[b].mCount;
+				rightCosts[b - 1] = half_area(rightBounds) * static_cast<float>(rightCount);
+			}
+			auto leftBounds = empty_bounding_box();
+			uint32_t leftCount = 0;
+			uint32_t bestSplit = 0;
+			auto bestCost = std::numeric_limits<float>::max();
+			for (uint32_t b = 0; b < sNumBins - 1; ++b) {
+				grow(leftBounds, bins[b].mBounds);
+				leftCount += bins[b].mCount;
+				const auto cost = half_area(leftBounds) * static_cast<float>(leftCount) + rightCosts[b];
+				if (leftCount > 0 && leftCount < aCount && cost < bestCost) {
+					bestCost = cost;
+					bestSplit = b;
+					numLeft = leftCount;
+				}
+			}
+
+			// With finite bounds, the lowest and the highest centroid are in the first and in the last bin => there is
+			// a valid split. Non-finite bounds lead to non-finite costs, though, which never win:
+			if (numLeft > 0) {
+				const auto first = std::begin(mPrimitiveIndices) + aFirst;
+				std::partition(first, first + aCount, [&](uint32_t bPrimitive) { return binOf(bPrimitive) <= bestSplit; });
+			}
+		}
+		if (0 == numLeft) {
+			// All centroids coincide, or there are non-finite bounds => SAH can not distinguish between the primitives, split them in half:
+			numLeft = aCount / 2;
+		}
+
+		const auto leftChild = aNextNode.fetch_add(2u);
+		nd.mLeftChild = leftChild;
+		auto buildChild = [&](size_t bChild) {
+			if (0 == bChild) {
+				build_node(leftChild, aFirst, numLeft, aCentroids, aNextNode, aThreadPool);
+			}
+			else {
+				build_node(leftChild + 1, aFirst + numLeft, aCount - numLeft, aCentroids, aNextNode, aThreadPool);
+			}
+		};
+		if (parallel) {
+			aThreadPool->parallel_for(0, 2, buildChild);
+		}
+		else {
+			buildChild(0);
+			buildChild(1);
+		}
+	}
+
+	bounding_box bounding_volume_hierarchy::leaf_bounds(const node& aNode) const
+	{
+		auto result = empty_bounding_box();
+		for (uint32_t i = aNode.mFirstPrimitive; i < aNode.mFirstPrimitive + aNode.mNumPrimitives; ++i) {
+			grow(result, mPrimitiveBounds[mPrimitiveIndices[i]]);
+		}
+		return result;
+	}
+
+	void bounding_volume_hierarchy::refit(std::vector<bounding_box> aPrimitiveBounds)
+	{
+		if (aPrimitiveBounds.size() != mPrimitiveBounds.size()) {
+			throw gvk::runtime_error(fmt::format("Can not refit a bounding volume hierarchy over {} primitives with {} bounding boxes.", mPrimitiveBounds.size(), aPrimitiveBounds.size()));
+		}
+		mPrimitiveBounds = std::move(aPrimitiveBounds);
+
+		// Children have higher indices than their parents => update bottom-up by iterating backwards:
+		for (auto it = mNodes.rbegin(); it != mNodes.rend(); ++it) {
+			if (0u == it->mLeftChild) {
+				it->mBounds = leaf_bounds(*it);
+			}
+			else {
+				it->mBounds = mNodes[it->mLeftChild].mBounds;
+				grow(it->mBounds, mNodes[it->mLeftChild + 1].mBounds);
+			}
+		}
+	}
+
+	void bounding_volume_hierarchy::refit(const std::vector<uint32_t>& aPrimitiveIndices, const std::vector<bounding_box>& aNewBounds)
+	{
+		if (aPrimitiveIndices.size() != aNewBounds.size()) {
+			throw gvk::runtime_error(fmt::format("Number of primitive indices ({}) and bounding boxes ({}) passed to refit differ.", aPrimitiveIndices.size(), aNewBounds.size()));
+		}
+		for (size_t i = 0; i < aPrimitiveIndices.size(); ++i) {
+			if (aPrimitiveIndices[i] >= mPrimitiveBounds.size()) {
+				throw gvk::runtime_error(fmt::format("Primitive index {} passed to refit is out of range; the bounding volume hierarchy has {} primitives.", aPrimitiveIndices[i], mPrimitiveBounds.size()));
+			}
+			mPrimitiveBounds[aPrimitiveIndices[i]] = aNewBounds[i];
+		}
+
+		for (auto primitive : aPrimitiveIndices) {
+			auto n = mLeafOfPrimitive[primitive];
+			auto& leaf = mNodes[n];
+			const auto newLeafBounds = leaf_bounds(leaf);
+			if (are_equal(newLeafBounds, leaf.mBounds)) {
+				continue;
+			}
+			leaf.mBounds = newLeafBounds;
+			// Walk up until a node's bounds do not change anymore:
+			while (0u != n) {
+				n = mParents[n];
+				auto& parent = mNodes[n];
+				auto newBounds = mNodes[parent.mLeftChild].mBounds;
+				grow(newBounds, mNodes[parent.mLeftChild + 1].mBounds);
+				if (are_equal(newBounds, parent.mBounds)) {
+					break;
+				}
+				parent.mBounds = newBounds;
+			}
+		}
+	}
+
+	void bounding_volume_hierarchy::query_frustum(const frustum& aFrustum, std::vector<uint32_t>& aVisibleIndicesOut) const
+	{
+		aVisibleIndicesOut.clear();
+		if (mNodes.empty()) {
+			return;
+		}
+
+		// Each bit of a plane mask denotes a plane which still has to be tested. Once a node is completely
+		// on the inner side of a plane, so are all nodes of its subtree.
+		auto testPlanes = [&aFrustum](const bounding_box& bBox, uint32_t& bPlaneMask) {
+			const auto center = (bBox.mMin + bBox.mMax) * 0.5f;
+			const auto extent = (bBox.mMax - bBox.mMin) * 0.5f;
+			for (uint32_t i = 0; i < 6; ++i) {
+				if (0u == (bPlaneMask & (1u << i))) {
+					continue;
+				}
+				const auto& plane = aFrustum.mPlanes[i];
+				const auto normal = glm::vec3{ plane };
+				const auto d = glm::dot(normal, center) + plane.w;
+				const auto r = glm::dot(glm::abs(normal), extent);
+				if (d < -r) {
+					return false;
+				}
+				if (d >= r) {
+					bPlaneMask &= ~(1u << i);
+				}
+			}
+			return true;
+		};
+
+		std::vector<std::tuple<uint32_t, uint32_t>> stack;
+		stack.reserve(64);
+		stack.emplace_back(0u, 0x3Fu);
+		while (!stack.empty()) {
+			auto [n, planeMask] = stack.back();
+			stack.pop_back();
+			const auto& nd = mNodes[n];
+			if (!testPlanes(nd.mBounds, planeMask)) {
+				continue;
+			}
+			if (0u == planeMask) {
+				const auto first = std::begin(mPrimitiveIndices) + nd.mFirstPrimitive;
+				aVisibleIndicesOut.insert(std::end(aVisibleIndicesOut), first, first + nd.mNumPrimitives);
+				continue;
+			}
+			if (0u == nd.mLeftChild) {
+				for (uint32_t i = nd.mFirstPrimitive; i < nd.mFirstPrimitive + nd.mNumPrimitives; ++i) {
+					auto primitiveMask = planeMask;
+					if (testPlanes(mPrimitiveBounds[mPrimitiveIndices[i]], primitiveMask)) {
+						aVisibleIndicesOut.push_back(mPrimitiveIndices[i]);
+					}
+				}
+				continue;
+			}
+			stack.emplace_back(nd.mLeftChild + 1, planeMask);
+			stack.emplace_back(nd.mLeftChild, planeMask);
+		}
+	}
+
+	std::optional<bvh_ray_hit> bounding_volume_hierarchy::intersect_ray(const glm::vec3& aOrigin, const glm::vec3& aDirection, float aMaxDistance, const std::function<std::optional<float>(uint32_t)>& aPrimitiveIntersector) const
+	{
+		std::optional<bvh_ray_hit> result;
+		if (mNodes.empty()) {
+			return result;
+		}
+		const auto invDirection = 1.0f / aDirection;
+		auto closest = aMaxDistance;
+
+		// Stack of nodes and the distances at which the ray enters them:
+		std::vector<std::tuple<uint32_t, float>> stack;
+		stack.reserve(64);
+		if (const auto t = intersect_ray_box(aOrigin, invDirection, closest, mNodes[0].mBounds); t.has_value()) {
+			stack.emplace_back(0u, t.value());
+		}
+		while (!stack.empty()) {
+			const auto [n, tEnter] = stack.back();
+			stack.pop_back();
+			if (tEnter > closest) {
+				continue;
+			}
+			const auto& nd = mNodes[n];
+			if (0u == nd.mLeftChild) {
+				for (uint32_t i = nd.mFirstPrimitive; i < nd.mFirstPrimitive + nd.mNumPrimitives; ++i) {
+					const auto primitive = mPrimitiveIndices[i];
+					auto t = intersect_ray_box(aOrigin, invDirection, closest, mPrimitiveBounds[primitive]);
+					if (t.has_value() && aPrimitiveIntersector) {
+						t = aPrimitiveIntersector(primitive);
+					}
+					if (t.has_value() && t.value() >= 0.0f && t.value() <= closest) {
+						closest = t.value();
+						result = bvh_ray_hit{ primitive, t.value() };
+					}
+				}
+				continue;
+			}
+			// Visit the nearer child first, i.e. push it last:
+			auto tLeft = intersect_ray_box(aOrigin, invDirection, closest, mNodes[nd.mLeftChild].mBounds);
+			auto tRight = intersect_ray_box(aOrigin, invDirection, closest, mNodes[nd.mLeftChild + 1].mBounds);
+			if (tLeft.has_value() && tRight.has_value()) {
+				if (tLeft.value() <= tRight.value()) {
+					stack.emplace_back(nd.mLeftChild + 1, tRight.value());
+					stack.emplace_back(nd.mLeftChild, tLeft.value());
+				}
+				else {
+					stack.emplace_back(nd.mLeftChild, tLeft.value());
+					stack.emplace_back(nd.mLeftChild + 1, tRight.value());
+				}
+			}
+			else if (tLeft.has_value()) {
+				stack.emplace_back(nd.mLeftChild, tLeft.value());
+			}
+			else if (tRight.has_value()) {
+				stack.emplace_back(nd.mLeftChild + 1, tRight.value());
+			}
+		}
+		return result;
+	}
+
+	std::optional<bvh_nearest_primitive> bounding_volume_hierarchy::find_nearest(const glm::vec3& aPoint, float aMaxDistance, const std::function<float(uint32_t)>& aPrimitiveDistance) const
+	{
+		std::optional<bvh_nearest_primitive> result;
+		if (mNodes.empty()) {
+			return result;
+		}
+		auto closest = aMaxDistance;
+
+		// Stack of nodes and their distances from aPoint:
+		std::vector<std::tuple<uint32_t, float>> stack;
+		stack.reserve(64);
+		stack.emplace_back(0u, distance_to_box(aPoint, mNodes[0].mBounds));
+		while (!stack.empty()) {
+			const auto [n, distance] = stack.back();
+			stack.pop_back();
+			if (distance > closest) {
+				continue;
+			}
+			const auto& nd = mNodes[n];
+			if (0u == nd.mLeftChild) {
+				for (uint32_t i = nd.mFirstPrimitive; i < nd.mFirstPrimitive + nd.mNumPrimitives; ++i) {
+					const auto primitive = mPrimitiveIndices[i];
+					auto d = distance_to_box(aPoint, mPrimitiveBounds[primitive]);
+					if (d <= closest && aPrimitiveDistance) {
+						d = aPrimitiveDistance(primitive);
+					}
+					if (d <= closest) {
+						closest = d;
+						result = bvh_nearest_primitive{ primitive, d };
+					}
+				}
+				continue;
+			}
+			// Visit the nearer child first, i.e. push it last:
+			const auto dLeft = distance_to_box(aPoint, mNodes[nd.mLeftChild].mBounds);
+			const auto dRight = distance_to_box(aPoint, mNodes[nd.mLeftChild + 1].mBounds);
+			if (dLeft <= dRight) {
+				stack.emplace_back(nd.mLeftChild + 1, dRight);
+				stack.emplace_back(nd.mLeftChild, dLeft);
+			}
+			else {
+				stack.emplace_back(nd.mLeftChild, dLeft);
+				stack.emplace_back(nd.mLeftChild + 1, dRight);
+			}
+		}
+		return result;
+	}
+
+	float bounding_volume_hierarchy::sah_cost() const
+	{
+		if (mNodes.empty()) {
+			return 0.0f;
+		}
+		const auto rootArea = half_area(mNodes[0].mBounds);
+		if (rootArea <= 0.0f) {
+			return static_cast<float>(mNodes[0].mNumPrimitives);
+		}
+		// Traversal steps and primitive tests are assumed to have the same cost:
+		float cost = 0.0f;
+		for (const auto& nd : mNodes) {
+			cost += half_area(nd.mBounds) * (0u == nd.mLeftChild ? static_cast<float>(nd.mNumPrimitives) : 1.0f);
+		}
+		return cost / rootArea;
+	}
+}
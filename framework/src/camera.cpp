@@ -157,6 +157,11 @@ namespace gvk
 		return projection_matrix() * view_matrix();
 	}
 
+	frustum camera::view_frustum() const
+	{
+		return extract_frustum(projection_and_view_matrix());
+	}
+
 	void camera::update_projection_matrix()
 	{
 		switch (mProjectionType) {
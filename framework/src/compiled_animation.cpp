@@ -0,0 +1,292 @@
+#include <gvk.hpp>
+#include <immintrin.h>
+
+namespace gvk
+{
+#if defined(__AVX__)
+	using simd_float = __m256;
+	static constexpr size_t sSimdWidth = 8;
+	static inline simd_float simd_load(const float* aPtr) { return _mm256_loadu_ps(aPtr); }
+	static inline void simd_store(float* aPtr, simd_float aValue) { _mm256_storeu_ps(aPtr, aValue); }
+	static inline simd_float simd_set1(float aValue) { return _mm256_set1_ps(aValue); }
+	static inline simd_float simd_add(simd_float a, simd_float b) { return _mm256_add_ps(a, b); }
+	static inline simd_float simd_sub(simd_float a, simd_float b) { return _mm256_sub_ps(a, b); }
+	static inline simd_float simd_mul(simd_float a, simd_float b) { return _mm256_mul_ps(a, b); }
+	static inline simd_float simd_div(simd_float a, simd_float b) { return _mm256_div_ps(a, b); }
+	static inline simd_float simd_sqrt(simd_float a) { return _mm256_sqrt_ps(a); }
+	static inline simd_float simd_xor(simd_float a, simd_float b) { return _mm256_xor_ps(a, b); }
+	static inline simd_float simd_and(simd_float a, simd_float b) { return _mm256_and_ps(a, b); }
+	static inline simd_float simd_less(simd_float a, simd_float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+#else
+	using simd_float = __m128;
+	static constexpr size_t sSimdWidth = 4;
+	static inline simd_float simd_load(const float* aPtr) { return _mm_loadu_ps(aPtr); }
+	static inline void simd_store(float* aPtr, simd_float aValue) { _mm_storeu_ps(aPtr, aValue); }
+	static inline simd_float simd_set1(float aValue) { return _mm_set1_ps(aValue); }
+	static inline simd_float simd_add(simd_float a, simd_float b) { return _mm_add_ps(a, b); }
+	static inline simd_float simd_sub(simd_float a, simd_float b) { return _mm_sub_ps(a, b); }
+	static inline simd_float simd_mul(simd_float a, simd_float b) { return _mm_mul_ps(a, b); }
+	static inline simd_float simd_div(simd_float a, simd_float b) { return _mm_div_ps(a, b); }
+	static inline simd_float simd_sqrt(simd_float a) { return _mm_sqrt_ps(a); }
+	static inline simd_float simd_xor(simd_float a, simd_float b) { return _mm_xor_ps(a, b); }
+	static inline simd_float simd_and(simd_float a, simd_float b) { return _mm_and_ps(a, b); }
+	static inline simd_float simd_less(simd_float a, simd_float b) { return _mm_cmplt_ps(a, b); }
+#endif
+
+	// Layout of compiled_animation::mScratch, in units of mNumPaddedNodes floats:
+	static constexpr size_t sScratchFrom = 0;     // 10 components: translation xyz, rotation xyzw, scaling xyz
+	static constexpr size_t sScratchTo = 10;      // 10 components, same as above
+	static constexpr size_t sScratchFactors = 20; // 3 components: translation, rotation, scaling factors
+	static constexpr size_t sScratchLocal = 23;   // 12 components: three basis vectors and translation of the local matrices
+	static constexpr size_t sScratchSize = 35;
+
+	/** Multiplies two column-major 4x4 matrices, i.e. computes aA * aB, with SSE. */
+	static inline void multiply_mat4(const glm::mat4& aA, const glm::mat4& aB, glm::mat4& aResult)
+	{
+		const float* a = glm::value_ptr(aA);
+		const float* b = glm::value_ptr(aB);
+		const __m128 a0 = _mm_loadu_ps(a + 0);
+		const __m128 a1 = _mm_loadu_ps(a + 4);
+		const __m128 a2 = _mm_loadu_ps(a + 8);
+		const __m128 a3 = _mm_loadu_ps(a + 12);
+		float* r = glm::value_ptr(aResult);
+		for (int c = 0; c < 4; ++c) {
+			__m128 col = _mm_mul_ps(a0, _mm_set1_ps(b[4 * c + 0]));
+			col = _mm_add_ps(col, _mm_mul_ps(a1, _mm_set1_ps(b[4 * c + 1])));
+			col = _mm_add_ps(col, _mm_mul_ps(a2, _mm_set1_ps(b[4 * c + 2])));
+			col = _mm_add_ps(col, _mm_mul_ps(a3, _mm_set1_ps(b[4 * c + 3])));
+			_mm_storeu_ps(r + 4 * c, col);
+		}
+	}
+
+	uint32_t find_position_in_times(const float* aTimes, uint32_t aCount, float aTime, uint32_t& aCursor)
+	{
+		static constexpr uint32_t sMaxIncrementalSteps = 4;
+		const uint32_t maxIndex = aCount - 1;
+		uint32_t pos = std::min(aCursor, maxIndex);
+		if (0 == pos || aTimes[pos] <= aTime) {
+			for (uint32_t steps = 0; pos < maxIndex && aTimes[pos + 1] <= aTime && steps < sMaxIncrementalSteps; ++steps) {
+				++pos;
+			}
+			if (pos < maxIndex && aTimes[pos + 1] <= aTime) {
+				pos = static_cast<uint32_t>(std::upper_bound(aTimes + pos, aTimes + aCount, aTime) - aTimes) - 1;
+			}
+		}
+		else {
+			const auto* it = std::upper_bound(aTimes, aTimes + pos, aTime);
+			pos = it == aTimes ? 0 : static_cast<uint32_t>(it - aTimes) - 1;
+		}
+		aCursor = pos;
+		return pos;
+	}
+
+	compiled_animation animation::compile() const
+	{
+		compiled_animation result;
+		result.mAnimationIndex = mAnimationIndex;
+		result.mTargetStorageBegin = target_storage_begin();
+		result.mOutputEncoding = mOutputEncoding;
+		result.mTargetStorageSize = target_storage_size();
+		result.mNumNodes = mAnimationData.size();
+		result.mNumPaddedNodes = (result.mNumNodes + sSimdWidth - 1) / sSimdWidth * sSimdWidth;
+
+		auto appendKeys = [n = result.mNumNodes](compiled_animation::key_stream& bStream, const auto& bKeys, size_t bNumComponents) {
+			if (bStream.mOffsets.empty()) {
+				bStream.mOffsets.reserve(n);
+				bStream.mCounts.reserve(n);
+			}
+			bStream.mOffsets.push_back(static_cast<uint32_t>(bStream.mTimes.size()));
+			bStream.mCounts.push_back(static_cast<uint32_t>(bKeys.size()));
+			for (const auto& key : bKeys) {
+				bStream.mTimes.push_back(static_cast<float>(key.mTime));
+				for (size_t c = 0; c < bNumComponents; ++c) {
+					bStream.mValues[c].push_back(key.mValue[static_cast<glm::length_t>(c)]);
+				}
+			}
+		};
+
+		for (size_t i = 0; i < mAnimationData.size(); ++i) {
+			const auto& anode = mAnimationData[i];
+			appendKeys(result.mPositions, anode.mPositionKeys, 3);
+			appendKeys(result.mRotations, anode.mRotationKeys, 4);
+			appendKeys(result.mScalings, anode.mScalingKeys, 3);
+
+			if (anode.mAnimatedParentIndex.has_value()) {
+				if (anode.mAnimatedParentIndex.value() >= i) {
+					throw gvk::logic_error(fmt::format("The animated parent of node {} is stored at index {}, but parents must be stored before their children.", i, anode.mAnimatedParentIndex.value()));
+				}
+				result.mParentIndices.push_back(static_cast<int64_t>(anode.mAnimatedParentIndex.value()));
+			}
+			else {
+				result.mParentIndices.push_back(-1);
+			}
+			result.mParentTransforms.push_back(anode.mParentTransform);
+
+			for (const auto& boneMeshTarget : anode.mBoneMeshTargets) {
+				result.mBoneOutputs.push_back(compiled_animation::bone_output{ i, boneMeshTarget.mInverseMeshRootMatrix, boneMeshTarget.mInverseBindPoseMatrix, boneMeshTarget.mBoneMatrixTarget });
+			}
+		}
+
+		for (auto* stream : { &result.mPositions, &result.mRotations, &result.mScalings }) {
+			stream->mCursors.resize(result.mNumNodes, 0u);
+		}
+		result.mGlobalTransforms.resize(result.mNumNodes, glm::mat4{ 1.0f });
+		result.mScratch.resize(sScratchSize * result.mNumPaddedNodes, 0.0f);
+		// Padding lanes must contain valid (i.e. unit) quaternions, lest they are evaluated to NaNs:
+		for (size_t i = result.mNumNodes; i < result.mNumPaddedNodes; ++i) {
+			result.mScratch[(sScratchFrom + 6) * result.mNumPaddedNodes + i] = 1.0f;
+			result.mScratch[(sScratchTo + 6) * result.mNumPaddedNodes + i] = 1.0f;
+		}
+		return result;
+	}
+
+	void compiled_animation::retarget(glm::mat4* aNewBeginningOfTargetStorage)
+	{
+		if (nullptr == mTargetStorageBegin) {
+			return;
+		}
+		for (auto& bone : mBoneOutputs) {
+			bone.mBoneMatrixTarget = aNewBeginningOfTargetStorage + (bone.mBoneMatrixTarget - mTargetStorageBegin);
+		}
+		mTargetStorageBegin = aNewBeginningOfTargetStorage;
+	}
+
+	void compiled_animation::gather_keys(key_stream& aStream, float aTime, const glm::vec4& aDefaultValue, size_t aNumComponents, float* aFrom, float* aTo, float* aFactors)
+	{
+		const auto stride = mNumPaddedNodes;
+		for (size_t i = 0; i < mNumNodes; ++i) {
+			const auto count = aStream.mCounts[i];
+			if (0 == count) {
+				for (size_t c = 0; c < aNumComponents; ++c) {
+					aFrom[c * stride + i] = aTo[c * stride + i] = aDefaultValue[static_cast<glm::length_t>(c)];
+				}
+				aFactors[i] = 0.0f;
+				continue;
+			}
+			const auto offset = aStream.mOffsets[i];
+			const float* times = aStream.mTimes.data() + offset;
+			const auto pos1 = find_position_in_times(times, count, aTime, aStream.mCursors[i]);
+			const auto pos2 = pos1 + (pos1 + 1 < count ? 1 : 0);
+			const float timeDifference = times[pos2] - times[pos1];
+			aFactors[i] = timeDifference > std::numeric_limits<float>::epsilon() ? (aTime - times[pos1]) / timeDifference : 1.0f;
+			for (size_t c = 0; c < aNumComponents; ++c) {
+				aFrom[c * stride + i] = aStream.mValues[c][offset + pos1];
+				aTo[c * stride + i]   = aStream.mValues[c][offset + pos2];
+			}
+		}
+	}
+
+	void compiled_animation::animate(const animation_clip_data& aClip, double aTime)
+	{
+		if (aClip.mTicksPerSecond == 0.0) {
+			throw gvk::runtime_error("mTicksPerSecond may not be 0.0 => set a different value!");
+		}
+		if (aClip.mAnimationIndex != mAnimationIndex) {
+			throw gvk::runtime_error("The animation index of the passed animation_clip_data is not the same that was used to create this animation.");
+		}
+		if (0 == mNumNodes) {
+			return;
+		}
+
+		const auto timeInTicks = static_cast<float>(aTime * aClip.mTicksPerSecond);
+		const auto stride = mNumPaddedNodes;
+		float* from = mScratch.data() + sScratchFrom * stride;
+		float* to = mScratch.data() + sScratchTo * stride;
+		float* factors = mScratch.data() + sScratchFactors * stride;
+		float* local = mScratch.data() + sScratchLocal * stride;
+
+		// 1. Find the keys and interpolation factors for every node (scalar), and store them as SoA:
+		gather_keys(mPositions, timeInTicks, glm::vec4{ 0.0f }, 3, from, to, factors);
+		gather_keys(mRotations, timeInTicks, glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f }, 4, from + 3 * stride, to + 3 * stride, factors + stride);
+		gather_keys(mScalings, timeInTicks, glm::vec4{ 1.0f }, 3, from + 7 * stride, to + 7 * stride, factors + 2 * stride);
+
+		// 2. Interpolate and compose the local matrices for sSimdWidth nodes at once:
+		const simd_float one = simd_set1(1.0f);
+		const simd_float two = simd_set1(2.0f);
+		const simd_float zero = simd_set1(0.0f);
+		const simd_float signBit = simd_set1(-0.0f);
+		for (size_t i = 0; i < mNumPaddedNodes; i += sSimdWidth) {
+			auto lerpComponent = [&](size_t bComponent, simd_float bFactor) {
+				const simd_float a = simd_load(from + bComponent * stride + i);
+				const simd_float b = simd_load(to + bComponent * stride + i);
+				return simd_add(a, simd_mul(simd_sub(b, a), bFactor));
+			};
+
+			const simd_float tf = simd_load(factors + i);
+			const simd_float tx = lerpComponent(0, tf);
+			const simd_float ty = lerpComponent(1, tf);
+			const simd_float tz = lerpComponent(2, tf);
+
+			const simd_float sf = simd_load(factors + 2 * stride + i);
+			const simd_float sx = lerpComponent(7, sf);
+			const simd_float sy = lerpComponent(8, sf);
+			const simd_float sz = lerpComponent(9, sf);
+
+			// nlerp along the shortest path: flip the second quaternion if the dot product is negative
+			const simd_float rf = simd_load(factors + stride + i);
+			simd_float qa[4], qb[4];
+			for (size_t c = 0; c < 4; ++c) {
+				qa[c] = simd_load(from + (3 + c) * stride + i);
+				qb[c] = simd_load(to + (3 + c) * stride + i);
+			}
+			const simd_float dot = simd_add(simd_add(simd_mul(qa[0], qb[0]), simd_mul(qa[1], qb[1])), simd_add(simd_mul(qa[2], qb[2]), simd_mul(qa[3], qb[3])));
+			const simd_float flip = simd_and(simd_less(dot, zero), signBit);
+			simd_float q[4];
+			for (size_t c = 0; c < 4; ++c) {
+				q[c] = simd_add(qa[c], simd_mul(simd_sub(simd_xor(qb[c], flip), qa[c]), rf));
+			}
+			const simd_float lengthSq = simd_add(simd_add(simd_mul(q[0], q[0]), simd_mul(q[1], q[1])), simd_add(simd_mul(q[2], q[2]), simd_mul(q[3], q[3])));
+			const simd_float invLength = simd_div(one, simd_sqrt(lengthSq));
+			const simd_float x = simd_mul(q[0], invLength);
+			const simd_float y = simd_mul(q[1], invLength);
+			const simd_float z = simd_mul(q[2], invLength);
+			const simd_float w = simd_mul(q[3], invLength);
+
+			// Rotation matrix from quaternion (same as glm::mat3_cast), scaled per column, c.f. matrix_from_transforms:
+			const simd_float xx = simd_mul(x, x), yy = simd_mul(y, y), zz = simd_mul(z, z);
+			const simd_float xy = simd_mul(x, y), xz = simd_mul(x, z), yz = simd_mul(y, z);
+			const simd_float wx = simd_mul(w, x), wy = simd_mul(w, y), wz = simd_mul(w, z);
+			simd_store(local +  0 * stride + i, simd_mul(simd_sub(one, simd_mul(two, simd_add(yy, zz))), sx));
+			simd_store(local +  1 * stride + i, simd_mul(simd_mul(two, simd_add(xy, wz)), sx));
+			simd_store(local +  2 * stride + i, simd_mul(simd_mul(two, simd_sub(xz, wy)), sx));
+			simd_store(local +  3 * stride + i, simd_mul(simd_mul(two, simd_sub(xy, wz)), sy));
+			simd_store(local +  4 * stride + i, simd_mul(simd_sub(one, simd_mul(two, simd_add(xx, zz))), sy));
+			simd_store(local +  5 * stride + i, simd_mul(simd_mul(two, simd_add(yz, wx)), sy));
+			simd_store(local +  6 * stride + i, simd_mul(simd_mul(two, simd_add(xz, wy)), sz));
+			simd_store(local +  7 * stride + i, simd_mul(simd_mul(two, simd_sub(yz, wx)), sz));
+			simd_store(local +  8 * stride + i, simd_mul(simd_sub(one, simd_mul(two, simd_add(xx, yy))), sz));
+			simd_store(local +  9 * stride + i, tx);
+			simd_store(local + 10 * stride + i, ty);
+			simd_store(local + 11 * stride + i, tz);
+		}
+
+		// 3. Resolve the hierarchy in topological order, and write out the bone matrices:
+		glm::mat4 localTransform{ 1.0f };
+		glm::mat4 tmp;
+		for (size_t i = 0; i < mNumNodes; ++i) {
+			for (glm::length_t col = 0; col < 4; ++col) {
+				for (glm::length_t row = 0; row < 3; ++row) {
+					localTransform[col][row] = local[(3 * col + row) * stride + i];
+				}
+			}
+			multiply_mat4(mParentTransforms[i], localTransform, tmp);
+			if (mParentIndices[i] >= 0) {
+				multiply_mat4(mGlobalTransforms[static_cast<size_t>(mParentIndices[i])], tmp, mGlobalTransforms[i]);
+			}
+			else {
+				mGlobalTransforms[i] = tmp;
+			}
+		}
+
+		for (const auto& bone : mBoneOutputs) {
+			multiply_mat4(bone.mInverseMeshRootMatrix, mGlobalTransforms[bone.mNodeIndex], tmp);
+			if (bone_matrix_encoding::mat4 == mOutputEncoding) {
+				multiply_mat4(tmp, bone.mInverseBindPoseMatrix, *bone.mBoneMatrixTarget);
+			}
+			else {
+				multiply_mat4(tmp, bone.mInverseBindPoseMatrix, localTransform);
+				write_bone_matrix(localTransform, mOutputEncoding, mTargetStorageBegin, bone.mBoneMatrixTarget);
+			}
+		}
+	}
+}
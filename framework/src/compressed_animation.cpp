@@ -0,0 +1,286 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	static constexpr float sSmallestThreeRange = 0.70710678118f; // 1/sqrt(2), the maximum magnitude of the three smallest components
+	static constexpr uint32_t sSmallestThreeMaxValue = (1u << 15) - 1;
+
+	/**	Encodes a unit quaternion into 48 bits: bits [0, 45) contain the three smallest components
+	 *	with 15 bits each, bits [45, 47) the index of the largest component, which is omitted.
+	 */
+	static std::array<uint16_t, 3> quantize_quat(glm::quat aRotation)
+	{
+		const float components[4] = { aRotation.x, aRotation.y, aRotation.z, aRotation.w };
+		uint32_t largest = 0;
+		for (uint32_t c = 1; c < 4; ++c) {
+			if (std::abs(components[c]) > std::abs(components[largest])) {
+				largest = c;
+			}
+		}
+		// q and -q represent the same rotation => make the omitted component positive:
+		const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+		uint64_t bits = static_cast<uint64_t>(largest) << 45;
+		uint32_t shift = 0;
+		for (uint32_t c = 0; c < 4; ++c) {
+			if (c == largest) {
+				continue;
+			}
+			const float normalized = glm::clamp((components[c] * sign / sSmallestThreeRange) * 0.5f + 0.5f, 0.0f, 1.0f);
+			bits |= static_cast<uint64_t>(normalized * sSmallestThreeMaxValue + 0.5f) << shift;
+			shift += 15;
+		}
+		return { static_cast<uint16_t>(bits), static_cast<uint16_t>(bits >> 16), static_cast<uint16_t>(bits >> 32) };
+	}
+
+	static glm::quat dequantize_quat(const std::array<uint16_t, 3>& aValue)
+	{
+		const uint64_t bits = static_cast<uint64_t>(aValue[0]) | (static_cast<uint64_t>(aValue[1]) << 16) | (static_cast<uint64_t>(aValue[2]) << 32);
+		const auto largest = static_cast<uint32_t>(bits >> 45) & 3u;
+		float components[4];
+		float sumOfSquares = 0.0f;
+		uint32_t shift = 0;
+		for (uint32_t c = 0; c < 4; ++c) {
+			if (c == largest) {
+				continue;
+			}
+			const auto quantized = static_cast<uint32_t>(bits >> shift) & sSmallestThreeMaxValue;
+			components[c] = (static_cast<float>(quantized) / sSmallestThreeMaxValue * 2.0f - 1.0f) * sSmallestThreeRange;
+			sumOfSquares += components[c] * components[c];
+			shift += 15;
+		}
+		components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+		return glm::quat{ components[3], components[0], components[1], components[2] };
+	}
+
+	static std::array<uint16_t, 3> quantize_vec3(const glm::vec3& aValue, const glm::vec3& aMin, const glm::vec3& aExtent)
+	{
+		std::array<uint16_t, 3> result;
+		for (glm::length_t c = 0; c < 3; ++c) {
+			const float normalized = aExtent[c] > 0.0f ? glm::clamp((aValue[c] - aMin[c]) / aExtent[c], 0.0f, 1.0f) : 0.0f;
+			result[c] = static_cast<uint16_t>(normalized * 65535.0f + 0.5f);
+		}
+		return result;
+	}
+
+	static glm::vec3 dequantize_vec3(const std::array<uint16_t, 3>& aValue, const glm::vec3& aMin, const glm::vec3& aExtent)
+	{
+		return aMin + glm::vec3{ aValue[0], aValue[1], aValue[2] } / 65535.0f * aExtent;
+	}
+
+	/** nlerp along the shortest path */
+	static glm::quat nlerp(const glm::quat& aFrom, glm::quat aTo, float aFactor)
+	{
+		if (glm::dot(aFrom, aTo) < 0.0f) {
+			aTo = -aTo;
+		}
+		return glm::normalize(aFrom + (aTo - aFrom) * aFactor);
+	}
+
+	/** Angle between two rotations in radians */
+	static float rotation_error(const glm::quat& aA, const glm::quat& aB)
+	{
+		return 2.0f * std::acos(std::min(1.0f, std::abs(glm::dot(glm::normalize(aA), glm::normalize(aB)))));
+	}
+
+	static float vec3_error(const glm::vec3& aA, const glm::vec3& aB)
+	{
+		return glm::length(aA - aB);
+	}
+
+	/**	Determines the keys which must be kept, s.t. all keys can be reconstructed within aTolerance
+	 *	by interpolating between the kept keys. Keys are removed greedily: starting at a kept key,
+	 *	the segment is extended as long as all keys within it can be reconstructed.
+	 *	@return	Indices of the keys to keep, in ascending order
+	 */
+	template <typename K, typename I, typename E>
+	static std::vector<size_t> reduce_keys(const std::vector<K>& aKeys, I aInterpolate, E aError, float aTolerance)
+	{
+		std::vector<size_t> result;
+		const auto n = aKeys.size();
+		if (0 == n) {
+			return result;
+		}
+		result.push_back(0);
+		size_t anchor = 0;
+		for (size_t end = 2; end < n; ++end) {
+			const double segmentDuration = aKeys[end].mTime - aKeys[anchor].mTime;
+			bool reconstructible = true;
+			for (size_t i = anchor + 1; i < end && reconstructible; ++i) {
+				const auto f = segmentDuration > std::numeric_limits<double>::epsilon() ? static_cast<float>((aKeys[i].mTime - aKeys[anchor].mTime) / segmentDuration) : 1.0f;
+				reconstructible = aError(aInterpolate(aKeys[anchor].mValue, aKeys[end].mValue, f), aKeys[i].mValue) <= aTolerance;
+			}
+			if (!reconstructible) {
+				anchor = end - 1;
+				result.push_back(anchor);
+			}
+		}
+		if (n > 1) {
+			result.push_back(n - 1);
+		}
+
+		// Constant tracks are reduced to one key:
+		const bool constant = std::all_of(std::begin(result), std::end(result), [&](size_t bIndex) {
+			return aError(aKeys[bIndex].mValue, aKeys[0].mValue) <= aTolerance;
+		});
+		if (constant) {
+			result.resize(1);
+		}
+		return result;
+	}
+
+	compressed_animation animation::compress(const animation_compression_config& aConfig) const
+	{
+		compressed_animation result;
+		result.mAnimationIndex = mAnimationIndex;
+		result.mTargetStorageBegin = target_storage_begin();
+		result.mOutputEncoding = mOutputEncoding;
+		result.mTargetStorageSize = target_storage_size();
+		result.mReport = animation_compression_report{ mAnimationIndex, 0, 0, 0, 0 };
+
+		auto lerpVec3 = [](const glm::vec3& bA, const glm::vec3& bB, float bFactor) { return bA + (bB - bA) * bFactor; };
+
+		auto compressVec3 = [&result, &lerpVec3](const auto& bKeys, float bTolerance, std::vector<float>& bTimes, std::vector<compressed_animation::quantized_value>& bValues) {
+			const auto kept = reduce_keys(bKeys, lerpVec3, vec3_error, bTolerance);
+			compressed_animation::track track{ static_cast<uint32_t>(bTimes.size()), static_cast<uint32_t>(kept.size()), 0u, glm::vec3{ 0.0f }, glm::vec3{ 0.0f } };
+			if (!kept.empty()) {
+				glm::vec3 maxValue = bKeys[kept.front()].mValue;
+				track.mMin = maxValue;
+				for (auto k : kept) {
+					track.mMin = glm::min(track.mMin, bKeys[k].mValue);
+					maxValue = glm::max(maxValue, bKeys[k].mValue);
+				}
+				track.mExtent = maxValue - track.mMin;
+			}
+			for (auto k : kept) {
+				bTimes.push_back(static_cast<float>(bKeys[k].mTime));
+				bValues.push_back(quantize_vec3(bKeys[k].mValue, track.mMin, track.mExtent));
+			}
+			result.mReport.mNumKeysBefore += bKeys.size();
+			result.mReport.mNumKeysAfter += kept.size();
+			result.mReport.mBytesBefore += bKeys.size() * sizeof(bKeys.front());
+			return track;
+		};
+
+		for (size_t i = 0; i < mAnimationData.size(); ++i) {
+			const auto& anode = mAnimationData[i];
+			auto& cnode = result.mNodes.emplace_back();
+
+			cnode.mPositions = compressVec3(anode.mPositionKeys, aConfig.mPositionTolerance, result.mPositionTimes, result.mPositionValues);
+			cnode.mScalings = compressVec3(anode.mScalingKeys, aConfig.mScalingTolerance, result.mScalingTimes, result.mScalingValues);
+
+			const auto keptRotations = reduce_keys(anode.mRotationKeys, nlerp, rotation_error, aConfig.mRotationTolerance);
+			cnode.mRotations = compressed_animation::track{ static_cast<uint32_t>(result.mRotationTimes.size()), static_cast<uint32_t>(keptRotations.size()), 0u, glm::vec3{ 0.0f }, glm::vec3{ 0.0f } };
+			for (auto k : keptRotations) {
+				result.mRotationTimes.push_back(static_cast<float>(anode.mRotationKeys[k].mTime));
+				result.mRotationValues.push_back(quantize_quat(glm::normalize(anode.mRotationKeys[k].mValue)));
+			}
+			result.mReport.mNumKeysBefore += anode.mRotationKeys.size();
+			result.mReport.mNumKeysAfter += keptRotations.size();
+			result.mReport.mBytesBefore += anode.mRotationKeys.size() * sizeof(rotation_key);
+
+			if (anode.mAnimatedParentIndex.has_value()) {
+				if (anode.mAnimatedParentIndex.value() >= i) {
+					throw gvk::logic_error(fmt::format("The animated parent of node {} is stored at index {}, but parents must be stored before their children.", i, anode.mAnimatedParentIndex.value()));
+				}
+				cnode.mParentIndex = static_cast<int64_t>(anode.mAnimatedParentIndex.value());
+			}
+			else {
+				cnode.mParentIndex = -1;
+			}
+			cnode.mParentTransform = anode.mParentTransform;
+
+			for (const auto& boneMeshTarget : anode.mBoneMeshTargets) {
+				result.mBoneOutputs.push_back(compressed_animation::bone_output{ i, boneMeshTarget.mInverseMeshRootMatrix, boneMeshTarget.mInverseBindPoseMatrix, boneMeshTarget.mBoneMatrixTarget });
+			}
+		}
+		result.mGlobalTransforms.resize(result.mNodes.size(), glm::mat4{ 1.0f });
+
+		result.mReport.mBytesAfter = result.mReport.mNumKeysAfter * (sizeof(float) + sizeof(compressed_animation::quantized_value))
+			+ result.mNodes.size() * 3 * sizeof(compressed_animation::track);
+
+		LOG_DEBUG(fmt::format("Compressed animation {}: {} -> {} keys, {} -> {} bytes, ratio {:.2f}",
+			mAnimationIndex, result.mReport.mNumKeysBefore, result.mReport.mNumKeysAfter, result.mReport.mBytesBefore, result.mReport.mBytesAfter, result.mReport.compression_ratio()));
+		return result;
+	}
+
+	void compressed_animation::retarget(glm::mat4* aNewBeginningOfTargetStorage)
+	{
+		if (nullptr == mTargetStorageBegin) {
+			return;
+		}
+		for (auto& bone : mBoneOutputs) {
+			bone.mBoneMatrixTarget = aNewBeginningOfTargetStorage + (bone.mBoneMatrixTarget - mTargetStorageBegin);
+		}
+		mTargetStorageBegin = aNewBeginningOfTargetStorage;
+	}
+
+	glm::vec3 compressed_animation::sample_vec3(track& aTrack, const std::vector<float>& aTimes, const std::vector<quantized_value>& aValues, float aTime, const glm::vec3& aDefaultValue)
+	{
+		if (0 == aTrack.mCount) {
+			return aDefaultValue;
+		}
+		const float* times = aTimes.data() + aTrack.mOffset;
+		const auto pos1 = find_position_in_times(times, aTrack.mCount, aTime, aTrack.mCursor);
+		const auto pos2 = pos1 + (pos1 + 1 < aTrack.mCount ? 1 : 0);
+		const auto a = dequantize_vec3(aValues[aTrack.mOffset + pos1], aTrack.mMin, aTrack.mExtent);
+		if (pos1 == pos2) {
+			return a;
+		}
+		const auto b = dequantize_vec3(aValues[aTrack.mOffset + pos2], aTrack.mMin, aTrack.mExtent);
+		const float timeDifference = times[pos2] - times[pos1];
+		const float f = timeDifference > std::numeric_limits<float>::epsilon() ? glm::clamp((aTime - times[pos1]) / timeDifference, 0.0f, 1.0f) : 1.0f;
+		return a + (b - a) * f;
+	}
+
+	glm::quat compressed_animation::sample_quat(track& aTrack, float aTime)
+	{
+		if (0 == aTrack.mCount) {
+			return glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f };
+		}
+		const float* times = mRotationTimes.data() + aTrack.mOffset;
+		const auto pos1 = find_position_in_times(times, aTrack.mCount, aTime, aTrack.mCursor);
+		const auto pos2 = pos1 + (pos1 + 1 < aTrack.mCount ? 1 : 0);
+		const auto a = dequantize_quat(mRotationValues[aTrack.mOffset + pos1]);
+		if (pos1 == pos2) {
+			return a;
+		}
+		const auto b = dequantize_quat(mRotationValues[aTrack.mOffset + pos2]);
+		const float timeDifference = times[pos2] - times[pos1];
+		const float f = timeDifference > std::numeric_limits<float>::epsilon() ? glm::clamp((aTime - times[pos1]) / timeDifference, 0.0f, 1.0f) : 1.0f;
+		return nlerp(a, b, f);
+	}
+
+	void compressed_animation::animate(const animation_clip_data& aClip, double aTime)
+	{
+		if (aClip.mTicksPerSecond == 0.0) {
+			throw gvk::runtime_error("mTicksPerSecond may not be 0.0 => set a different value!");
+		}
+		if (aClip.mAnimationIndex != mAnimationIndex) {
+			throw gvk::runtime_error("The animation index of the passed animation_clip_data is not the same that was used to create this animation.");
+		}
+
+		const auto timeInTicks = static_cast<float>(aTime * aClip.mTicksPerSecond);
+
+		for (size_t i = 0; i < mNodes.size(); ++i) {
+			auto& cnode = mNodes[i];
+			glm::mat4 localTransform{ 1.0f };
+			if (cnode.mPositions.mCount + cnode.mRotations.mCount + cnode.mScalings.mCount > 0) {
+				const auto translation = sample_vec3(cnode.mPositions, mPositionTimes, mPositionValues, timeInTicks, glm::vec3{ 0.0f });
+				const auto rotation = sample_quat(cnode.mRotations, timeInTicks);
+				const auto scaling = sample_vec3(cnode.mScalings, mScalingTimes, mScalingValues, timeInTicks, glm::vec3{ 1.0f });
+				localTransform = matrix_from_transforms(translation, rotation, scaling);
+			}
+
+			if (cnode.mParentIndex >= 0) {
+				mGlobalTransforms[i] = mGlobalTransforms[static_cast<size_t>(cnode.mParentIndex)] * cnode.mParentTransform * localTransform;
+			}
+			else {
+				mGlobalTransforms[i] = cnode.mParentTransform * localTransform;
+			}
+		}
+
+		for (const auto& bone : mBoneOutputs) {
+			write_bone_matrix(bone.mInverseMeshRootMatrix * mGlobalTransforms[bone.mNodeIndex] * bone.mInverseBindPoseMatrix, mOutputEncoding, mTargetStorageBegin, bone.mBoneMatrixTarget);
+		}
+	}
+}
@@ -45,6 +45,9 @@ namespace gvk
 
 		mLogicalDevice.waitIdle();
 
+		// Release all cached textures while the device still exists
+		default_texture_cache().clear();
+
 		//// Destroy all:
 		////  - swap chains,
 		////  - surfaces,
@@ -0,0 +1,221 @@
+#include <gvk.hpp>
+#include "simd_target.hpp"
+
+namespace gvk
+{
+	frustum extract_frustum(const glm::mat4& aProjectionAndViewMatrix)
+	{
+		const auto m = glm::transpose(aProjectionAndViewMatrix); // => m[i] is the i-th row
+		frustum result;
+		result.mPlanes[frustum::left_plane]   = m[3] + m[0];
+		result.mPlanes[frustum::right_plane]  = m[3] - m[0];
+		result.mPlanes[frustum::bottom_plane] = m[3] + m[1];
+		result.mPlanes[frustum::top_plane]    = m[3] - m[1];
+		result.mPlanes[frustum::near_plane]   = m[2];        // 0 <= z
+		result.mPlanes[frustum::far_plane]    = m[3] - m[2]; //      z <= w
+		for (auto& plane : result.mPlanes) {
+			plane /= glm::length(glm::vec3{ plane });
+		}
+		return result;
+	}
+
+	bounding_box compute_bounding_box(const std::vector<glm::vec3>& aPositions)
+	{
+		if (aPositions.empty()) {
+			return bounding_box{ glm::vec3{ 0.0f }, glm::vec3{ 0.0f } };
+		}
+		bounding_box result{ aPositions.front(), aPositions.front() };
+		for (const auto& p : aPositions) {
+			result.mMin = glm::min(result.mMin, p);
+			result.mMax = glm::max(result.mMax, p);
+		}
+		return result;
+	}
+
+	bounding_box transform_bounding_box(const bounding_box& aBox, const glm::mat4& aMatrix)
+	{
+		// Transform center and extent, where the extent is transformed by the absolute values of the matrix (Arvo):
+		const auto center = glm::vec3{ aMatrix * glm::vec4{ (aBox.mMin + aBox.mMax) * 0.5f, 1.0f } };
+		const auto extent = (aBox.mMax - aBox.mMin) * 0.5f;
+		const auto absMat = glm::mat3{ glm::abs(glm::vec3{ aMatrix[0] }), glm::abs(glm::vec3{ aMatrix[1] }), glm::abs(glm::vec3{ aMatrix[2] }) };
+		const auto newExtent = absMat * extent;
+		return bounding_box{ center - newExtent, center + newExtent };
+	}
+
+	bool is_inside_frustum(const frustum& aFrustum, const bounding_box& aBox)
+	{
+		const auto center = (aBox.mMin + aBox.mMax) * 0.5f;
+		const auto extent = (aBox.mMax - aBox.mMin) * 0.5f;
+		for (const auto& plane : aFrustum.mPlanes) {
+			const auto normal = glm::vec3{ plane };
+			// Outside if even the corner which is the farthest along the normal is on the outer side:
+			if (glm::dot(normal, center) + plane.w < -glm::dot(glm::abs(normal), extent)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool is_inside_frustum(const frustum& aFrustum, const bounding_sphere& aSphere)
+	{
+		for (const auto& plane : aFrustum.mPlanes) {
+			if (glm::dot(glm::vec3{ plane }, aSphere.mCenter) + plane.w < -aSphere.mRadius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename B>
+	static void cull_range_scalar(const frustum& aFrustum, const B* aBounds, size_t aBegin, size_t aEnd, std::vector<uint32_t>& aVisibleIndicesOut)
+	{
+		for (size_t i = aBegin; i < aEnd; ++i) {
+			if (is_inside_frustum(aFrustum, aBounds[i])) {
+				aVisibleIndicesOut.push_back(static_cast<uint32_t>(i));
+			}
+		}
+	}
+
+#if defined(GVK_SIMD_X86)
+	/** Appends the indices aBase + k for all bits k which are set in aMask. */
+	static inline void append_visible_indices(int aMask, size_t aBase, std::vector<uint32_t>& aVisibleIndicesOut)
+	{
+		for (int k = 0; aMask != 0; ++k, aMask >>= 1) {
+			if (0 != (aMask & 1)) {
+				aVisibleIndicesOut.push_back(static_cast<uint32_t>(aBase + k));
+			}
+		}
+	}
+
+	GVK_TARGET("avx2,fma")
+	static void cull_range_avx2(const frustum& aFrustum, const bounding_box* aBoxes, size_t aBegin, size_t aEnd, std::vector<uint32_t>& aVisibleIndicesOut)
+	{
+		const __m256 half = _mm256_set1_ps(0.5f);
+		const __m256 zero = _mm256_setzero_ps();
+		size_t i = aBegin;
+		for (; i + 8 <= aEnd; i += 8) {
+			const auto* b = aBoxes + i;
+			const __m256 minX = _mm256_setr_ps(b[0].mMin.x, b[1].mMin.x, b[2].mMin.x, b[3].mMin.x, b[4].mMin.x, b[5].mMin.x, b[6].mMin.x, b[7].mMin.x);
+			const __m256 minY = _mm256_setr_ps(b[0].mMin.y, b[1].mMin.y, b[2].mMin.y, b[3].mMin.y, b[4].mMin.y, b[5].mMin.y, b[6].mMin.y, b[7].mMin.y);
+			const __m256 minZ = _mm256_setr_ps(b[0].mMin.z, b[1].mMin.z, b[2].mMin.z, b[3].mMin.z, b[4].mMin.z, b[5].mMin.z, b[6].mMin.z, b[7].mMin.z);
+			const __m256 maxX = _mm256_setr_ps(b[0].mMax.x, b[1].mMax.x, b[2].mMax.x, b[3].mMax.x, b[4].mMax.x, b[5].mMax.x, b[6].mMax.x, b[7].mMax.x);
+			const __m256 maxY = _mm256_setr_ps(b[0].mMax.y, b[1].mMax.y, b[2].mMax.y, b[3].mMax.y, b[4].mMax.y, b[5].mMax.y, b[6].mMax.y, b[7].mMax.y);
+			const __m256 maxZ = _mm256_setr_ps(b[0].mMax.z, b[1].mMax.z, b[2].mMax.z, b[3].mMax.z, b[4].mMax.z, b[5].mMax.z, b[6].mMax.z, b[7].mMax.z);
+			const __m256 cx = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+			const __m256 cy = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+			const __m256 cz = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+			const __m256 ex = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+			const __m256 ey = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+			const __m256 ez = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+			int mask = 0xFF;
+			for (const auto& plane : aFrustum.mPlanes) {
+				const __m256 d = _mm256_fmadd_ps(_mm256_set1_ps(plane.x), cx, _mm256_fmadd_ps(_mm256_set1_ps(plane.y), cy, _mm256_fmadd_ps(_mm256_set1_ps(plane.z), cz, _mm256_set1_ps(plane.w))));
+				const __m256 r = _mm256_fmadd_ps(_mm256_set1_ps(std::abs(plane.x)), ex, _mm256_fmadd_ps(_mm256_set1_ps(std::abs(plane.y)), ey, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.z)), ez)));
+				mask &= _mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_GE_OQ));
+				if (0 == mask) {
+					break;
+				}
+			}
+			append_visible_indices(mask, i, aVisibleIndicesOut);
+		}
+		cull_range_scalar(aFrustum, aBoxes, i, aEnd, aVisibleIndicesOut);
+	}
+
+	static_assert(sizeof(bounding_sphere) == 4 * sizeof(float), "Unexpected bounding_sphere layout");
+
+	GVK_TARGET("avx2,fma")
+	static void cull_range_avx2(const frustum& aFrustum, const bounding_sphere* aSpheres, size_t aBegin, size_t aEnd, std::vector<uint32_t>& aVisibleIndicesOut)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		size_t i = aBegin;
+		for (; i + 8 <= aEnd; i += 8) {
+			// bounding_sphere has the same layout as a vec4 => load and transpose two groups of four:
+			const float* s = &aSpheres[i].mCenter.x;
+			__m128 l0 = _mm_loadu_ps(s),      l1 = _mm_loadu_ps(s + 4),  l2 = _mm_loadu_ps(s + 8),  l3 = _mm_loadu_ps(s + 12);
+			__m128 h0 = _mm_loadu_ps(s + 16), h1 = _mm_loadu_ps(s + 20), h2 = _mm_loadu_ps(s + 24), h3 = _mm_loadu_ps(s + 28);
+			_MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+			_MM_TRANSPOSE4_PS(h0, h1, h2, h3);
+			const __m256 cx = _mm256_insertf128_ps(_mm256_castps128_ps256(l0), h0, 1);
+			const __m256 cy = _mm256_insertf128_ps(_mm256_castps128_ps256(l1), h1, 1);
+			const __m256 cz = _mm256_insertf128_ps(_mm256_castps128_ps256(l2), h2, 1);
+			const __m256 radius = _mm256_insertf128_ps(_mm256_castps128_ps256(l3), h3, 1);
+
+			int mask = 0xFF;
+			for (const auto& plane : aFrustum.mPlanes) {
+				const __m256 d = _mm256_fmadd_ps(_mm256_set1_ps(plane.x), cx, _mm256_fmadd_ps(_mm256_set1_ps(plane.y), cy, _mm256_fmadd_ps(_mm256_set1_ps(plane.z), cz, _mm256_set1_ps(plane.w))));
+				mask &= _mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(d, radius), zero, _CMP_GE_OQ));
+				if (0 == mask) {
+					break;
+				}
+			}
+			append_visible_indices(mask, i, aVisibleIndicesOut);
+		}
+		cull_range_scalar(aFrustum, aSpheres, i, aEnd, aVisibleIndicesOut);
+	}
+#endif
+
+	template <typename B>
+	static void cull_range(const frustum& aFrustum, const B* aBounds, size_t aBegin, size_t aEnd, std::vector<uint32_t>& aVisibleIndicesOut)
+	{
+#if defined(GVK_SIMD_X86)
+		if (simd_instruction_set::avx2 == active_simd_instruction_set()) {
+			cull_range_avx2(aFrustum, aBounds, aBegin, aEnd, aVisibleIndicesOut);
+			return;
+		}
+#endif
+		cull_range_scalar(aFrustum, aBounds, aBegin, aEnd, aVisibleIndicesOut);
+	}
+
+	template <typename B>
+	static void cull_parallel(thread_pool& aThreadPool, const frustum& aFrustum, const B* aBounds, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut, size_t aBoundsPerTask)
+	{
+		aVisibleIndicesOut.clear();
+		aBoundsPerTask = std::max(aBoundsPerTask, size_t{ 8 });
+		if (aCount <= aBoundsPerTask) {
+			cull_range(aFrustum, aBounds, 0, aCount, aVisibleIndicesOut);
+			return;
+		}
+
+		// Every chunk gets its own list, which are concatenated in order afterwards:
+		const size_t numChunks = (aCount + aBoundsPerTask - 1) / aBoundsPerTask;
+		std::vector<std::vector<uint32_t>> chunkResults(numChunks);
+		aThreadPool.parallel_for(0, numChunks, [&](size_t bChunk) {
+			const size_t begin = bChunk * aBoundsPerTask;
+			auto& result = chunkResults[bChunk];
+			result.reserve(aBoundsPerTask);
+			cull_range(aFrustum, aBounds, begin, std::min(begin + aBoundsPerTask, aCount), result);
+		});
+
+		size_t total = 0;
+		for (const auto& result : chunkResults) {
+			total += result.size();
+		}
+		aVisibleIndicesOut.reserve(total);
+		for (const auto& result : chunkResults) {
+			aVisibleIndicesOut.insert(aVisibleIndicesOut.end(), result.begin(), result.end());
+		}
+	}
+
+	void cull_bounding_boxes(const frustum& aFrustum, const bounding_box* aBoxes, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut)
+	{
+		aVisibleIndicesOut.clear();
+		cull_range(aFrustum, aBoxes, 0, aCount, aVisibleIndicesOut);
+	}
+
+	void cull_bounding_boxes(thread_pool& aThreadPool, const frustum& aFrustum, const bounding_box* aBoxes, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut, size_t aBoxesPerTask)
+	{
+		cull_parallel(aThreadPool, aFrustum, aBoxes, aCount, aVisibleIndicesOut, aBoxesPerTask);
+	}
+
+	void cull_bounding_spheres(const frustum& aFrustum, const bounding_sphere* aSpheres, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut)
+	{
+		aVisibleIndicesOut.clear();
+		cull_range(aFrustum, aSpheres, 0, aCount, aVisibleIndicesOut);
+	}
+
+	void cull_bounding_spheres(thread_pool& aThreadPool, const frustum& aFrustum, const bounding_sphere* aSpheres, size_t aCount, std::vector<uint32_t>& aVisibleIndicesOut, size_t aSpheresPerTask)
+	{
+		cull_parallel(aThreadPool, aFrustum, aSpheres, aCount, aVisibleIndicesOut, aSpheresPerTask);
+	}
+}
@@ -0,0 +1,189 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	gpu_animation gpu_animation::create(const compiled_animation& aAnimation, uint32_t aMaxNumInstances, const std::string& aShaderPath, avk::sync aSyncHandler)
+	{
+		if (0 == aAnimation.mNumNodes) {
+			throw gvk::runtime_error("Can not create a gpu_animation for an animation without any nodes.");
+		}
+		if (0 == aMaxNumInstances) {
+			throw gvk::runtime_error("aMaxNumInstances must be greater than 0.");
+		}
+
+		const auto numNodes = aAnimation.mNumNodes;
+
+		// Sort the nodes by their depth in the hierarchy, s.t. the compute shader can process one level after the other:
+		std::vector<uint32_t> depths(numNodes, 0u);
+		for (size_t i = 0; i < numNodes; ++i) {
+			if (aAnimation.mParentIndices[i] >= 0) {
+				depths[i] = depths[static_cast<size_t>(aAnimation.mParentIndices[i])] + 1;
+			}
+		}
+		std::vector<size_t> order(numNodes);
+		std::iota(std::begin(order), std::end(order), size_t{ 0 });
+		std::stable_sort(std::begin(order), std::end(order), [&depths](size_t a, size_t b) { return depths[a] < depths[b]; });
+		std::vector<int32_t> newIndices(numNodes);
+		for (size_t i = 0; i < numNodes; ++i) {
+			newIndices[order[i]] = static_cast<int32_t>(i);
+		}
+
+		std::vector<uint32_t> levels;
+		for (size_t i = 0; i < numNodes; ++i) {
+			while (levels.size() <= depths[order[i]]) {
+				levels.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		levels.push_back(static_cast<uint32_t>(numNodes));
+
+		// Gather nodes and keys in the new order:
+		std::vector<gpu_animation_node_data> nodes;
+		std::vector<float> keyTimes;
+		std::vector<glm::vec4> keyValues;
+		nodes.reserve(numNodes);
+		auto appendKeys = [&keyTimes, &keyValues](const compiled_animation::key_stream& bStream, size_t bNodeIndex, size_t bNumComponents) {
+			const auto offset = bStream.mOffsets[bNodeIndex];
+			const auto count = bStream.mCounts[bNodeIndex];
+			const auto result = std::make_tuple(static_cast<uint32_t>(keyTimes.size()), count);
+			for (uint32_t k = offset; k < offset + count; ++k) {
+				keyTimes.push_back(bStream.mTimes[k]);
+				glm::vec4 value{ 0.0f };
+				for (size_t c = 0; c < bNumComponents; ++c) {
+					value[static_cast<glm::length_t>(c)] = bStream.mValues[c][k];
+				}
+				keyValues.push_back(value);
+			}
+			return result;
+		};
+		for (size_t i = 0; i < numNodes; ++i) {
+			const auto oldIndex = order[i];
+			auto& node = nodes.emplace_back();
+			node.mParentTransform = aAnimation.mParentTransforms[oldIndex];
+			node.mParentIndex = aAnimation.mParentIndices[oldIndex] >= 0 ? newIndices[static_cast<size_t>(aAnimation.mParentIndices[oldIndex])] : -1;
+			std::tie(node.mPositionKeysOffset, node.mPositionKeysCount) = appendKeys(aAnimation.mPositions, oldIndex, 3);
+			std::tie(node.mRotationKeysOffset, node.mRotationKeysCount) = appendKeys(aAnimation.mRotations, oldIndex, 4);
+			std::tie(node.mScalingKeysOffset, node.mScalingKeysCount) = appendKeys(aAnimation.mScalings, oldIndex, 3);
+			node.mPadding = 0u;
+		}
+		if (keyTimes.empty()) {
+			// Buffers must not be empty:
+			keyTimes.push_back(0.0f);
+			keyValues.emplace_back(0.0f);
+		}
+
+		std::vector<gpu_animation_bone_data> bones;
+		bones.reserve(aAnimation.mBoneOutputs.size());
+		for (const auto& bone : aAnimation.mBoneOutputs) {
+			bones.push_back(gpu_animation_bone_data{
+				bone.mInverseMeshRootMatrix,
+				bone.mInverseBindPoseMatrix,
+				static_cast<uint32_t>(newIndices[bone.mNodeIndex]),
+				static_cast<uint32_t>(bone.mBoneMatrixTarget - aAnimation.mTargetStorageBegin),
+				0u, 0u
+			});
+		}
+		if (bones.empty()) {
+			throw gvk::runtime_error("Can not create a gpu_animation for an animation which does not write any bone matrices.");
+		}
+
+		gpu_animation result;
+		result.mAnimationIndex = aAnimation.mAnimationIndex;
+		result.mNumNodes = static_cast<uint32_t>(numNodes);
+		result.mNumLevels = static_cast<uint32_t>(levels.size() - 1);
+		result.mNumBones = static_cast<uint32_t>(bones.size());
+		result.mBoneMatricesPerInstance = static_cast<uint32_t>(aAnimation.mTargetStorageSize);
+		result.mMaxNumInstances = aMaxNumInstances;
+		result.mOutputEncoding = aAnimation.output_encoding();
+		result.mInstances.resize(aMaxNumInstances, gpu_animation_instance_data{ 0.0f, 0u, 0u, 0u });
+
+		result.mNodesBuffer = context().create_buffer(avk::memory_usage::device, {}, avk::storage_buffer_meta::create_from_data(nodes));
+		result.mNodesBuffer->fill(nodes.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+		result.mKeyTimesBuffer = context().create_buffer(avk::memory_usage::device, {}, avk::storage_buffer_meta::create_from_data(keyTimes));
+		result.mKeyTimesBuffer->fill(keyTimes.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+		result.mKeyValuesBuffer = context().create_buffer(avk::memory_usage::device, {}, avk::storage_buffer_meta::create_from_data(keyValues));
+		result.mKeyValuesBuffer->fill(keyValues.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+		result.mLevelsBuffer = context().create_buffer(avk::memory_usage::device, {}, avk::storage_buffer_meta::create_from_data(levels));
+		result.mLevelsBuffer->fill(levels.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+		result.mBonesBuffer = context().create_buffer(avk::memory_usage::device, {}, avk::storage_buffer_meta::create_from_data(bones));
+		result.mBonesBuffer->fill(bones.data(), 0, std::move(aSyncHandler));
+
+		// Per frame in flight, s.t. the dispatches of different frames in flight do not use the same memory:
+		const auto numFramesInFlight = context().main_window()->number_of_frames_in_flight();
+		for (decltype(numFramesInFlight) i = 0; i < numFramesInFlight; ++i) {
+			result.mInstanceBuffers.push_back(context().create_buffer(
+				avk::memory_usage::host_coherent, {},
+				avk::storage_buffer_meta::create_from_data(result.mInstances)
+			));
+			// Scratch memory for the global transforms of all nodes of all instances:
+			result.mGlobalTransformsBuffers.push_back(context().create_buffer(
+				avk::memory_usage::device, {},
+				avk::storage_buffer_meta::create_from_size(sizeof(glm::mat4) * numNodes * aMaxNumInstances)
+			));
+		}
+
+		result.mPipeline = context().create_compute_pipeline_for(
+			aShaderPath,
+			avk::push_constant_binding_data{ avk::shader_type::compute, 0, sizeof(push_constants) },
+			avk::descriptor_binding(0, 0, result.mNodesBuffer),
+			avk::descriptor_binding(0, 1, result.mKeyTimesBuffer),
+			avk::descriptor_binding(0, 2, result.mKeyValuesBuffer),
+			avk::descriptor_binding(0, 3, result.mLevelsBuffer),
+			avk::descriptor_binding(0, 4, result.mBonesBuffer),
+			avk::descriptor_binding(0, 5, result.mInstanceBuffers[0]),
+			avk::descriptor_binding(0, 6, result.mGlobalTransformsBuffers[0]),
+			avk::descriptor_binding(0, 7, result.mGlobalTransformsBuffers[0]) // Just take any storage buffer, this is just to define the layout
+		);
+		result.mDescriptorCache = context().create_descriptor_cache();
+
+		return result;
+	}
+
+	void gpu_animation::set_instance(uint32_t aInstanceIndex, const animation_clip_data& aClip, double aTime, uint32_t aBoneMatrixOffset)
+	{
+		if (aClip.mTicksPerSecond == 0.0) {
+			throw gvk::runtime_error("mTicksPerSecond may not be 0.0 => set a different value!");
+		}
+		if (aClip.mAnimationIndex != mAnimationIndex) {
+			throw gvk::runtime_error("The animation index of the passed animation_clip_data is not the same that was used to create this animation.");
+		}
+		auto& inst = mInstances[aInstanceIndex];
+		inst.mTimeInTicks = static_cast<float>(aTime * aClip.mTicksPerSecond);
+		inst.mBoneMatrixOffset = aBoneMatrixOffset;
+	}
+
+	void gpu_animation::record_animate(avk::command_buffer_t& aCommandBuffer, const avk::buffer& aBoneMatricesBuffer, uint32_t aNumInstances)
+	{
+		if (aNumInstances > mMaxNumInstances) {
+			throw gvk::runtime_error(fmt::format("Can not evaluate {} instances with a gpu_animation that has been created for at most {} instances.", aNumInstances, mMaxNumInstances));
+		}
+		if (0 == aNumInstances) {
+			return;
+		}
+
+		const auto inFlightIndex = context().main_window()->in_flight_index_for_frame();
+		auto& instanceBuffer = mInstanceBuffers[inFlightIndex];
+		instanceBuffer->fill(mInstances.data(), 0, avk::sync::not_required());
+
+		aCommandBuffer.bind_pipeline(mPipeline);
+		aCommandBuffer.bind_descriptors(mPipeline->layout(), mDescriptorCache.get_or_create_descriptor_sets({
+			avk::descriptor_binding(0, 0, mNodesBuffer),
+			avk::descriptor_binding(0, 1, mKeyTimesBuffer),
+			avk::descriptor_binding(0, 2, mKeyValuesBuffer),
+			avk::descriptor_binding(0, 3, mLevelsBuffer),
+			avk::descriptor_binding(0, 4, mBonesBuffer),
+			avk::descriptor_binding(0, 5, instanceBuffer),
+			avk::descriptor_binding(0, 6, mGlobalTransformsBuffers[inFlightIndex]),
+			avk::descriptor_binding(0, 7, aBoneMatricesBuffer)
+		}));
+		const auto pushConstants = push_constants{ mNumNodes, mNumLevels, mNumBones, aNumInstances, static_cast<uint32_t>(mOutputEncoding) };
+		aCommandBuffer.handle().pushConstants(mPipeline->layout_handle(), vk::ShaderStageFlagBits::eCompute, 0, sizeof(pushConstants), &pushConstants);
+
+		// One workgroup per instance:
+		aCommandBuffer.handle().dispatch(aNumInstances, 1u, 1u);
+
+		aCommandBuffer.establish_global_memory_barrier(
+			avk::pipeline_stage::compute_shader,                          avk::pipeline_stage::vertex_shader,
+			avk::memory_access::shader_buffers_and_images_write_access,   avk::memory_access::shader_buffers_and_images_read_access
+		);
+	}
+}
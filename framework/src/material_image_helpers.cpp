@@ -3,14 +3,9 @@
 namespace gvk
 {
 
-	std::tuple<std::vector<material_gpu_data>, std::vector<avk::image_sampler>> convert_for_gpu_usage(
-		const std::vector<gvk::material_config>& aMaterialConfigs, 
-		bool aLoadTexturesInSrgb,
-		bool aFlipTextures,
-		avk::image_usage aImageUsage,
-		avk::filter_mode aTextureFilterMode, 
-		avk::border_handling_mode aBorderHandlingMode,
-		avk::sync aSyncHandler)
+	std::tuple<std::vector<material_gpu_data>, std::vector<material_texture_info>> get_material_gpu_data_and_textures(
+		const std::vector<gvk::material_config>& aMaterialConfigs,
+		bool aLoadTexturesInSrgb)
 	{
 		// These are the texture names loaded from file -> mapped to vector of usage-pointers
 		std::unordered_map<std::string, std::vector<int*>> texNamesToUsages;
@@ -174,69 +169,128 @@ namespace gvk
 			gm.mExtraTexOffsetTiling		= mc.mExtraTexOffsetTiling		 ;
 		}
 
-		std::vector<avk::image_sampler> imageSamplers;
-		const auto numSamplers = texNamesToUsages.size() + (whiteTexUsages.empty() ? 0 : 1) + (straightUpNormalTexUsages.empty() ? 0 : 1);
-		imageSamplers.reserve(numSamplers);
+		std::vector<material_texture_info> textures;
+		textures.reserve(texNamesToUsages.size() + (whiteTexUsages.empty() ? 0 : 1) + (straightUpNormalTexUsages.empty() ? 0 : 1));
 
-		auto getSync = [numSamplers, &aSyncHandler, lSyncCount = size_t{0}] () mutable -> avk::sync {
-			++lSyncCount;
-			if (lSyncCount < numSamplers) {
-				return avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}); // Invoke external sync exactly once (if there is something to sync)
-			}
-			assert (lSyncCount == numSamplers);
-			return std::move(aSyncHandler); // For the last image, pass the main sync => this will also have the after-handler invoked.
-		};
-
-		// Create the white texture and assign its index to all usages
+		// A 1x1 px white texture for all usages of missing textures
 		if (!whiteTexUsages.empty()) {
-			imageSamplers.push_back(
-				context().create_image_sampler(
-					context().create_image_view(
-						create_1px_texture({ 255, 255, 255, 255 }, vk::Format::eR8G8B8A8Unorm, avk::memory_usage::device, aImageUsage, getSync())
-					),
-					context().create_sampler(avk::filter_mode::nearest_neighbor, avk::border_handling_mode::repeat)
-				)
-			);
-			int index = static_cast<int>(imageSamplers.size() - 1);
+			textures.push_back(material_texture_info{ material_texture_info::texture_type::white_1px, {}, false });
+			int index = static_cast<int>(textures.size() - 1);
 			for (auto* img : whiteTexUsages) {
 				*img = index;
 			}
 		}
 
-		// Create the normal texture, containing a normal pointing straight up, and assign to all usages
+		// A 1x1 px texture, containing a normal pointing straight up, for all usages of missing normal maps
 		if (!straightUpNormalTexUsages.empty()) {
-			imageSamplers.push_back(
-				context().create_image_sampler(
-					context().create_image_view(
-						create_1px_texture({ 127, 127, 255, 0 }, vk::Format::eR8G8B8A8Unorm, avk::memory_usage::device, aImageUsage, getSync())
-					),
-					context().create_sampler(avk::filter_mode::nearest_neighbor, avk::border_handling_mode::repeat)
-				)
-			);
-			int index = static_cast<int>(imageSamplers.size() - 1);
+			textures.push_back(material_texture_info{ material_texture_info::texture_type::straight_up_normal_1px, {}, false });
+			int index = static_cast<int>(textures.size() - 1);
 			for (auto* img : straightUpNormalTexUsages) {
 				*img = index;
 			}
 		}
 
-		// Load all the images from file, and assign them to all usages
+		// All the images from file
 		for (auto& pair : texNamesToUsages) {
 			assert (!pair.first.empty());
+			textures.push_back(material_texture_info{ material_texture_info::texture_type::from_file, pair.first, srgbTextures.contains(pair.first) });
+			int index = static_cast<int>(textures.size() - 1);
+			for (auto* img : pair.second) {
+				*img = index;
+			}
+		}
 
-			bool potentiallySrgb = srgbTextures.contains(pair.first);
-			
+		return std::make_tuple(std::move(gpuMaterial), std::move(textures));
+	}
+
+	std::tuple<std::vector<material_gpu_data>, std::vector<avk::image_sampler>> convert_for_gpu_usage(
+		const std::vector<gvk::material_config>& aMaterialConfigs, 
+		bool aLoadTexturesInSrgb,
+		bool aFlipTextures,
+		avk::image_usage aImageUsage,
+		avk::filter_mode aTextureFilterMode, 
+		avk::border_handling_mode aBorderHandlingMode,
+		avk::sync aSyncHandler,
+		texture_cache* aTextureCache)
+	{
+		auto [gpuMaterial, textures] = get_material_gpu_data_and_textures(aMaterialConfigs, aLoadTexturesInSrgb);
+
+		const auto numSamplers = textures.size();
+		std::vector<std::optional<avk::image_view>> imageViews(numSamplers);
+
+		// Textures which are in the cache already are neither loaded nor uploaded again:
+		auto cacheKey = [&textures, aFlipTextures, aImageUsage](size_t bIndex) {
+			return texture_cache_key{ textures[bIndex].mPath, vk::Format::eUndefined, textures[bIndex].mSrgb, aFlipTextures, aImageUsage };
+		};
+		std::vector<size_t> texturesToLoad;
+		texturesToLoad.reserve(numSamplers);
+		for (size_t i = 0; i < numSamplers; ++i) {
+			if (nullptr != aTextureCache && material_texture_info::texture_type::from_file == textures[i].mType) {
+				imageViews[i] = aTextureCache->try_acquire(cacheKey(i));
+			}
+			if (!imageViews[i].has_value()) {
+				texturesToLoad.push_back(i);
+			}
+		}
+		const auto numToLoad = texturesToLoad.size();
+
+		// Decoding takes most of the time and is done concurrently, in batches of as many textures as there are
+		// threads in order to limit the memory which is occupied by decoded images. Every decoded image is copied
+		// into the staging arena of one upload batch right away, which uploads all of them with one submission.
+		texture_upload_batch uploadBatch;
+		auto& threadPool = default_thread_pool();
+		const size_t batchSize = static_cast<size_t>(threadPool.number_of_workers()) + 1;
+		std::vector<std::optional<decoded_image>> decodedImages(batchSize);
+		for (size_t batchBegin = 0; batchBegin < numToLoad; batchBegin += batchSize) {
+			const auto batchEnd = std::min(batchBegin + batchSize, numToLoad);
+			threadPool.parallel_for(batchBegin, batchEnd, [&textures, &texturesToLoad, &decodedImages, batchBegin, aFlipTextures](size_t bIndex) {
+				const auto& tex = textures[texturesToLoad[bIndex]];
+				if (material_texture_info::texture_type::from_file == tex.mType) {
+					decodedImages[bIndex - batchBegin] = decode_image_file(tex.mPath, true, tex.mSrgb, aFlipTextures, 4);
+				}
+			});
+
+			// Add the textures in the order of their indices:
+			for (size_t i = batchBegin; i < batchEnd; ++i) {
+				switch (textures[texturesToLoad[i]].mType) {
+				case material_texture_info::texture_type::white_1px:
+					uploadBatch.add_1px_texture({ 255, 255, 255, 255 }, vk::Format::eR8G8B8A8Unorm, aImageUsage);
+					break;
+				case material_texture_info::texture_type::straight_up_normal_1px:
+					uploadBatch.add_1px_texture({ 127, 127, 255, 0 }, vk::Format::eR8G8B8A8Unorm, aImageUsage);
+					break;
+				case material_texture_info::texture_type::from_file:
+					uploadBatch.add_decoded_image(decodedImages[i - batchBegin].value(), aImageUsage);
+					decodedImages[i - batchBegin].reset();
+					break;
+				}
+			}
+		}
+
+		// Submit even if all textures have been in the cache, s.t. the sync handler is consumed in any case,
+		// i.e. its barriers are established, and its fence or semaphore is signalled by the (empty) submission:
+		auto images = uploadBatch.submit(std::move(aSyncHandler));
+		for (size_t i = 0; i < numToLoad; ++i) {
+			const auto texIndex = texturesToLoad[i];
+			auto imageView = context().create_image_view(std::move(images[i]));
+			if (nullptr != aTextureCache && material_texture_info::texture_type::from_file == textures[texIndex].mType) {
+				imageView = aTextureCache->insert(cacheKey(texIndex), std::move(imageView));
+			}
+			imageViews[texIndex] = std::move(imageView);
+		}
+
+		std::vector<avk::image_sampler> imageSamplers;
+		imageSamplers.reserve(numSamplers);
+		for (size_t i = 0; i < numSamplers; ++i) {
+			const bool isReplacement = material_texture_info::texture_type::from_file != textures[i].mType;
 			imageSamplers.push_back(
 				context().create_image_sampler(
-					context().create_image_view(
-						create_image_from_file(pair.first, true, potentiallySrgb, aFlipTextures, 4, avk::memory_usage::device, aImageUsage, getSync())
-					),
-					context().create_sampler(aTextureFilterMode, aBorderHandlingMode)
+					std::move(imageViews[i].value()),
+					isReplacement
+						? context().create_sampler(avk::filter_mode::nearest_neighbor, avk::border_handling_mode::repeat)
+						: context().create_sampler(aTextureFilterMode, aBorderHandlingMode)
 				)
 			);
-			int index = static_cast<int>(imageSamplers.size() - 1);
-			for (auto* img : pair.second) {
-				*img = index;
-			}
 		}
 
 		// Hand over ownership to the caller
@@ -30,6 +30,45 @@ namespace gvk
 		return result;
 	}
 
+	size_t model_t::weld_identical_vertices()
+	{
+		// The meshes are modified in place, their memory remains owned by mImporter:
+		auto* scene = const_cast<aiScene*>(mScene);
+		std::vector<uint32_t> removedPerMesh(scene->mNumMeshes, 0u);
+		default_thread_pool().parallel_for(0, scene->mNumMeshes, [scene, &removedPerMesh](size_t bMeshIndex) {
+			removedPerMesh[bMeshIndex] = gvk::weld_identical_vertices(scene->mMeshes[bMeshIndex]);
+		});
+		size_t totalRemoved = 0;
+		for (size_t i = 0; i < removedPerMesh.size(); ++i) {
+			totalRemoved += removedPerMesh[i];
+			// Previously generated tangents do not match the welded vertices anymore:
+			if (removedPerMesh[i] > 0 && i < mGeneratedTangentsPerMesh.size()) {
+				mGeneratedTangentsPerMesh[i].clear();
+			}
+		}
+		return totalRemoved;
+	}
+
+	size_t model_t::generate_tangents(bool aOverwriteExisting, int aTexCoordSet)
+	{
+		const auto numMeshes = static_cast<size_t>(mScene->mNumMeshes);
+		mGeneratedTangentsPerMesh.resize(numMeshes);
+		std::atomic<size_t> numGenerated = 0;
+		default_thread_pool().parallel_for(0, numMeshes, [this, aOverwriteExisting, aTexCoordSet, &numGenerated](size_t bMeshIndex) {
+			const aiMesh* paiMesh = mScene->mMeshes[bMeshIndex];
+			if (!aOverwriteExisting && (nullptr != paiMesh->mTangents || !mGeneratedTangentsPerMesh[bMeshIndex].empty())) {
+				return;
+			}
+			auto tangents = generate_tangents_with_handedness(paiMesh, aTexCoordSet);
+			if (tangents.empty()) {
+				LOG_WARNING(fmt::format("Can not generate tangents for the mesh at index {}, because it lacks normals or texture coordinates of set {}.", bMeshIndex, aTexCoordSet));
+				return;
+			}
+			mGeneratedTangentsPerMesh[bMeshIndex] = std::move(tangents);
+			++numGenerated;
+		});
+		return numGenerated.load();
+	}
 	
 	void model_t::initialize_materials()
 	{
@@ -340,7 +379,13 @@ namespace gvk
 		auto n = paiMesh->mNumVertices;
 		std::vector<glm::vec3> result;
 		result.reserve(n);
-		if (nullptr == paiMesh->mTangents) {
+		if (aMeshIndex < mGeneratedTangentsPerMesh.size() && !mGeneratedTangentsPerMesh[aMeshIndex].empty()) {
+			// Prefer the tangents generated via generate_tangents:
+			for (const auto& t : mGeneratedTangentsPerMesh[aMeshIndex]) {
+				result.emplace_back(t);
+			}
+		}
+		else if (nullptr == paiMesh->mTangents) {
 			LOG_WARNING(fmt::format("The mesh at index {} does not contain tangents. Will return (1,0,0) tangents for each vertex.", aMeshIndex));
 			for (decltype(n) i = 0; i < n; ++i) {
 				result.emplace_back(1.f, 0.f, 0.f);
@@ -361,7 +406,15 @@ namespace gvk
 		auto n = paiMesh->mNumVertices;
 		std::vector<glm::vec3> result;
 		result.reserve(n);
-		if (nullptr == paiMesh->mBitangents) {
+		if (aMeshIndex < mGeneratedTangentsPerMesh.size() && !mGeneratedTangentsPerMesh[aMeshIndex].empty()) {
+			// Derive the bitangents from the tangents generated via generate_tangents:
+			const auto& tangents = mGeneratedTangentsPerMesh[aMeshIndex];
+			for (decltype(n) i = 0; i < n; ++i) {
+				const glm::vec3 normal{ paiMesh->mNormals[i][0], paiMesh->mNormals[i][1], paiMesh->mNormals[i][2] };
+				result.emplace_back(tangents[i].w * glm::cross(normal, glm::vec3{ tangents[i] }));
+			}
+		}
+		else if (nullptr == paiMesh->mBitangents) {
 			LOG_WARNING(fmt::format("The mesh at index {} does not contain bitangents. Will return (0,1,0) bitangents for each vertex.", aMeshIndex));
 			for (decltype(n) i = 0; i < n; ++i) {
 				result.emplace_back(0.f, 1.f, 0.f);
@@ -376,6 +429,37 @@ namespace gvk
 		return result;
 	}
 
+	std::vector<glm::vec4> model_t::tangents_and_handedness_for_mesh(mesh_index_t aMeshIndex) const
+	{
+		if (aMeshIndex < mGeneratedTangentsPerMesh.size() && !mGeneratedTangentsPerMesh[aMeshIndex].empty()) {
+			return mGeneratedTangentsPerMesh[aMeshIndex];
+		}
+		const aiMesh* paiMesh = mScene->mMeshes[aMeshIndex];
+		auto n = paiMesh->mNumVertices;
+		std::vector<glm::vec4> result;
+		result.reserve(n);
+		if (nullptr == paiMesh->mTangents) {
+			LOG_WARNING(fmt::format("The mesh at index {} does not contain tangents. Will return (1,0,0,1) tangents for each vertex.", aMeshIndex));
+			for (decltype(n) i = 0; i < n; ++i) {
+				result.emplace_back(1.f, 0.f, 0.f, 1.f);
+			}
+		}
+		else {
+			// We've got tangents. Derive the handedness from the bitangents, if there are any.
+			for (decltype(n) i = 0; i < n; ++i) {
+				const glm::vec3 tangent{ paiMesh->mTangents[i][0], paiMesh->mTangents[i][1], paiMesh->mTangents[i][2] };
+				float handedness = 1.f;
+				if (nullptr != paiMesh->mNormals && nullptr != paiMesh->mBitangents) {
+					const glm::vec3 normal{ paiMesh->mNormals[i][0], paiMesh->mNormals[i][1], paiMesh->mNormals[i][2] };
+					const glm::vec3 bitangent{ paiMesh->mBitangents[i][0], paiMesh->mBitangents[i][1], paiMesh->mBitangents[i][2] };
+					handedness = glm::dot(glm::cross(normal, tangent), bitangent) < 0.f ? -1.f : 1.f;
+				}
+				result.emplace_back(tangent, handedness);
+			}
+		}
+		return result;
+	}
+
 	std::vector<glm::vec4> model_t::colors_for_mesh(mesh_index_t aMeshIndex, int aSet) const
 	{
 		const aiMesh* paiMesh = mScene->mMeshes[aMeshIndex];
@@ -556,6 +640,16 @@ namespace gvk
 		return result;
 	}
 
+	std::vector<glm::vec4> model_t::tangents_and_handedness_for_meshes(std::vector<mesh_index_t> aMeshIndices) const
+	{
+		std::vector<glm::vec4> result;
+		for (auto meshIndex : aMeshIndices) {
+			auto tmp = tangents_and_handedness_for_mesh(meshIndex);
+			std::move(std::begin(tmp), std::end(tmp), std::back_inserter(result));
+		}
+		return result;
+	}
+
 	std::vector<glm::vec4> model_t::colors_for_meshes(std::vector<mesh_index_t> aMeshIndices, int aSet) const
 	{
 		std::vector<glm::vec4> result;
@@ -0,0 +1,357 @@
+#include <gvk.hpp>
+#include "simd_target.hpp"
+
+namespace gvk
+{
+	std::vector<occluder_mesh> select_occluders(const model_t& aModel, float aMinRelativeSize, size_t aMaxTriangles)
+	{
+		std::vector<occluder_mesh> candidates;
+		bounding_box modelBounds{ glm::vec3{ std::numeric_limits<float>::max() }, glm::vec3{ std::numeric_limits<float>::lowest() } };
+		const auto numMeshes = aModel.num_meshes();
+		for (mesh_index_t meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
+			occluder_mesh mesh;
+			mesh.mPositions = aModel.positions_for_mesh(meshIndex);
+			if (mesh.mPositions.empty()) {
+				continue;
+			}
+			mesh.mBounds = compute_bounding_box(mesh.mPositions);
+			modelBounds.mMin = glm::min(modelBounds.mMin, mesh.mBounds.mMin);
+			modelBounds.mMax = glm::max(modelBounds.mMax, mesh.mBounds.mMax);
+			if (static_cast<size_t>(aModel.number_of_indices_for_mesh(meshIndex)) / 3 > aMaxTriangles) {
+				continue;
+			}
+			mesh.mIndices = aModel.indices_for_mesh<uint32_t>(meshIndex);
+			candidates.push_back(std::move(mesh));
+		}
+
+		const float minDiagonal = aMinRelativeSize * glm::length(modelBounds.mMax - modelBounds.mMin);
+		std::vector<occluder_mesh> result;
+		for (auto& mesh : candidates) {
+			if (glm::length(mesh.mBounds.mMax - mesh.mBounds.mMin) >= minDiagonal) {
+				result.push_back(std::move(mesh));
+			}
+		}
+		LOG_DEBUG(fmt::format("Selected {} of {} meshes as occluders.", result.size(), numMeshes));
+		return result;
+	}
+
+	occlusion_culler::occlusion_culler(uint32_t aWidth, uint32_t aHeight)
+		: mWidth{ std::max(sTileWidth, (aWidth + sTileWidth - 1) / sTileWidth * sTileWidth) }
+		, mHeight{ std::max(sTileHeight, (aHeight + sTileHeight - 1) / sTileHeight * sTileHeight) }
+		, mProjectionAndViewMatrix{ 1.0f }
+		, mDepth(static_cast<size_t>(mWidth) * mHeight, 1.0f)
+		, mTileMaxDepth(static_cast<size_t>(mWidth / sTileWidth) * (mHeight / sTileHeight), 1.0f)
+	{
+	}
+
+	void occlusion_culler::begin_frame(const glm::mat4& aProjectionAndViewMatrix)
+	{
+		mProjectionAndViewMatrix = aProjectionAndViewMatrix;
+		mTriangles.clear();
+		std::fill(mDepth.begin(), mDepth.end(), 1.0f);
+		std::fill(mTileMaxDepth.begin(), mTileMaxDepth.end(), 1.0f);
+	}
+
+	void occlusion_culler::add_occluder(const glm::vec3* aPositions, const uint32_t* aIndices, size_t aNumIndices, const glm::mat4& aModelMatrix)
+	{
+		const auto mvp = mProjectionAndViewMatrix * aModelMatrix;
+		for (size_t i = 0; i + 2 < aNumIndices; i += 3) {
+			const std::array<glm::vec4, 3> clip = {
+				mvp * glm::vec4{ aPositions[aIndices[i]], 1.0f },
+				mvp * glm::vec4{ aPositions[aIndices[i + 1]], 1.0f },
+				mvp * glm::vec4{ aPositions[aIndices[i + 2]], 1.0f }
+			};
+
+			// Trivially reject triangles which are completely outside of one of the clip planes:
+			auto allOutside = [&clip](auto bIsOutside) {
+				return bIsOutside(clip[0]) && bIsOutside(clip[1]) && bIsOutside(clip[2]);
+			};
+			if (allOutside([](const glm::vec4& v) { return v.x >  v.w; }) || allOutside([](const glm::vec4& v) { return v.x < -v.w; })
+			 || allOutside([](const glm::vec4& v) { return v.y >  v.w; }) || allOutside([](const glm::vec4& v) { return v.y < -v.w; })
+			 || allOutside([](const glm::vec4& v) { return v.z >  v.w; }) || allOutside([](const glm::vec4& v) { return v.z < 0.0f; })) {
+				continue;
+			}
+
+			if (clip[0].z >= 0.0f && clip[1].z >= 0.0f && clip[2].z >= 0.0f) {
+				add_screen_triangle(clip[0], clip[1], clip[2]);
+				continue;
+			}
+
+			// Clip against the near plane (z >= 0), which results in a triangle or a quad:
+			std::array<glm::vec4, 4> polygon;
+			size_t numVertices = 0;
+			for (size_t a = 0; a < 3; ++a) {
+				const auto& va = clip[a];
+				const auto& vb = clip[(a + 1) % 3];
+				if (va.z >= 0.0f) {
+					polygon[numVertices++] = va;
+				}
+				if ((va.z >= 0.0f) != (vb.z >= 0.0f)) {
+					polygon[numVertices++] = glm::mix(va, vb, va.z / (va.z - vb.z));
+				}
+			}
+			for (size_t v = 2; v < numVertices; ++v) {
+				add_screen_triangle(polygon[0], polygon[v - 1], polygon[v]);
+			}
+		}
+	}
+
+	void occlusion_culler::add_screen_triangle(const glm::vec4& aClip0, const glm::vec4& aClip1, const glm::vec4& aClip2)
+	{
+		if (aClip0.w <= 0.0f || aClip1.w <= 0.0f || aClip2.w <= 0.0f) {
+			return;
+		}
+		const auto w = static_cast<float>(mWidth);
+		const auto h = static_cast<float>(mHeight);
+		auto toScreen = [w, h](const glm::vec4& bClip) {
+			const auto ndc = glm::vec3{ bClip } / bClip.w;
+			return glm::vec3{ (ndc.x * 0.5f + 0.5f) * w, (ndc.y * 0.5f + 0.5f) * h, ndc.z };
+		};
+		std::array<glm::vec3, 3> v = { toScreen(aClip0), toScreen(aClip1), toScreen(aClip2) };
+
+		float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[1].y - v[0].y) * (v[2].x - v[0].x);
+		if (std::abs(area) < 1e-6f) {
+			return;
+		}
+		if (area < 0.0f) {
+			std::swap(v[1], v[2]);
+			area = -area;
+		}
+
+		raster_triangle tri;
+		tri.mMinX = std::min({ v[0].x, v[1].x, v[2].x });
+		tri.mMaxX = std::max({ v[0].x, v[1].x, v[2].x });
+		tri.mMinY = std::min({ v[0].y, v[1].y, v[2].y });
+		tri.mMaxY = std::max({ v[0].y, v[1].y, v[2].y });
+		if (tri.mMaxX < 0.0f || tri.mMinX > w || tri.mMaxY < 0.0f || tri.mMinY > h) {
+			return;
+		}
+
+		// Edge i is opposite of vertex i, s.t. edge i divided by the area is the barycentric coordinate of vertex i:
+		tri.mDepthA = tri.mDepthB = tri.mDepthC = 0.0f;
+		for (size_t i = 0; i < 3; ++i) {
+			const auto& a = v[(i + 1) % 3];
+			const auto& b = v[(i + 2) % 3];
+			tri.mEdgeA[i] = a.y - b.y;
+			tri.mEdgeB[i] = b.x - a.x;
+			// Use the same end of the edge in both triangles which share it, s.t. their edge functions are exact negations
+			// of each other, and no pixel center on the shared edge is missed by both of them due to rounding:
+			const auto& anchor = (a.y < b.y || (a.y == b.y && a.x < b.x)) ? a : b;
+			tri.mEdgeC[i] = -(tri.mEdgeA[i] * anchor.x + tri.mEdgeB[i] * anchor.y);
+			tri.mDepthA += tri.mEdgeA[i] * v[i].z / area;
+			tri.mDepthB += tri.mEdgeB[i] * v[i].z / area;
+			tri.mDepthC += tri.mEdgeC[i] * v[i].z / area;
+		}
+		mTriangles.push_back(tri);
+	}
+
+	/** Rasterizes one triangle into the rows [aRowBegin, aRowEnd) and [aColBegin, aColEnd) of the depth buffer. */
+	template <typename T>
+	static void rasterize_triangle_scalar(const T& aTri, float* aDepth, uint32_t aWidth, uint32_t aRowBegin, uint32_t aRowEnd, uint32_t aColBegin, uint32_t aColEnd)
+	{
+		for (uint32_t y = aRowBegin; y < aRowEnd; ++y) {
+			const float fy = static_cast<float>(y) + 0.5f;
+			float* row = aDepth + static_cast<size_t>(y) * aWidth;
+			for (uint32_t x = aColBegin; x < aColEnd; ++x) {
+				const float fx = static_cast<float>(x) + 0.5f;
+				if (aTri.mEdgeA[0] * fx + aTri.mEdgeB[0] * fy + aTri.mEdgeC[0] >= 0.0f
+				 && aTri.mEdgeA[1] * fx + aTri.mEdgeB[1] * fy + aTri.mEdgeC[1] >= 0.0f
+				 && aTri.mEdgeA[2] * fx + aTri.mEdgeB[2] * fy + aTri.mEdgeC[2] >= 0.0f) {
+					row[x] = std::min(row[x], aTri.mDepthA * fx + aTri.mDepthB * fy + aTri.mDepthC);
+				}
+			}
+		}
+	}
+
+#if defined(GVK_SIMD_X86)
+	/** Same as rasterize_triangle_scalar, but processes 8 pixels at a time. aColBegin must be a multiple of 8. */
+	template <typename T>
+	GVK_TARGET("avx2,fma")
+	static void rasterize_triangle_avx2(const T& aTri, float* aDepth, uint32_t aWidth, uint32_t aRowBegin, uint32_t aRowEnd, uint32_t aColBegin, uint32_t aColEnd)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 offsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+		const __m256 a0 = _mm256_set1_ps(aTri.mEdgeA[0]), a1 = _mm256_set1_ps(aTri.mEdgeA[1]), a2 = _mm256_set1_ps(aTri.mEdgeA[2]);
+		const __m256 depthA = _mm256_set1_ps(aTri.mDepthA);
+		for (uint32_t y = aRowBegin; y < aRowEnd; ++y) {
+			const float fy = static_cast<float>(y) + 0.5f;
+			const __m256 r0 = _mm256_set1_ps(aTri.mEdgeB[0] * fy + aTri.mEdgeC[0]);
+			const __m256 r1 = _mm256_set1_ps(aTri.mEdgeB[1] * fy + aTri.mEdgeC[1]);
+			const __m256 r2 = _mm256_set1_ps(aTri.mEdgeB[2] * fy + aTri.mEdgeC[2]);
+			const __m256 rowDepth = _mm256_set1_ps(aTri.mDepthB * fy + aTri.mDepthC);
+			float* row = aDepth + static_cast<size_t>(y) * aWidth;
+			for (uint32_t x = aColBegin; x < aColEnd; x += 8) {
+				const __m256 fx = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), offsets);
+				const __m256 inside = _mm256_and_ps(
+					_mm256_and_ps(
+						_mm256_cmp_ps(_mm256_fmadd_ps(a0, fx, r0), zero, _CMP_GE_OQ),
+						_mm256_cmp_ps(_mm256_fmadd_ps(a1, fx, r1), zero, _CMP_GE_OQ)),
+					_mm256_cmp_ps(_mm256_fmadd_ps(a2, fx, r2), zero, _CMP_GE_OQ));
+				if (0 == _mm256_movemask_ps(inside)) {
+					continue;
+				}
+				const __m256 depth = _mm256_loadu_ps(row + x);
+				const __m256 triDepth = _mm256_fmadd_ps(depthA, fx, rowDepth);
+				_mm256_storeu_ps(row + x, _mm256_blendv_ps(depth, _mm256_min_ps(depth, triDepth), inside));
+			}
+		}
+	}
+#endif
+
+	void occlusion_culler::rasterize_rows(uint32_t aRowBegin, uint32_t aRowEnd)
+	{
+#if defined(GVK_SIMD_X86)
+		const bool useAvx2 = simd_instruction_set::avx2 == active_simd_instruction_set();
+#endif
+		for (const auto& tri : mTriangles) {
+			// Only pixel centers within the triangle's bounds can be covered:
+			const float rowBeginF = std::max(static_cast<float>(aRowBegin), std::ceil(tri.mMinY - 0.5f));
+			const float rowEndF   = std::min(static_cast<float>(aRowEnd),   std::floor(tri.mMaxY - 0.5f) + 1.0f);
+			const float colBeginF = std::max(0.0f,                          std::ceil(tri.mMinX - 0.5f));
+			const float colEndF   = std::min(static_cast<float>(mWidth),    std::floor(tri.mMaxX - 0.5f) + 1.0f);
+			if (rowBeginF >= rowEndF || colBeginF >= colEndF) {
+				continue;
+			}
+			const auto rowBegin = static_cast<uint32_t>(rowBeginF);
+			const auto rowEnd   = static_cast<uint32_t>(rowEndF);
+			const auto colBegin = static_cast<uint32_t>(colBeginF);
+			const auto colEnd   = static_cast<uint32_t>(colEndF);
+#if defined(GVK_SIMD_X86)
+			if (useAvx2) {
+				// The width is a multiple of 8 => the 8-pixel blocks never cross the end of a row:
+				rasterize_triangle_avx2(tri, mDepth.data(), mWidth, rowBegin, rowEnd, colBegin / 8 * 8, colEnd);
+				continue;
+			}
+#endif
+			rasterize_triangle_scalar(tri, mDepth.data(), mWidth, rowBegin, rowEnd, colBegin, colEnd);
+		}
+	}
+
+	void occlusion_culler::update_tile_depths(uint32_t aRowBegin, uint32_t aRowEnd)
+	{
+		const uint32_t numTilesX = mWidth / sTileWidth;
+		for (uint32_t ty = aRowBegin / sTileHeight; ty < aRowEnd / sTileHeight; ++ty) {
+			for (uint32_t tx = 0; tx < numTilesX; ++tx) {
+				float maxDepth = 0.0f;
+				for (uint32_t y = ty * sTileHeight; y < (ty + 1) * sTileHeight; ++y) {
+					const float* row = mDepth.data() + static_cast<size_t>(y) * mWidth + tx * sTileWidth;
+					for (uint32_t x = 0; x < sTileWidth; ++x) {
+						maxDepth = std::max(maxDepth, row[x]);
+					}
+				}
+				mTileMaxDepth[static_cast<size_t>(ty) * numTilesX + tx] = maxDepth;
+			}
+		}
+	}
+
+	void occlusion_culler::rasterize()
+	{
+		rasterize_rows(0u, mHeight);
+		update_tile_depths(0u, mHeight);
+	}
+
+	void occlusion_culler::rasterize(thread_pool& aThreadPool)
+	{
+		// Split into horizontal bands of whole tiles, a few per thread, which can be processed without synchronization:
+		const uint32_t numTileRows = mHeight / sTileHeight;
+		const uint32_t numBands = std::min(numTileRows, (aThreadPool.number_of_workers() + 1) * 2);
+		if (numBands <= 1 || mTriangles.empty()) {
+			rasterize();
+			return;
+		}
+		aThreadPool.parallel_for(0, numBands, [this, numTileRows, numBands](size_t bBand) {
+			const auto rowBegin = static_cast<uint32_t>(bBand * numTileRows / numBands) * sTileHeight;
+			const auto rowEnd = static_cast<uint32_t>((bBand + 1) * numTileRows / numBands) * sTileHeight;
+			rasterize_rows(rowBegin, rowEnd);
+			update_tile_depths(rowBegin, rowEnd);
+		});
+	}
+
+	bool occlusion_culler::is_visible(const bounding_box& aBox) const
+	{
+		glm::vec2 screenMin{ std::numeric_limits<float>::max() };
+		glm::vec2 screenMax{ std::numeric_limits<float>::lowest() };
+		float minDepth = std::numeric_limits<float>::max();
+		for (int i = 0; i < 8; ++i) {
+			const glm::vec3 corner{ (i & 1) ? aBox.mMax.x : aBox.mMin.x, (i & 2) ? aBox.mMax.y : aBox.mMin.y, (i & 4) ? aBox.mMax.z : aBox.mMin.z };
+			const auto clip = mProjectionAndViewMatrix * glm::vec4{ corner, 1.0f };
+			if (clip.w <= 0.0f || clip.z < 0.0f) {
+				return true; // Intersects the near plane => can not be tested
+			}
+			const auto ndc = glm::vec3{ clip } / clip.w;
+			screenMin = glm::min(screenMin, glm::vec2{ ndc });
+			screenMax = glm::max(screenMax, glm::vec2{ ndc });
+			minDepth = std::min(minDepth, ndc.z);
+		}
+		if (minDepth > 1.0f) {
+			return false; // Beyond the far plane
+		}
+
+		const auto w = static_cast<float>(mWidth);
+		const auto h = static_cast<float>(mHeight);
+		screenMin = (screenMin * 0.5f + 0.5f) * glm::vec2{ w, h };
+		screenMax = (screenMax * 0.5f + 0.5f) * glm::vec2{ w, h };
+		if (screenMax.x < 0.0f || screenMin.x > w || screenMax.y < 0.0f || screenMin.y > h) {
+			return false; // Off screen
+		}
+		const auto x0 = static_cast<uint32_t>(glm::clamp(screenMin.x, 0.0f, w - 1.0f));
+		const auto x1 = static_cast<uint32_t>(glm::clamp(screenMax.x, 0.0f, w - 1.0f));
+		const auto y0 = static_cast<uint32_t>(glm::clamp(screenMin.y, 0.0f, h - 1.0f));
+		const auto y1 = static_cast<uint32_t>(glm::clamp(screenMax.y, 0.0f, h - 1.0f));
+
+		// Visible if any covered pixel is farther away than the box' closest point. Check the tiles' farthest depths first:
+		const uint32_t numTilesX = mWidth / sTileWidth;
+		for (uint32_t ty = y0 / sTileHeight; ty <= y1 / sTileHeight; ++ty) {
+			for (uint32_t tx = x0 / sTileWidth; tx <= x1 / sTileWidth; ++tx) {
+				if (mTileMaxDepth[static_cast<size_t>(ty) * numTilesX + tx] < minDepth) {
+					continue; // The whole tile is closer
+				}
+				const uint32_t px0 = std::max(x0, tx * sTileWidth), px1 = std::min(x1, (tx + 1) * sTileWidth - 1);
+				const uint32_t py0 = std::max(y0, ty * sTileHeight), py1 = std::min(y1, (ty + 1) * sTileHeight - 1);
+				for (uint32_t y = py0; y <= py1; ++y) {
+					const float* row = mDepth.data() + static_cast<size_t>(y) * mWidth;
+					for (uint32_t x = px0; x <= px1; ++x) {
+						if (row[x] >= minDepth) {
+							return true;
+						}
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	void occlusion_culler::remove_occluded(const bounding_box* aBoxes, std::vector<uint32_t>& aIndicesInOut) const
+	{
+		aIndicesInOut.erase(std::remove_if(std::begin(aIndicesInOut), std::end(aIndicesInOut), [this, aBoxes](uint32_t bIndex) {
+			return !is_visible(aBoxes[bIndex]);
+		}), std::end(aIndicesInOut));
+	}
+
+	void occlusion_culler::remove_occluded(thread_pool& aThreadPool, const bounding_box* aBoxes, std::vector<uint32_t>& aIndicesInOut, size_t aBoxesPerTask) const
+	{
+		const size_t count = aIndicesInOut.size();
+		aBoxesPerTask = std::max(aBoxesPerTask, size_t{ 1 });
+		if (count <= aBoxesPerTask) {
+			remove_occluded(aBoxes, aIndicesInOut);
+			return;
+		}
+
+		std::vector<uint8_t> visible(count);
+		const size_t numChunks = (count + aBoxesPerTask - 1) / aBoxesPerTask;
+		aThreadPool.parallel_for(0, numChunks, [&](size_t bChunk) {
+			const size_t end = std::min((bChunk + 1) * aBoxesPerTask, count);
+			for (size_t i = bChunk * aBoxesPerTask; i < end; ++i) {
+				visible[i] = is_visible(aBoxes[aIndicesInOut[i]]) ? 1 : 0;
+			}
+		});
+
+		size_t numVisible = 0;
+		for (size_t i = 0; i < count; ++i) {
+			if (0 != visible[i]) {
+				aIndicesInOut[numVisible++] = aIndicesInOut[i];
+			}
+		}
+		aIndicesInOut.resize(numVisible);
+	}
+}
@@ -0,0 +1,123 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	std::vector<glm::mat4> instance_transforms(const model_data& aModelData)
+	{
+		std::vector<glm::mat4> result;
+		result.reserve(aModelData.mInstances.size());
+		for (const auto& instance : aModelData.mInstances) {
+			result.push_back(matrix_from_transforms(instance.mTranslation, glm::quat(instance.mRotation), instance.mScaling));
+		}
+		return result;
+	}
+
+	std::vector<orca_mesh_instance> get_orca_mesh_instances(const orca_scene_t& aScene)
+	{
+		std::vector<orca_mesh_instance> result;
+		const auto& models = aScene.models();
+		for (size_t m = 0; m < models.size(); ++m) {
+			const auto& modelData = models[m];
+			if (modelData.mInstances.empty()) {
+				continue;
+			}
+			const auto numMeshes = modelData.mLoadedModel->num_meshes();
+			std::vector<bounding_box> meshBounds;
+			meshBounds.reserve(numMeshes);
+			for (mesh_index_t mesh = 0; mesh < numMeshes; ++mesh) {
+				meshBounds.push_back(compute_bounding_box(modelData.mLoadedModel->positions_for_mesh(mesh)));
+			}
+			for (size_t i = 0; i < modelData.mInstances.size(); ++i) {
+				for (mesh_index_t mesh = 0; mesh < numMeshes; ++mesh) {
+					result.push_back(orca_mesh_instance{ static_cast<model_index_t>(m), i, mesh, meshBounds[mesh] });
+				}
+			}
+		}
+		return result;
+	}
+
+	std::vector<bounding_box> get_world_space_bounds(const orca_scene_t& aScene, const std::vector<orca_mesh_instance>& aMeshInstances)
+	{
+		std::vector<bounding_box> result;
+		result.reserve(aMeshInstances.size());
+		const auto& models = aScene.models();
+		// The meshes of each instance are stored consecutively => compute each model matrix only once:
+		std::optional<std::tuple<model_index_t, size_t>> currentInstance;
+		glm::mat4 modelMatrix{ 1.0f };
+		for (const auto& meshInstance : aMeshInstances) {
+			const auto instanceKey = std::make_tuple(meshInstance.mModelIndex, meshInstance.mInstanceIndex);
+			if (!currentInstance.has_value() || currentInstance.value() != instanceKey) {
+				const auto& instance = models[meshInstance.mModelIndex].mInstances[meshInstance.mInstanceIndex];
+				modelMatrix = matrix_from_transforms(instance.mTranslation, glm::quat(instance.mRotation), instance.mScaling);
+				currentInstance = instanceKey;
+			}
+			result.push_back(transform_bounding_box(meshInstance.mMeshBounds, modelMatrix));
+		}
+		return result;
+	}
+
+	orca_instanced_draws create_orca_instanced_draws(orca_scene_t& aScene, avk::sync aSyncHandler)
+	{
+		orca_instanced_draws result;
+
+		// The instances of each model are stored consecutively:
+		const auto& models = aScene.models();
+		std::vector<uint32_t> firstInstanceOfModel(models.size());
+		for (size_t m = 0; m < models.size(); ++m) {
+			firstInstanceOfModel[m] = static_cast<uint32_t>(result.mInstanceTransforms.size());
+			insert_into(result.mInstanceTransforms, instance_transforms(models[m]));
+		}
+		if (result.mInstanceTransforms.empty()) {
+			throw gvk::runtime_error("Can not create instanced draws for an ORCA scene without any model instances.");
+		}
+
+		for (const auto& pair : aScene.distinct_material_configs_for_all_models()) {
+			result.mMaterialConfigs.push_back(pair.first);
+			const auto materialIndex = static_cast<uint32_t>(result.mMaterialConfigs.size() - 1);
+
+			for (const auto& indices : pair.second) {
+				const auto& modelData = models[indices.mModelIndex];
+				if (modelData.mInstances.empty()) {
+					continue;
+				}
+				auto selection = make_models_and_meshes_selection(modelData.mLoadedModel, indices.mMeshIndices);
+
+				auto& draw = result.mDraws.emplace_back();
+				draw.mModelIndex = indices.mModelIndex;
+				draw.mMeshIndices = indices.mMeshIndices;
+				draw.mMaterialIndex = materialIndex;
+				draw.mFirstInstance = firstInstanceOfModel[indices.mModelIndex];
+				draw.mInstanceCount = static_cast<uint32_t>(modelData.mInstances.size());
+				draw.mIndexCount = 0;
+				for (auto meshIndex : indices.mMeshIndices) {
+					draw.mIndexCount += static_cast<uint32_t>(modelData.mLoadedModel->number_of_indices_for_mesh(meshIndex));
+				}
+				std::tie(draw.mPositionsBuffer, draw.mIndexBuffer) = create_vertex_and_index_buffers(selection, {}, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+				draw.mTexCoordsBuffer = create_2d_texture_coordinates_flipped_buffer(selection, 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+				draw.mNormalsBuffer = create_normals_buffer(selection, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+			}
+		}
+
+		result.mInstanceTransformsBuffer = context().create_buffer(
+			avk::memory_usage::device, vk::BufferUsageFlagBits::eVertexBuffer,
+			avk::storage_buffer_meta::create_from_data(result.mInstanceTransforms)
+		);
+		result.mInstanceTransformsBuffer->fill(result.mInstanceTransforms.data(), 0, std::move(aSyncHandler));
+
+		LOG_DEBUG(fmt::format("Created {} instanced draw calls for {} model instances.", result.mDraws.size(), result.mInstanceTransforms.size()));
+		return result;
+	}
+
+	void draw_orca_instanced(avk::command_buffer_t& aCommandBuffer, const orca_instanced_draw& aDraw)
+	{
+		const std::array<vk::Buffer, 3> vertexBuffers = {
+			aDraw.mPositionsBuffer->buffer_handle(),
+			aDraw.mTexCoordsBuffer->buffer_handle(),
+			aDraw.mNormalsBuffer->buffer_handle()
+		};
+		const std::array<vk::DeviceSize, 3> offsets = { 0, 0, 0 };
+		aCommandBuffer.handle().bindVertexBuffers(0u, static_cast<uint32_t>(vertexBuffers.size()), vertexBuffers.data(), offsets.data());
+		aCommandBuffer.handle().bindIndexBuffer(aDraw.mIndexBuffer->buffer_handle(), 0u, vk::IndexType::eUint32);
+		aCommandBuffer.handle().drawIndexed(aDraw.mIndexCount, aDraw.mInstanceCount, 0u, 0, aDraw.mFirstInstance);
+	}
+}
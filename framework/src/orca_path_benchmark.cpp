@@ -0,0 +1,282 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	const path_data& find_path(const orca_scene_t& aScene, std::string_view aPathName)
+	{
+		const auto& paths = aScene.paths();
+		const auto it = std::find_if(std::begin(paths), std::end(paths), [&aPathName](const path_data& bPath) { return bPath.mName == aPathName; });
+		if (std::end(paths) == it) {
+			throw gvk::runtime_error(fmt::format("There is no path named '{}' in the ORCA scene.", aPathName));
+		}
+		return *it;
+	}
+
+	float path_duration(const path_data& aPath)
+	{
+		if (aPath.mFrames.empty()) {
+			return 0.0f;
+		}
+		return aPath.mFrames.back().mTime - aPath.mFrames.front().mTime;
+	}
+
+	frame_data sample_path(const path_data& aPath, float aTime)
+	{
+		const auto& frames = aPath.mFrames;
+		if (frames.empty()) {
+			throw gvk::runtime_error(fmt::format("Can not sample the path '{}' which has no frames.", aPath.mName));
+		}
+		const auto startTime = frames.front().mTime;
+		const auto duration = path_duration(aPath);
+		if (aPath.mLoop && duration > 0.0f) {
+			aTime = startTime + glm::mod(aTime - startTime, duration);
+		}
+		if (aTime <= startTime) {
+			return frames.front();
+		}
+		if (aTime >= frames.back().mTime) {
+			return frames.back();
+		}
+
+		// The first frame after aTime, and the one before it:
+		const auto next = std::upper_bound(std::begin(frames), std::end(frames), aTime, [](float bTime, const frame_data& bFrame) { return bTime < bFrame.mTime; });
+		const auto& a = *(next - 1);
+		const auto& b = *next;
+		const auto t = (aTime - a.mTime) / std::max(b.mTime - a.mTime, std::numeric_limits<float>::epsilon());
+		frame_data result;
+		result.mTime = aTime;
+		result.mPosition = glm::mix(a.mPosition, b.mPosition, t);
+		result.mTarget = glm::mix(a.mTarget, b.mTarget, t);
+		result.mUp = glm::normalize(glm::mix(a.mUp, b.mUp, t));
+		return result;
+	}
+
+	void apply_path_frame(camera& aCamera, const frame_data& aFrame)
+	{
+		// The inverse of the view matrix is the camera's transformation, whose -z axis points towards the target:
+		aCamera.set_translation(aFrame.mPosition);
+		aCamera.set_rotation(glm::quat_cast(glm::inverse(glm::lookAt(aFrame.mPosition, aFrame.mTarget, aFrame.mUp))));
+	}
+
+	path_benchmark_statistics compute_benchmark_statistics(std::vector<double> aValues)
+	{
+		path_benchmark_statistics result{};
+		if (aValues.empty()) {
+			return result;
+		}
+		std::sort(std::begin(aValues), std::end(aValues));
+		auto percentile = [&aValues](double bFraction) {
+			const auto rank = bFraction * static_cast<double>(aValues.size() - 1);
+			const auto lower = static_cast<size_t>(rank);
+			const auto upper = std::min(lower + 1, aValues.size() - 1);
+			return glm::mix(aValues[lower], aValues[upper], rank - static_cast<double>(lower));
+		};
+		result.mMin = aValues.front();
+		result.mMax = aValues.back();
+		result.mMean = std::accumulate(std::begin(aValues), std::end(aValues), 0.0) / static_cast<double>(aValues.size());
+		result.mP50 = percentile(0.50);
+		result.mP90 = percentile(0.90);
+		result.mP95 = percentile(0.95);
+		result.mP99 = percentile(0.99);
+		return result;
+	}
+
+	orca_path_benchmark::orca_path_benchmark(camera& aCamera, path_data aPath, std::string aReportPath, float aTimeStep, uint32_t aNumWarmupFrames, bool aStopWhenFinished, const avk::queue* aQueue)
+		: invokee("orca_path_benchmark")
+		, mCamera{ &aCamera }
+		, mPath{ std::move(aPath) }
+		, mReportPath{ std::move(aReportPath) }
+		, mTimeStep{ aTimeStep }
+		, mNumWarmupFrames{ aNumWarmupFrames }
+		, mStopWhenFinished{ aStopWhenFinished }
+		, mQueue{ aQueue }
+	{
+		if (mPath.mFrames.empty()) {
+			throw gvk::runtime_error(fmt::format("Can not benchmark the path '{}' which has no frames.", mPath.mName));
+		}
+		if (mTimeStep <= 0.0f) {
+			throw gvk::runtime_error(fmt::format("The time step of a path benchmark must be positive, but is {}.", mTimeStep));
+		}
+		mNumMeasuredFrames = static_cast<uint32_t>(path_duration(mPath) / mTimeStep) + 1;
+		mFrames.reserve(mNumMeasuredFrames);
+	}
+
+	void orca_path_benchmark::initialize()
+	{
+		const auto queueFamilyIndex = nullptr != mQueue ? mQueue->family_index() : context().mQueues.front().family_index();
+		const auto validBits = context().physical_device().getQueueFamilyProperties()[queueFamilyIndex].timestampValidBits;
+		const auto limits = context().physical_device().getProperties().limits;
+		if (0u == validBits) {
+			// Even if timestampComputeAndGraphics is set, queue families which do not support graphics or compute have no timestamps:
+			LOG_WARNING(fmt::format("The queue family {} does not support timestamps (timestampComputeAndGraphics: {}). GPU times will not be measured.", queueFamilyIndex, VK_TRUE == limits.timestampComputeAndGraphics));
+		}
+		else {
+			mTimestampMask = validBits >= 64u ? ~uint64_t{ 0 } : (uint64_t{ 1 } << validBits) - 1u;
+			mTimestampPeriod = static_cast<double>(limits.timestampPeriod);
+			if (VK_TRUE != limits.timestampComputeAndGraphics) {
+				LOG_DEBUG(fmt::format("Timestamps are not supported on all graphics and compute queues, but on queue family {}, which is used for the benchmark.", queueFamilyIndex));
+			}
+
+			const auto numQueryPairs = static_cast<uint32_t>(context().main_window()->number_of_in_flight_frames());
+			mTimestampQueries = context().device().createQueryPoolUnique(vk::QueryPoolCreateInfo{}
+				.setQueryType(vk::QueryType::eTimestamp)
+				.setQueryCount(2 * numQueryPairs)
+			);
+			mFrameOfQueryPair.assign(numQueryPairs, {});
+		}
+		LOG_INFO(fmt::format("Benchmarking path '{}': {} warmup frames, then {} frames with a time step of {} s.", mPath.mName, mNumWarmupFrames, mNumMeasuredFrames, mTimeStep));
+	}
+
+	std::optional<size_t> orca_path_benchmark::current_measured_frame() const
+	{
+		// mFrameCounter has been incremented by update() already:
+		if (mFrameCounter <= mNumWarmupFrames) {
+			return {};
+		}
+		return static_cast<size_t>(mFrameCounter - mNumWarmupFrames - 1);
+	}
+
+	void orca_path_benchmark::update()
+	{
+		if (mFinished) {
+			return;
+		}
+
+		// The current frame starts now, i.e. the previous one has ended:
+		const auto now = std::chrono::steady_clock::now();
+		if (const auto previous = current_measured_frame(); previous.has_value()) {
+			auto& frame = mFrames[previous.value()];
+			frame.mCpuFrameTimeMs = std::chrono::duration<double, std::milli>(now - mFrameStart.value()).count();
+			frame.mDrawCalls = mCurrentDrawCalls;
+		}
+		mFrameStart = now;
+		mCurrentDrawCalls = 0;
+		mCurrentQueryPair.reset();
+
+		if (mFrameCounter == mNumWarmupFrames + mNumMeasuredFrames) {
+			finish();
+			return;
+		}
+
+		++mFrameCounter;
+		auto pathTime = mPath.mFrames.front().mTime;
+		if (const auto current = current_measured_frame(); current.has_value()) {
+			pathTime += static_cast<float>(current.value()) * mTimeStep;
+			mFrames.push_back(path_benchmark_frame{ pathTime, 0.0, {}, 0u });
+		}
+		apply_path_frame(*mCamera, sample_path(mPath, pathTime));
+	}
+
+	void orca_path_benchmark::record_gpu_begin(avk::command_buffer_t& aCommandBuffer)
+	{
+		if (mFinished || !mTimestampQueries) {
+			return;
+		}
+		const auto queryPair = static_cast<uint32_t>(context().main_window()->in_flight_index_for_frame());
+		// The frame which has used this pair before has completed, since its frame in flight is being reused:
+		read_gpu_time(queryPair);
+		aCommandBuffer.handle().resetQueryPool(mTimestampQueries.get(), 2 * queryPair, 2);
+		aCommandBuffer.handle().writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, mTimestampQueries.get(), 2 * queryPair);
+		mCurrentQueryPair = queryPair;
+	}
+
+	void orca_path_benchmark::record_gpu_end(avk::command_buffer_t& aCommandBuffer)
+	{
+		if (mFinished || !mCurrentQueryPair.has_value()) {
+			return;
+		}
+		const auto queryPair = mCurrentQueryPair.value();
+		aCommandBuffer.handle().writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, mTimestampQueries.get(), 2 * queryPair + 1);
+		mFrameOfQueryPair[queryPair] = current_measured_frame();
+		mCurrentQueryPair.reset();
+	}
+
+	void orca_path_benchmark::read_gpu_time(uint32_t aQueryPair)
+	{
+		auto& frameIndex = mFrameOfQueryPair[aQueryPair];
+		if (!frameIndex.has_value()) {
+			return;
+		}
+		std::array<uint64_t, 2> timestamps;
+		const auto result = context().device().getQueryPoolResults(
+			mTimestampQueries.get(), 2 * aQueryPair, 2,
+			sizeof(timestamps), timestamps.data(), sizeof(uint64_t),
+			vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait
+		);
+		if (vk::Result::eSuccess == result) {
+			// Only the valid bits are meaningful, and the difference of the masked values also handles a wrap-around:
+			const auto ticks = ((timestamps[1] & mTimestampMask) - (timestamps[0] & mTimestampMask)) & mTimestampMask;
+			mFrames[frameIndex.value()].mGpuTimeMs = static_cast<double>(ticks) * mTimestampPeriod / 1000000.0;
+		}
+		else {
+			LOG_WARNING(fmt::format("Could not read the timestamps of frame {} of the path benchmark.", frameIndex.value()));
+		}
+		frameIndex.reset();
+	}
+
+	void orca_path_benchmark::finish()
+	{
+		mFinished = true;
+		if (mTimestampQueries) {
+			context().device().waitIdle();
+			for (uint32_t i = 0; i < static_cast<uint32_t>(mFrameOfQueryPair.size()); ++i) {
+				read_gpu_time(i);
+			}
+		}
+		write_report(mReportPath);
+		disable();
+		if (mStopWhenFinished && nullptr != current_composition()) {
+			current_composition()->stop();
+		}
+	}
+
+	void orca_path_benchmark::write_report(const std::string& aReportPath) const
+	{
+		std::vector<double> cpuTimes, gpuTimes, drawCalls;
+		for (const auto& frame : mFrames) {
+			cpuTimes.push_back(frame.mCpuFrameTimeMs);
+			if (frame.mGpuTimeMs.has_value()) {
+				gpuTimes.push_back(frame.mGpuTimeMs.value());
+			}
+			drawCalls.push_back(static_cast<double>(frame.mDrawCalls));
+		}
+
+		const auto csvPath = aReportPath + ".csv";
+		std::ofstream csv(csvPath);
+		if (!csv.is_open()) {
+			throw gvk::runtime_error(fmt::format("Could not open benchmark report file '{}' for writing.", csvPath));
+		}
+		csv << "frame,path_time,cpu_ms,gpu_ms,draw_calls\n";
+		for (size_t i = 0; i < mFrames.size(); ++i) {
+			const auto& frame = mFrames[i];
+			csv << fmt::format("{},{},{},{},{}\n", i, frame.mPathTime, frame.mCpuFrameTimeMs, frame.mGpuTimeMs.has_value() ? fmt::format("{}", frame.mGpuTimeMs.value()) : "", frame.mDrawCalls);
+		}
+
+		auto toJson = [](const path_benchmark_statistics& bStatistics) {
+			return nlohmann::json{
+				{ "min", bStatistics.mMin }, { "mean", bStatistics.mMean }, { "max", bStatistics.mMax },
+				{ "p50", bStatistics.mP50 }, { "p90", bStatistics.mP90 }, { "p95", bStatistics.mP95 }, { "p99", bStatistics.mP99 }
+			};
+		};
+		nlohmann::json report;
+		report["path"] = mPath.mName;
+		report["time_step"] = mTimeStep;
+		report["warmup_frames"] = mNumWarmupFrames;
+		report["frames"] = mFrames.size();
+		report["cpu_ms"] = toJson(compute_benchmark_statistics(cpuTimes));
+		if (!gpuTimes.empty()) {
+			report["gpu_ms"] = toJson(compute_benchmark_statistics(gpuTimes));
+		}
+		report["draw_calls"] = toJson(compute_benchmark_statistics(drawCalls));
+
+		const auto jsonPath = aReportPath + ".json";
+		std::ofstream json(jsonPath);
+		if (!json.is_open()) {
+			throw gvk::runtime_error(fmt::format("Could not open benchmark report file '{}' for writing.", jsonPath));
+		}
+		json << report.dump(4) << "\n";
+
+		LOG_INFO(fmt::format("Benchmark of path '{}' written to '{}' and '{}'. CPU frame time p50/p95/p99: {:.3f}/{:.3f}/{:.3f} ms",
+			mPath.mName, csvPath, jsonPath, report["cpu_ms"]["p50"].get<double>(), report["cpu_ms"]["p95"].get<double>(), report["cpu_ms"]["p99"].get<double>()));
+	}
+}
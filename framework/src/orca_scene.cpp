@@ -16,163 +16,397 @@ namespace gvk
 		return result;
 	}
 
-	avk::owning_resource<orca_scene_t> orca_scene_t::load_from_file(const std::string& aPath, model_t::aiProcessFlagsType aAssimpFlags)
+	/**	Receives the events of nlohmann::json's SAX parser and writes the data of an ORCA scene file
+	 *	directly into the result vectors, without building a DOM of the whole file.
+	 *	Fields which are missing in the file keep their value-initialized defaults.
+	 */
+	class orca_scene_sax_handler
+	{
+	public:
+		using string_t = nlohmann::json::string_t;
+
+		explicit orca_scene_sax_handler(const std::string& aPath) : mPath{ aPath } {}
+
+		bool null()
+		{
+			if (mStack.empty()) {
+				return false; // The document must be an object
+			}
+			next_element();
+			return true;
+		}
+
+		bool boolean(bool aValue)
+		{
+			if (mStack.empty()) {
+				return false; // The document must be an object
+			}
+			next_element();
+			if (mSection == section::paths && depth() == 3 && current_key() == "loop") {
+				mPathsData.back().mLoop = aValue;
+			}
+			return true;
+		}
+
+		bool number_integer(nlohmann::json::number_integer_t aValue) { return number(static_cast<double>(aValue)); }
+		bool number_unsigned(nlohmann::json::number_unsigned_t aValue) { return number(static_cast<double>(aValue)); }
+		bool number_float(nlohmann::json::number_float_t aValue, const string_t&) { return number(static_cast<double>(aValue)); }
+
+		bool string(string_t& aValue)
+		{
+			if (mStack.empty()) {
+				return false; // The document must be an object
+			}
+			next_element();
+			const auto& key = current_key();
+			switch (mSection) {
+			case section::models:
+				if (depth() == 3) {
+					if (key == "file") { mModelData.back().mFileName = std::move(aValue); }
+					else if (key == "name") { mModelData.back().mName = std::move(aValue); }
+				}
+				else if (is_instance_object(depth()) && key == "name") {
+					mModelData.back().mInstances.back().mName = std::move(aValue);
+				}
+				break;
+			case section::lights:
+				if (depth() == 3 && key == "type") { mLightType = std::move(aValue); }
+				break;
+			case section::light_probes:
+				if (depth() == 3 && key == "file") { mLightProbesData.back().mFileName = std::move(aValue); }
+				break;
+			case section::user_defined:
+				if (depth() == 2 && key == "sky_box") {
+					if (mUserDefinedData.empty()) {
+						mUserDefinedData.emplace_back();
+					}
+					mUserDefinedData.back().mSkyBoxPath = std::move(aValue);
+				}
+				break;
+			case section::paths:
+				if (depth() == 3 && key == "name") { mPathsData.back().mName = std::move(aValue); }
+				break;
+			default:
+				break;
+			}
+			return true;
+		}
+
+		bool key(string_t& aValue)
+		{
+			if (depth() == 1) {
+				if      (aValue == "models")       { mSection = section::models; }
+				else if (aValue == "lights")       { mSection = section::lights; }
+				else if (aValue == "cameras")      { mSection = section::cameras; }
+				else if (aValue == "light_probes") { mSection = section::light_probes; }
+				else if (aValue == "user_defined") { mSection = section::user_defined; }
+				else if (aValue == "paths")        { mSection = section::paths; }
+				else                               { mSection = section::none; }
+			}
+			mStack.back().mKey = std::move(aValue);
+			return true;
+		}
+
+		bool start_object(std::size_t)
+		{
+			push(false);
+			const auto d = depth();
+			switch (mSection) {
+			case section::models:
+				if (d == 3) { mModelData.emplace_back(); }
+				else if (is_instance_object(d)) { mModelData.back().mInstances.emplace_back(); }
+				break;
+			case section::lights:
+				if (d == 3) {
+					mLightType.clear();
+					mLight = point_light_data{};
+				}
+				break;
+			case section::cameras:
+				if (d == 3) { mCamerasData.emplace_back(); }
+				break;
+			case section::light_probes:
+				if (d == 3) { mLightProbesData.emplace_back(); }
+				break;
+			case section::paths:
+				if (d == 3) { mPathsData.emplace_back(); }
+				else if (is_frame_object(d)) { mPathsData.back().mFrames.emplace_back(); }
+				break;
+			default:
+				break;
+			}
+			return true;
+		}
+
+		bool end_object()
+		{
+			if (mSection == section::lights && depth() == 3) {
+				if (mLightType == "dir_light") {
+					auto& d = mDirLightsData.emplace_back();
+					d.mDirection = mLight.mDirection;
+					d.mIntensity = mLight.mIntensity;
+				}
+				else if (mLightType == "point_light") {
+					mPointLightsData.push_back(mLight);
+				}
+				else {
+					LOG_WARNING(fmt::format("The light type '{}' does not exist in this framework.", mLightType));
+				}
+			}
+			mStack.pop_back();
+			return true;
+		}
+
+		bool start_array(std::size_t)
+		{
+			if (mStack.empty()) {
+				return false; // The document must be an object
+			}
+			push(true);
+			return true;
+		}
+
+		bool end_array()
+		{
+			mStack.pop_back();
+			return true;
+		}
+
+		bool parse_error(std::size_t aPosition, const std::string&, const nlohmann::detail::exception& aException)
+		{
+			throw gvk::runtime_error(fmt::format("Unable to parse scene from path[{}] at byte {}: {}", mPath, aPosition, aException.what()));
+		}
+
+		std::vector<model_data> mModelData;
+		std::vector<direct_light_data> mDirLightsData;
+		std::vector<point_light_data> mPointLightsData;
+		std::vector<camera_data> mCamerasData;
+		std::vector<light_probes_data> mLightProbesData;
+		std::vector<user_defined_data> mUserDefinedData;
+		std::vector<path_data> mPathsData;
+
+	private:
+		enum struct section { none, models, lights, cameras, light_probes, user_defined, paths };
+
+		/** An object or array which is currently being parsed */
+		struct frame
+		{
+			bool mIsArray;
+			/** The key under which this object or array is stored in its parent object */
+			std::string mName;
+			/** The most recent key, if this is an object */
+			std::string mKey;
+			/** The number of elements so far, if this is an array */
+			size_t mCount;
+		};
+
+		size_t depth() const { return mStack.size(); }
+		const std::string& current_key() const
+		{
+			static const std::string sNoKey;
+			return mStack.empty() ? sNoKey : mStack.back().mKey;
+		}
+
+		/** Returns the index of the next element within the current array and advances it, or 0 if not inside an array */
+		size_t next_element()
+		{
+			if (mStack.empty() || !mStack.back().mIsArray) {
+				return 0;
+			}
+			return mStack.back().mCount++;
+		}
+
+		void push(bool aIsArray)
+		{
+			next_element();
+			std::string name = mStack.empty() || mStack.back().mIsArray ? std::string{} : mStack.back().mKey;
+			mStack.push_back(frame{ aIsArray, std::move(name), {}, 0 });
+		}
+
+		// models[i].instances[j] and paths[i].frames[j] are objects at depth 5:
+		bool is_instance_object(size_t aDepth) const { return aDepth == 5 && mStack[3].mName == "instances"; }
+		bool is_frame_object(size_t aDepth) const { return aDepth == 5 && mStack[3].mName == "frames"; }
+
+		/** Returns the component of the vector which is currently being parsed, or nullptr if there are too many components */
+		template <typename V>
+		float* component(V& aVector, size_t aIndex)
+		{
+			if (aIndex >= static_cast<size_t>(V::length())) {
+				if (aIndex == static_cast<size_t>(V::length())) {
+					LOG_ERROR(fmt::format("Vector '{}' in scene file[{}] contains more than {} values", mStack.back().mName, mPath, V::length()));
+				}
+				return nullptr;
+			}
+			return &aVector[static_cast<typename V::length_type>(aIndex)];
+		}
+
+		/** Returns the vector component that a number within an array at the current position is stored in, or nullptr if it is not used */
+		float* vector_component(size_t aIndex)
+		{
+			const auto d = depth();
+			const auto& name = mStack.back().mName;
+			switch (mSection) {
+			case section::models:
+				if (d == 6 && is_instance_object(5)) {
+					auto& instance = mModelData.back().mInstances.back();
+					if (name == "translation") { return component(instance.mTranslation, aIndex); }
+					if (name == "scaling")     { return component(instance.mScaling, aIndex); }
+					if (name == "rotation")    { return component(instance.mRotation, aIndex); }
+				}
+				break;
+			case section::lights:
+				if (d == 4) {
+					if (name == "direction") { return component(mLight.mDirection, aIndex); }
+					if (name == "intensity") { return component(mLight.mIntensity, aIndex); }
+					if (name == "pos")       { return component(mLight.mPosition, aIndex); }
+				}
+				break;
+			case section::cameras:
+				if (d == 4) {
+					auto& c = mCamerasData.back();
+					if (name == "pos")         { return component(c.mPosition, aIndex); }
+					if (name == "target")      { return component(c.mTarget, aIndex); }
+					if (name == "up")          { return component(c.mUp, aIndex); }
+					if (name == "depth_range") { return component(c.mDepthRange, aIndex); }
+				}
+				break;
+			case section::light_probes:
+				if (d == 4) {
+					auto& l = mLightProbesData.back();
+					if (name == "intensity") { return component(l.mIntensity, aIndex); }
+					if (name == "pos")       { return component(l.mPosition, aIndex); }
+				}
+				break;
+			case section::paths:
+				if (d == 6 && is_frame_object(5)) {
+					auto& f = mPathsData.back().mFrames.back();
+					if (name == "pos")    { return component(f.mPosition, aIndex); }
+					if (name == "target") { return component(f.mTarget, aIndex); }
+					if (name == "up")     { return component(f.mUp, aIndex); }
+				}
+				break;
+			default:
+				break;
+			}
+			return nullptr;
+		}
+
+		bool number(double aValue)
+		{
+			if (mStack.empty()) {
+				return false; // The document must be an object
+			}
+			if (mStack.back().mIsArray) {
+				const auto index = next_element();
+				if (auto* target = vector_component(index); nullptr != target) {
+					*target = static_cast<float>(aValue);
+				}
+				return true;
+			}
+
+			const auto d = depth();
+			const auto& key = current_key();
+			switch (mSection) {
+			case section::lights:
+				if (d == 3) {
+					if (key == "opening_angle")       { mLight.mOpeningAngle = static_cast<float>(aValue); }
+					else if (key == "penumbra_angle") { mLight.mPenumbraAngle = static_cast<float>(aValue); }
+				}
+				break;
+			case section::cameras:
+				if (d == 3) {
+					if (key == "focal_length")      { mCamerasData.back().mFocalLength = static_cast<float>(aValue); }
+					else if (key == "aspect_ratio") { mCamerasData.back().mAspectRatio = static_cast<float>(aValue); }
+				}
+				break;
+			case section::light_probes:
+				if (d == 3) {
+					if (key == "diff_samples")      { mLightProbesData.back().mDiffSamples = static_cast<int>(aValue); }
+					else if (key == "spec_samples") { mLightProbesData.back().mSpecSamples = static_cast<int>(aValue); }
+				}
+				break;
+			case section::paths:
+				if (is_frame_object(d) && key == "time") {
+					mPathsData.back().mFrames.back().mTime = static_cast<float>(aValue);
+				}
+				break;
+			default:
+				break;
+			}
+			return true;
+		}
+
+		std::string mPath;
+		std::vector<frame> mStack;
+		section mSection = section::none;
+		// The light which is currently being parsed, converted to its type when the light's object ends:
+		std::string mLightType;
+		point_light_data mLight{};
+	};
+
+	avk::owning_resource<orca_scene_t> orca_scene_t::load_from_file(const std::string& aPath, model_t::aiProcessFlagsType aAssimpFlags, bool aShareIdenticalModelFiles)
 	{
 		std::ifstream stream(aPath, std::ifstream::in);
 		if (!stream.good() || !stream || stream.fail())
 		{
 			throw gvk::runtime_error(fmt::format("Unable to load scene from path[{}]", aPath));
 		}
-		std::string filecontents = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
-		if (filecontents.empty())
+		if (stream.peek() == std::ifstream::traits_type::eof())
 		{
 			throw gvk::runtime_error(fmt::format("Filecontents empty when loading scene from path[{}]", aPath));
 		}
 
-		nlohmann::json j = nlohmann::json::parse(filecontents);
-		nlohmann::json jModels = j["models"];
-		nlohmann::json jLights = j["lights"];
-		nlohmann::json jCameras = j["cameras"];
-		nlohmann::json jLightProbes = j["light_probes"];
-		nlohmann::json jUserDefinded = j["user_defined"];
-		nlohmann::json jPaths = j["paths"];
+		// Stream the file through the SAX parser, which fills the scene's data directly:
+		orca_scene_sax_handler handler{ aPath };
+		if (!nlohmann::json::sax_parse(stream, &handler)) {
+			throw gvk::runtime_error(fmt::format("Unable to parse scene from path[{}]: The document is not a JSON object.", aPath));
+		}
 
 		orca_scene_t result;
 		result.mLoadPath = aPath;
-
-		// === process models === //
-		result.mModelData.reserve(jModels.size());
-		for (auto i = jModels.begin(); i != jModels.end(); ++i) {
-			nlohmann::json jModel = i.value();
-			model_data model;
-			model.mFileName = convert_json_to_string(jModel["file"]);
-			model.mName = convert_json_to_string(jModel["name"]);
-
-			nlohmann::json jInstances = jModel["instances"];
-			for (auto h = jInstances.begin(); h != jInstances.end(); ++h) {
-				nlohmann::json jInstance = h.value();
-				model_instance_data instance;
-				instance.mName = convert_json_to_string(jInstance["name"]);
-				instance.mTranslation = convert_json_to_vec3(jInstance["translation"]);
-				instance.mScaling = convert_json_to_vec3(jInstance["scaling"]);
-				instance.mRotation = convert_json_to_vec3(jInstance["rotation"]);
-				model.mInstances.push_back(instance);
-			}
-
-			result.mModelData.push_back(model);
-		}
-
-		// === process lights === //
-		for (auto i = jLights.begin(); i != jLights.end(); ++i) {
-			nlohmann::json jLight = i.value();
-
-			std::string lightType = jLight["type"];
-			glm::vec3 direction = convert_json_to_vec3(jLight["direction"]);
-			glm::vec3 intensity = convert_json_to_vec3(jLight["intensity"]);
-
-			if (lightType.compare("dir_light") == 0) {
-				direct_light_data d;
-				d.mDirection = direction;
-				d.mIntensity = intensity;
-				result.mDirLightsData.push_back(d);
-			} else if (lightType.compare("point_light") == 0) {
-				point_light_data p;
-				p.mDirection = direction;
-				p.mIntensity = intensity;
-				p.mPosition = convert_json_to_vec3(jLight["pos"]);
-				p.mOpeningAngle = jLight["opening_angle"];
-				p.mPenumbraAngle = jLight["penumbra_angle"];
-				result.mPointLightsData.push_back(p);
-			} else {
-				std::string msg = "The light type '" + lightType + "' does not exist in this framework.";
-				LOG_WARNING(msg);
-			}
-		}
-
-		// === process cameras === //
-		for (auto i = jCameras.begin(); i != jCameras.end(); ++i) {
-			nlohmann::json jCamera = i.value();
-			camera_data c;
-			c.mPosition = convert_json_to_vec3(jCamera["pos"]);
-			c.mTarget = convert_json_to_vec3(jCamera["target"]);
-			c.mUp = convert_json_to_vec3(jCamera["up"]);
-			c.mFocalLength = jCamera["focal_length"];
-			c.mAspectRatio = jCamera["aspect_ratio"];
-			std::vector<float> v = jCamera["depth_range"];
-			c.mDepthRange = glm::vec2(v[0], v[1]);
-			result.mCamerasData.push_back(c);
-		}
-
-		// === process light probes === //
-		for (auto i = jLightProbes.begin(); i != jLightProbes.end(); ++i) {
-			nlohmann::json jLightProbe = i.value();
-			light_probes_data l;
-
-			l.mFileName = convert_json_to_string(jLightProbe["file"]);
-			l.mDiffSamples = jLightProbe["diff_samples"];
-			l.mSpecSamples = jLightProbe["spec_samples"];
-			l.mIntensity = convert_json_to_vec3(jLightProbe["intensity"]);
-			l.mPosition = convert_json_to_vec3(jLightProbe["pos"]);
-        
-			result.mLightProbesData.push_back(l);
-		}
-
-		// === process userdefined === //
-		if (!jUserDefinded.empty()) {
-			user_defined_data data;
-			data.mSkyBoxPath = convert_json_to_string(jUserDefinded["sky_box"]);
-			result.mUserDefinedData.push_back(data);
-		}
-
-		// === process paths === //
-		for (auto i = jPaths.begin(); i != jPaths.end(); ++i) {
-			nlohmann::json jPath = i.value();
-
-			path_data p;
-			p.mName = convert_json_to_string(jPath["name"]);
-			p.mLoop = jPath["loop"];
-        
-			nlohmann::json jFrames = jPath["frames"];
-			std::vector<frame_data> frames;
-			frames.reserve(jFrames.size());
-			for (auto j = jFrames.begin(); j != jFrames.end(); ++j) {
-				nlohmann::json jFrame = j.value();
-				frame_data f;
-				f.mTime = jFrame["time"];
-				f.mPosition = convert_json_to_vec3(jFrame["pos"]);
-				f.mTarget = convert_json_to_vec3(jFrame["target"]);
-				f.mUp = convert_json_to_vec3(jFrame["up"]);
-				frames.push_back(f);
-			}
-
-			p.mFrames = frames;
-			result.mPathsData.push_back(p);
-		}
+		result.mModelData = std::move(handler.mModelData);
+		result.mDirLightsData = std::move(handler.mDirLightsData);
+		result.mPointLightsData = std::move(handler.mPointLightsData);
+		result.mCamerasData = std::move(handler.mCamerasData);
+		result.mLightProbesData = std::move(handler.mLightProbesData);
+		result.mUserDefinedData = std::move(handler.mUserDefinedData);
+		result.mPathsData = std::move(handler.mPathsData);
 
 		// Load the models into memory:
 		auto fsceneBasePath = avk::extract_base_path(result.mLoadPath);
-		for (auto& modelData : result.mModelData) {
+		const auto numModels = result.mModelData.size();
+		std::vector<size_t> loadedBy(numModels); // Index of the model_data which loads the file for each model_data
+		std::vector<size_t> modelsToLoad;
+		std::unordered_map<std::string, size_t> modelIndexForPath;
+		for (size_t i = 0; i < numModels; ++i) {
+			auto& modelData = result.mModelData[i];
 			modelData.mFullPathName = avk::combine_paths(fsceneBasePath, modelData.mFileName);
+			loadedBy[i] = i;
+			if (aShareIdenticalModelFiles) {
+				auto [it, inserted] = modelIndexForPath.emplace(avk::clean_up_path(modelData.mFullPathName), i);
+				if (!inserted) {
+					loadedBy[i] = it->second;
+					continue;
+				}
+			}
+			modelsToLoad.push_back(i);
+		}
+
+		// Every model_t has its own Assimp::Importer => the imports can run concurrently. Each task writes only to its own model_data:
+		default_thread_pool().parallel_for(0, modelsToLoad.size(), [&result, &modelsToLoad, aAssimpFlags](size_t bIndex) {
+			auto& modelData = result.mModelData[modelsToLoad[bIndex]];
 			modelData.mLoadedModel = model_t::load_from_file(modelData.mFullPathName, aAssimpFlags);
+		});
+
+		for (size_t i = 0; i < numModels; ++i) {
+			if (loadedBy[i] != i) {
+				auto& loadedModel = result.mModelData[loadedBy[i]].mLoadedModel;
+				loadedModel.enable_shared_ownership();
+				result.mModelData[i].mLoadedModel = loadedModel;
+			}
 		}
+		LOG_DEBUG(fmt::format("Loaded {} model files for {} models of scene '{}'.", modelsToLoad.size(), numModels, aPath));
 		
 		return result;
 	}
-
-	glm::vec3 convert_json_to_vec3(nlohmann::json& j)
-	{
-		std::vector<float> v = j;
-		if (v.size() != 3) {
-			LOG_ERROR(fmt::format("Called function convert_json_to_vec3, but vector contains {} values", v.size()));
-			return glm::vec3{};
-		}
-		return glm::vec3(v[0], v[1], v[2]);
-	}
-
-	
-	std::string convert_json_to_string(nlohmann::json& j)
-	{
-		std::string s = j;
-		return s;
-	}
 }
@@ -0,0 +1,583 @@
+#include <gvk.hpp>
+#include <glm/gtc/packing.hpp>
+#include <stb_dxt.h>
+#include <stb_image_resize.h>
+
+namespace gvk
+{
+	static constexpr std::array<char, 8> sPackageMagic = { 'G', 'V', 'K', 'O', 'R', 'C', 'A', '\0' };
+	static constexpr uint32_t sPackageVersion = 1u;
+	// Every section starts at a multiple of this, which satisfies all of Vulkan's buffer offset alignments:
+	static constexpr uint64_t sPackageSectionAlignment = 256u;
+	// Every mip level of a texture starts at a multiple of this, which is a multiple of every block size:
+	static constexpr uint64_t sPackageTextureLevelAlignment = 16u;
+
+	/** A range of bytes within a package file, or within one of its sections */
+	struct package_range
+	{
+		uint64_t mOffset;
+		uint64_t mSize;
+	};
+
+	/** The header at the beginning of every package file, which contains the ranges of all sections */
+	struct package_header
+	{
+		std::array<char, 8> mMagic;
+		uint32_t mVersion;
+		uint32_t mReserved;
+		package_range mPositions;			// glm::vec3
+		package_range mTexCoords;			// glm::vec2
+		package_range mNormals;				// glm::vec3
+		package_range mIndices;				// uint32_t
+		package_range mDrawCommands;		// vk::DrawIndexedIndirectCommand
+		package_range mDrawData;			// scene_batch_draw_data
+		package_range mInstanceTransforms;	// glm::mat4
+		package_range mModels;				// package_model
+		package_range mMaterials;			// material_gpu_data
+		package_range mTextures;			// package_texture
+		package_range mTextureLevels;		// package_range, relative to mTextureData
+		package_range mTextureData;			// bytes
+		package_range mDirLights;			// direct_light_data
+		package_range mPointLights;			// point_light_data
+		package_range mCameras;				// camera_data
+		package_range mPaths;				// package_path
+		package_range mFrames;				// frame_data
+		package_range mStrings;				// chars, referenced via package_range relative to mStrings
+	};
+
+	struct package_model
+	{
+		package_range mName;
+		package_range mFileName;
+		uint32_t mFirstInstance;
+		uint32_t mInstanceCount;
+		uint32_t mFirstDrawCommand;
+		uint32_t mDrawCommandCount;
+	};
+
+	struct package_texture
+	{
+		vk::Format mFormat;
+		uint32_t mWidth;
+		uint32_t mHeight;
+		/** Index of the first level in the package's texture levels */
+		uint32_t mFirstLevel;
+		/** Number of stored levels. If it is 1, further mip levels (if any) are generated on the GPU. */
+		uint32_t mNumLevels;
+		/** 1 for the 1x1 replacement textures, which are sampled with nearest neighbor filtering */
+		uint32_t mIsReplacement;
+	};
+
+	struct package_path
+	{
+		package_range mName;
+		uint32_t mLoop;
+		uint32_t mFirstFrame;
+		uint32_t mNumFrames;
+		uint32_t mPadding;
+	};
+
+	static_assert(std::is_trivially_copyable_v<scene_batch_draw_data> && std::is_trivially_copyable_v<material_gpu_data>);
+	static_assert(std::is_trivially_copyable_v<direct_light_data> && std::is_trivially_copyable_v<point_light_data>);
+	static_assert(std::is_trivially_copyable_v<camera_data> && std::is_trivially_copyable_v<frame_data>);
+
+	/** Texture data in its final format, ready to be copied into an image */
+	struct package_texture_data
+	{
+		package_texture mTexture;
+		std::vector<std::vector<uint8_t>> mLevels;
+		/** The RGBA pixels of HDR images, which are converted into mLevels by complete_texture_for_package */
+		std::vector<float> mHdrPixels;
+	};
+
+	/**	Loads a texture from file like create_image_from_file does for four components: Block-compressed
+	 *	DDS/KTX textures keep their format and mip chain. The pixels of all other images are stored as the
+	 *	first level (8-bit RGBA, sRGB if aSrgb is true) or in mHdrPixels (HDR images), and their mip chain
+	 *	is created by complete_texture_for_package. Textures can be decoded concurrently.
+	 */
+	static package_texture_data decode_texture_for_package(const std::string& aPath, bool aSrgb, bool aFlip)
+	{
+		package_texture_data result{};
+
+		// ============ Compressed formats (DDS, KTX) ==========
+		gli::texture gliTex = gli::load(aPath);
+		if (!gliTex.empty()) {
+			if (aFlip && (!gli::is_compressed(gliTex.format()) || gli::is_s3tc_compressed(gliTex.format()))) {
+				gliTex = gli::flip(gliTex);
+			}
+			auto format = vk_format_from_gli_format(gliTex.format());
+			if (format.has_value()) {
+				if (gliTex.target() != gli::TARGET_2D) {
+					throw gvk::runtime_error(fmt::format("The image '{}' is not intended to be used as 2D image. Can't load it.", aPath));
+				}
+				result.mTexture.mFormat = format.value();
+				result.mTexture.mWidth = static_cast<uint32_t>(gliTex.extent()[0]);
+				result.mTexture.mHeight = static_cast<uint32_t>(gliTex.extent()[1]);
+				for (size_t level = 0; level < gliTex.levels(); ++level) {
+					const auto* data = static_cast<const uint8_t*>(gliTex.data(0, 0, level));
+					result.mLevels.emplace_back(data, data + gliTex.size(level));
+				}
+				return result;
+			}
+		}
+
+		int width = 0;
+		int height = 0;
+		int channelsInFile = 0;
+		// ============ RGB 16-bit float formats (HDR) ==========
+		if (stbi_is_hdr(aPath.c_str())) {
+			stbi_set_flip_vertically_on_load_thread(true);
+			float* pixels = stbi_loadf(aPath.c_str(), &width, &height, &channelsInFile, STBI_rgb_alpha);
+			if (!pixels) {
+				throw gvk::runtime_error(fmt::format("Couldn't load image from '{}' using stbi_loadf", aPath));
+			}
+			result.mHdrPixels.assign(pixels, pixels + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+			stbi_image_free(pixels);
+			result.mTexture.mFormat = default_rgb16f_4comp_format();
+		}
+		// ============ RGB 8-bit formats ==========
+		else {
+			stbi_set_flip_vertically_on_load_thread(aFlip);
+			stbi_uc* pixels = stbi_load(aPath.c_str(), &width, &height, &channelsInFile, STBI_rgb_alpha);
+			if (!pixels) {
+				throw gvk::runtime_error(fmt::format("Couldn't load image from '{}' using stbi_load", aPath));
+			}
+			result.mLevels.emplace_back(pixels, pixels + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+			stbi_image_free(pixels);
+			result.mTexture.mFormat = aSrgb ? default_srgb_4comp_format() : default_rgb8_4comp_format();
+		}
+		result.mTexture.mWidth = static_cast<uint32_t>(width);
+		result.mTexture.mHeight = static_cast<uint32_t>(height);
+		return result;
+	}
+
+	/** Compresses RGBA pixels into BC3 blocks, where partial blocks at the borders are padded by repeating the last row/column */
+	static std::vector<uint8_t> compress_bc3(const std::vector<uint8_t>& aPixels, uint32_t aWidth, uint32_t aHeight)
+	{
+		const uint32_t blocksX = (aWidth + 3) / 4;
+		const uint32_t blocksY = (aHeight + 3) / 4;
+		std::vector<uint8_t> result(static_cast<size_t>(blocksX) * blocksY * 16);
+		std::array<uint8_t, 64> block;
+		for (uint32_t by = 0; by < blocksY; ++by) {
+			for (uint32_t bx = 0; bx < blocksX; ++bx) {
+				for (uint32_t y = 0; y < 4; ++y) {
+					for (uint32_t x = 0; x < 4; ++x) {
+						const auto px = std::min(bx * 4 + x, aWidth - 1);
+						const auto py = std::min(by * 4 + y, aHeight - 1);
+						memcpy(&block[(y * 4 + x) * 4], &aPixels[(static_cast<size_t>(py) * aWidth + px) * 4], 4);
+					}
+				}
+				stb_compress_dxt_block(&result[(static_cast<size_t>(by) * blocksX + bx) * 16], block.data(), 1, STB_DXT_HIGHQUAL);
+			}
+		}
+		return result;
+	}
+
+	/**	Creates the full mip chain of a texture which has been decoded by decode_texture_for_package, and
+	 *	compresses the levels of 8-bit textures into BC3 if aCompress is true.
+	 *	Replacement textures, and textures which already have a mip chain (or which are block-compressed) are not modified.
+	 */
+	static void complete_texture_for_package(package_texture_data& aTexture, bool aCompress)
+	{
+		if (aTexture.mTexture.mIsReplacement != 0u || avk::is_block_compressed_format(aTexture.mTexture.mFormat) || aTexture.mLevels.size() > 1) {
+			return;
+		}
+
+		const auto w0 = aTexture.mTexture.mWidth;
+		const auto h0 = aTexture.mTexture.mHeight;
+		const auto numLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(w0, h0)))) + 1u;
+		auto levelWidth = [w0](uint32_t bLevel) { return std::max(w0 >> bLevel, 1u); };
+		auto levelHeight = [h0](uint32_t bLevel) { return std::max(h0 >> bLevel, 1u); };
+
+		if (!aTexture.mHdrPixels.empty()) {
+			std::vector<float> previous = std::move(aTexture.mHdrPixels);
+			for (uint32_t level = 0; level < numLevels; ++level) {
+				if (level > 0) {
+					std::vector<float> current(static_cast<size_t>(levelWidth(level)) * levelHeight(level) * 4);
+					stbir_resize_float(previous.data(), levelWidth(level - 1), levelHeight(level - 1), 0, current.data(), levelWidth(level), levelHeight(level), 0, 4);
+					previous = std::move(current);
+				}
+				const auto numPixels = previous.size() / 4;
+				auto& halfs = aTexture.mLevels.emplace_back(numPixels * sizeof(uint64_t));
+				for (size_t i = 0; i < numPixels; ++i) {
+					const uint64_t half4 = glm::packHalf4x16(glm::make_vec4(previous.data() + i * 4));
+					memcpy(halfs.data() + i * sizeof(uint64_t), &half4, sizeof(uint64_t));
+				}
+			}
+			aTexture.mHdrPixels.clear();
+			return;
+		}
+
+		const bool srgb = aTexture.mTexture.mFormat == default_srgb_4comp_format();
+		for (uint32_t level = 1; level < numLevels; ++level) {
+			const auto& previous = aTexture.mLevels[level - 1];
+			std::vector<uint8_t> current(static_cast<size_t>(levelWidth(level)) * levelHeight(level) * 4);
+			if (srgb) {
+				stbir_resize_uint8_srgb(previous.data(), levelWidth(level - 1), levelHeight(level - 1), 0, current.data(), levelWidth(level), levelHeight(level), 0, 4, 3, 0);
+			}
+			else {
+				stbir_resize_uint8(previous.data(), levelWidth(level - 1), levelHeight(level - 1), 0, current.data(), levelWidth(level), levelHeight(level), 0, 4);
+			}
+			aTexture.mLevels.push_back(std::move(current));
+		}
+
+		if (aCompress) {
+			for (uint32_t level = 0; level < numLevels; ++level) {
+				aTexture.mLevels[level] = compress_bc3(aTexture.mLevels[level], levelWidth(level), levelHeight(level));
+			}
+			aTexture.mTexture.mFormat = srgb ? vk::Format::eBc3SrgbBlock : vk::Format::eBc3UnormBlock;
+		}
+	}
+
+	static package_texture_data replacement_texture_for_package(std::array<uint8_t, 4> aColor)
+	{
+		package_texture_data result{};
+		result.mTexture.mFormat = vk::Format::eR8G8B8A8Unorm;
+		result.mTexture.mWidth = 1u;
+		result.mTexture.mHeight = 1u;
+		result.mTexture.mIsReplacement = 1u;
+		result.mLevels.emplace_back(aColor.begin(), aColor.end());
+		return result;
+	}
+
+	/** Writes the sections of a package file, each one aligned to sPackageSectionAlignment */
+	class package_writer
+	{
+	public:
+		explicit package_writer(const std::string& aPath)
+			: mStream{ aPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc }
+		{
+			if (!mStream.good()) {
+				throw gvk::runtime_error(fmt::format("Unable to open package file[{}] for writing", aPath));
+			}
+			// Reserve space for the header, which is written last:
+			const package_header placeholder{};
+			write_bytes(&placeholder, sizeof(placeholder));
+		}
+
+		void write_bytes(const void* aData, size_t aSize)
+		{
+			mStream.write(static_cast<const char*>(aData), static_cast<std::streamsize>(aSize));
+			mPosition += aSize;
+		}
+
+		void pad_to(uint64_t aAlignment)
+		{
+			static const std::array<char, sPackageSectionAlignment> sZeros{};
+			const auto padding = (aAlignment - mPosition % aAlignment) % aAlignment;
+			write_bytes(sZeros.data(), static_cast<size_t>(padding));
+		}
+
+		template <typename T>
+		package_range write_section(const std::vector<T>& aData)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			pad_to(sPackageSectionAlignment);
+			package_range range{ mPosition, sizeof(T) * aData.size() };
+			write_bytes(aData.data(), static_cast<size_t>(range.mSize));
+			return range;
+		}
+
+		uint64_t position() const { return mPosition; }
+
+		void finish(const package_header& aHeader)
+		{
+			mStream.seekp(0);
+			mStream.write(reinterpret_cast<const char*>(&aHeader), sizeof(aHeader));
+			mStream.close();
+			if (mStream.fail()) {
+				throw gvk::runtime_error("Failed to write the package file");
+			}
+		}
+
+	private:
+		std::ofstream mStream;
+		uint64_t mPosition = 0;
+	};
+
+	static package_range add_string(std::vector<char>& aStrings, const std::string& aString)
+	{
+		package_range range{ aStrings.size(), aString.size() };
+		aStrings.insert(std::end(aStrings), std::begin(aString), std::end(aString));
+		return range;
+	}
+
+	void bake_orca_scene_package(orca_scene_t& aScene, const std::string& aPackagePath, bool aLoadTexturesInSrgb, bool aFlipTextures, bool aCompressTextures)
+	{
+		auto& models = aScene.models();
+
+		// Assign an index to every distinct material, and look it up per model and mesh:
+		std::vector<material_config> materialConfigs;
+		std::unordered_map<const model_t*, std::unordered_map<mesh_index_t, uint32_t>> materialIndices;
+		for (const auto& pair : aScene.distinct_material_configs_for_all_models()) {
+			materialConfigs.push_back(pair.first);
+			const auto materialIndex = static_cast<uint32_t>(materialConfigs.size() - 1);
+			for (const auto& indices : pair.second) {
+				const model_t& model = models[indices.mModelIndex].mLoadedModel;
+				for (auto meshIndex : indices.mMeshIndices) {
+					materialIndices[&model][meshIndex] = materialIndex;
+				}
+			}
+		}
+
+		// Gather the geometry of every model once:
+		std::vector<std::tuple<std::reference_wrapper<const model_t>, std::vector<size_t>>> selection;
+		std::vector<size_t> modelIndexOfSelection;
+		for (size_t m = 0; m < models.size(); ++m) {
+			if (models[m].mInstances.empty()) {
+				continue;
+			}
+			const model_t& model = models[m].mLoadedModel;
+			std::vector<size_t> meshIndices(model.num_meshes());
+			std::iota(std::begin(meshIndices), std::end(meshIndices), size_t{0});
+			selection.emplace_back(std::cref(model), std::move(meshIndices));
+			modelIndexOfSelection.push_back(m);
+		}
+		auto batchData = get_scene_batch_data(selection, [&materialIndices](const model_t& bModel, mesh_index_t bMeshIndex) {
+			return materialIndices[&bModel][bMeshIndex];
+		});
+
+		// ...and create one draw command per mesh and instance, which all refer to the same geometry:
+		std::vector<vk::DrawIndexedIndirectCommand> drawCommands;
+		std::vector<scene_batch_draw_data> drawData;
+		std::vector<glm::mat4> instanceTransforms;
+		std::vector<package_model> packageModels;
+		std::vector<char> strings;
+		size_t firstMeshDraw = 0;
+		for (size_t s = 0; s < selection.size(); ++s) {
+			const auto& modelData = models[modelIndexOfSelection[s]];
+			const auto numMeshes = std::get<std::vector<size_t>>(selection[s]).size();
+
+			auto& pm = packageModels.emplace_back();
+			pm.mName = add_string(strings, modelData.mName);
+			pm.mFileName = add_string(strings, modelData.mFileName);
+			pm.mFirstInstance = static_cast<uint32_t>(instanceTransforms.size());
+			pm.mInstanceCount = static_cast<uint32_t>(modelData.mInstances.size());
+			pm.mFirstDrawCommand = static_cast<uint32_t>(drawCommands.size());
+			pm.mDrawCommandCount = static_cast<uint32_t>(numMeshes * modelData.mInstances.size());
+
+			for (const auto& transform : instance_transforms(modelData)) {
+				const auto transformIndex = static_cast<uint32_t>(instanceTransforms.size());
+				instanceTransforms.push_back(transform);
+				for (size_t i = firstMeshDraw; i < firstMeshDraw + numMeshes; ++i) {
+					auto& cmd = drawCommands.emplace_back(batchData.mDrawCommands[i]);
+					// Like in get_scene_batch_data; draw_scene_batch falls back to direct draws if indirect draws can not use it:
+					cmd.firstInstance = static_cast<uint32_t>(drawCommands.size() - 1);
+					auto& dd = drawData.emplace_back(batchData.mDrawData[i]);
+					dd.mTransformIndex = transformIndex;
+				}
+			}
+			firstMeshDraw += numMeshes;
+		}
+
+		// Materials and their textures in their final format:
+		auto [gpuMaterials, textureInfos] = get_material_gpu_data_and_textures(materialConfigs, aLoadTexturesInSrgb);
+		// Decoding, creating the mip chains, and compressing them takes most of the time, and every texture can be processed independently:
+		std::vector<package_texture_data> decodedTextures(textureInfos.size());
+		default_thread_pool().parallel_for(0, textureInfos.size(), [&textureInfos, &decodedTextures, aFlipTextures, aCompressTextures](size_t bIndex) {
+			const auto& info = textureInfos[bIndex];
+			switch (info.mType) {
+			case material_texture_info::texture_type::white_1px:
+				decodedTextures[bIndex] = replacement_texture_for_package({ 255, 255, 255, 255 });
+				break;
+			case material_texture_info::texture_type::straight_up_normal_1px:
+				decodedTextures[bIndex] = replacement_texture_for_package({ 127, 127, 255, 0 });
+				break;
+			case material_texture_info::texture_type::from_file:
+				decodedTextures[bIndex] = decode_texture_for_package(info.mPath, info.mSrgb, aFlipTextures);
+				break;
+			}
+			complete_texture_for_package(decodedTextures[bIndex], aCompressTextures);
+		});
+
+		std::vector<package_texture> textures;
+		std::vector<package_range> textureLevels;
+		std::vector<uint8_t> textureData;
+		for (auto& tex : decodedTextures) {
+			tex.mTexture.mFirstLevel = static_cast<uint32_t>(textureLevels.size());
+			tex.mTexture.mNumLevels = static_cast<uint32_t>(tex.mLevels.size());
+			textures.push_back(tex.mTexture);
+			for (const auto& level : tex.mLevels) {
+				textureData.resize((textureData.size() + sPackageTextureLevelAlignment - 1) / sPackageTextureLevelAlignment * sPackageTextureLevelAlignment, 0);
+				textureLevels.push_back(package_range{ textureData.size(), level.size() });
+				insert_into(textureData, level);
+			}
+		}
+		decodedTextures.clear();
+
+		// Paths, whose frames are all stored in one section:
+		std::vector<package_path> paths;
+		std::vector<frame_data> frames;
+		for (const auto& path : aScene.paths()) {
+			auto& pp = paths.emplace_back();
+			pp.mName = add_string(strings, path.mName);
+			pp.mLoop = path.mLoop ? 1u : 0u;
+			pp.mFirstFrame = static_cast<uint32_t>(frames.size());
+			pp.mNumFrames = static_cast<uint32_t>(path.mFrames.size());
+			pp.mPadding = 0u;
+			insert_into(frames, path.mFrames);
+		}
+
+		package_writer writer{ aPackagePath };
+		package_header header{};
+		header.mMagic = sPackageMagic;
+		header.mVersion = sPackageVersion;
+		header.mPositions = writer.write_section(batchData.mPositions);
+		header.mTexCoords = writer.write_section(batchData.mTexCoords);
+		header.mNormals = writer.write_section(batchData.mNormals);
+		header.mIndices = writer.write_section(batchData.mIndices);
+		header.mDrawCommands = writer.write_section(drawCommands);
+		header.mDrawData = writer.write_section(drawData);
+		header.mInstanceTransforms = writer.write_section(instanceTransforms);
+		header.mModels = writer.write_section(packageModels);
+		header.mMaterials = writer.write_section(gpuMaterials);
+		header.mTextures = writer.write_section(textures);
+		header.mTextureLevels = writer.write_section(textureLevels);
+		header.mTextureData = writer.write_section(textureData);
+		header.mDirLights = writer.write_section(aScene.directional_lights());
+		header.mPointLights = writer.write_section(aScene.point_lights());
+		header.mCameras = writer.write_section(aScene.cameras());
+		header.mPaths = writer.write_section(paths);
+		header.mFrames = writer.write_section(frames);
+		header.mStrings = writer.write_section(strings);
+		const auto fileSize = writer.position();
+		writer.finish(header);
+
+		LOG_DEBUG(fmt::format("Baked scene package[{}] with {} draw commands, {} materials, and {} textures ({} bytes).", aPackagePath, drawCommands.size(), gpuMaterials.size(), textures.size(), fileSize));
+	}
+
+	/** Reads a section of a package file directly into the memory of the returned vector */
+	template <typename T>
+	static std::vector<T> read_package_section(std::ifstream& aStream, const package_range& aRange, uint64_t aFileSize, const std::string& aPath)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (aRange.mOffset + aRange.mSize > aFileSize || aRange.mSize % sizeof(T) != 0) {
+			throw gvk::runtime_error(fmt::format("Invalid section in package file[{}]", aPath));
+		}
+		std::vector<T> result(static_cast<size_t>(aRange.mSize / sizeof(T)));
+		aStream.seekg(static_cast<std::streamoff>(aRange.mOffset));
+		aStream.read(reinterpret_cast<char*>(result.data()), static_cast<std::streamsize>(aRange.mSize));
+		if (!aStream) {
+			throw gvk::runtime_error(fmt::format("Unable to read section from package file[{}]", aPath));
+		}
+		return result;
+	}
+
+	orca_scene_package load_orca_scene_package(const std::string& aPackagePath, avk::image_usage aImageUsage, avk::filter_mode aTextureFilterMode, avk::border_handling_mode aBorderHandlingMode, avk::sync aSyncHandler)
+	{
+		std::ifstream stream(aPackagePath, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+		if (!stream.good()) {
+			throw gvk::runtime_error(fmt::format("Unable to load scene package from path[{}]", aPackagePath));
+		}
+		const auto fileSize = static_cast<uint64_t>(stream.tellg());
+		stream.seekg(0);
+
+		package_header header{};
+		if (fileSize < sizeof(header) || !stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.mMagic != sPackageMagic) {
+			throw gvk::runtime_error(fmt::format("The file[{}] is not a scene package", aPackagePath));
+		}
+		if (header.mVersion != sPackageVersion) {
+			throw gvk::runtime_error(fmt::format("The scene package[{}] has version {}, but version {} is required. Please bake it again.", aPackagePath, header.mVersion, sPackageVersion));
+		}
+
+		orca_scene_package result;
+
+		scene_batch_data batchData;
+		batchData.mPositions = read_package_section<glm::vec3>(stream, header.mPositions, fileSize, aPackagePath);
+		batchData.mTexCoords = read_package_section<glm::vec2>(stream, header.mTexCoords, fileSize, aPackagePath);
+		batchData.mNormals = read_package_section<glm::vec3>(stream, header.mNormals, fileSize, aPackagePath);
+		batchData.mIndices = read_package_section<uint32_t>(stream, header.mIndices, fileSize, aPackagePath);
+		batchData.mDrawCommands = read_package_section<vk::DrawIndexedIndirectCommand>(stream, header.mDrawCommands, fileSize, aPackagePath);
+		batchData.mDrawData = read_package_section<scene_batch_draw_data>(stream, header.mDrawData, fileSize, aPackagePath);
+		result.mInstanceTransforms = read_package_section<glm::mat4>(stream, header.mInstanceTransforms, fileSize, aPackagePath);
+		result.mMaterials = read_package_section<material_gpu_data>(stream, header.mMaterials, fileSize, aPackagePath);
+		const auto models = read_package_section<package_model>(stream, header.mModels, fileSize, aPackagePath);
+		const auto textures = read_package_section<package_texture>(stream, header.mTextures, fileSize, aPackagePath);
+		const auto textureLevels = read_package_section<package_range>(stream, header.mTextureLevels, fileSize, aPackagePath);
+		const auto textureData = read_package_section<uint8_t>(stream, header.mTextureData, fileSize, aPackagePath);
+		result.mDirLightsData = read_package_section<direct_light_data>(stream, header.mDirLights, fileSize, aPackagePath);
+		result.mPointLightsData = read_package_section<point_light_data>(stream, header.mPointLights, fileSize, aPackagePath);
+		result.mCamerasData = read_package_section<camera_data>(stream, header.mCameras, fileSize, aPackagePath);
+		const auto paths = read_package_section<package_path>(stream, header.mPaths, fileSize, aPackagePath);
+		const auto frames = read_package_section<frame_data>(stream, header.mFrames, fileSize, aPackagePath);
+		const auto strings = read_package_section<char>(stream, header.mStrings, fileSize, aPackagePath);
+
+		auto getString = [&strings, &aPackagePath](const package_range& bRange) {
+			if (bRange.mOffset + bRange.mSize > strings.size()) {
+				throw gvk::runtime_error(fmt::format("Invalid string in package file[{}]", aPackagePath));
+			}
+			return std::string(strings.data() + bRange.mOffset, static_cast<size_t>(bRange.mSize));
+		};
+		for (const auto& pm : models) {
+			result.mModels.push_back(orca_scene_package_model{ getString(pm.mName), getString(pm.mFileName), pm.mFirstInstance, pm.mInstanceCount, pm.mFirstDrawCommand, pm.mDrawCommandCount });
+		}
+		for (const auto& pp : paths) {
+			auto& path = result.mPathsData.emplace_back();
+			path.mName = getString(pp.mName);
+			path.mLoop = pp.mLoop != 0u;
+			if (pp.mFirstFrame + pp.mNumFrames > frames.size()) {
+				throw gvk::runtime_error(fmt::format("Invalid path in package file[{}]", aPackagePath));
+			}
+			path.mFrames.assign(frames.begin() + pp.mFirstFrame, frames.begin() + pp.mFirstFrame + pp.mNumFrames);
+		}
+
+		// Upload everything, where only the last upload gets the main sync handler:
+		const auto numUploads = 4;
+		auto getSync = [numUploads, &aSyncHandler, lSyncCount = size_t{0}] () mutable -> avk::sync {
+			++lSyncCount;
+			if (lSyncCount < numUploads) {
+				return avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {});
+			}
+			assert (lSyncCount == numUploads);
+			return std::move(aSyncHandler);
+		};
+
+		result.mBatch = create_scene_batch(batchData, {}, getSync());
+		result.mDrawData = std::move(batchData.mDrawData);
+
+		result.mInstanceTransformsBuffer = context().create_buffer(
+			avk::memory_usage::device, {},
+			avk::storage_buffer_meta::create_from_data(result.mInstanceTransforms)
+		);
+		result.mInstanceTransformsBuffer->fill(result.mInstanceTransforms.data(), 0, getSync());
+
+		result.mMaterialsBuffer = context().create_buffer(
+			avk::memory_usage::device, {},
+			avk::storage_buffer_meta::create_from_data(result.mMaterials)
+		);
+		result.mMaterialsBuffer->fill(result.mMaterials.data(), 0, getSync());
+
+		// All textures are uploaded with one submission, since their levels are in memory already:
+		texture_upload_batch uploadBatch;
+		for (const auto& tex : textures) {
+			const bool levelsValid = tex.mNumLevels > 0u && tex.mFirstLevel + tex.mNumLevels <= textureLevels.size()
+				&& std::all_of(textureLevels.begin() + tex.mFirstLevel, textureLevels.begin() + tex.mFirstLevel + tex.mNumLevels, [&textureData](const package_range& bLevel) {
+					return bLevel.mOffset + bLevel.mSize <= textureData.size();
+				});
+			if (!levelsValid) {
+				throw gvk::runtime_error(fmt::format("Invalid texture in package file[{}]", aPackagePath));
+			}
+			std::vector<std::tuple<const void*, size_t>> levels;
+			for (uint32_t level = tex.mFirstLevel; level < tex.mFirstLevel + tex.mNumLevels; ++level) {
+				levels.emplace_back(textureData.data() + textureLevels[level].mOffset, static_cast<size_t>(textureLevels[level].mSize));
+			}
+			uploadBatch.add_image(tex.mWidth, tex.mHeight, tex.mFormat, aImageUsage, levels);
+		}
+		auto images = uploadBatch.submit(getSync());
+
+		result.mImageSamplers.reserve(images.size());
+		for (size_t i = 0; i < images.size(); ++i) {
+			result.mImageSamplers.push_back(
+				context().create_image_sampler(
+					context().create_image_view(std::move(images[i])),
+					textures[i].mIsReplacement != 0u
+						? context().create_sampler(avk::filter_mode::nearest_neighbor, avk::border_handling_mode::repeat)
+						: context().create_sampler(aTextureFilterMode, aBorderHandlingMode)
+				)
+			);
+		}
+
+		LOG_DEBUG(fmt::format("Loaded scene package[{}] with {} draw commands, {} materials, and {} textures.", aPackagePath, result.mBatch.mNumDrawCommands, result.mMaterials.size(), result.mImageSamplers.size()));
+		return result;
+	}
+}
@@ -0,0 +1,202 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	scene_batch_data get_scene_batch_data(
+		const std::vector<std::tuple<std::reference_wrapper<const model_t>, std::vector<size_t>>>& aModelsAndSelectedMeshes,
+		std::function<uint32_t(const model_t&, mesh_index_t)> aMaterialIndexGetter,
+		std::function<uint32_t(size_t, const model_t&, mesh_index_t)> aTransformIndexGetter,
+		bool aFlipTexCoords)
+	{
+		assert(aMaterialIndexGetter);
+		scene_batch_data result;
+
+		for (size_t s = 0; s < aModelsAndSelectedMeshes.size(); ++s) {
+			const auto& modelRef = std::get<std::reference_wrapper<const model_t>>(aModelsAndSelectedMeshes[s]);
+			const model_t& model = modelRef.get();
+			for (auto meshIndex : std::get<std::vector<size_t>>(aModelsAndSelectedMeshes[s])) {
+				const auto firstVertex = static_cast<int32_t>(result.mPositions.size());
+				const auto firstIndex = static_cast<uint32_t>(result.mIndices.size());
+
+				auto positions = model.positions_for_mesh(meshIndex);
+				const auto bounds = compute_bounding_box(positions);
+
+				// Append the vertex data unmodified. The indices stay relative to their mesh, because
+				// the draw command's vertexOffset accounts for the vertices which come before.
+				insert_into(result.mPositions, positions);
+				insert_into(result.mNormals, model.normals_for_mesh(meshIndex));
+				if (aFlipTexCoords) {
+					insert_into(result.mTexCoords, model.texture_coordinates_for_mesh<glm::vec2>([](const glm::vec2& aValue){ return glm::vec2{aValue.x, 1.0f - aValue.y}; }, meshIndex, 0));
+				}
+				else {
+					insert_into(result.mTexCoords, model.texture_coordinates_for_mesh<glm::vec2>(meshIndex, 0));
+				}
+				// texture_coordinates_for_mesh returns one element only if there are no texture coordinates => keep the vertex attributes aligned:
+				result.mTexCoords.resize(result.mPositions.size(), glm::vec2{ 0.0f });
+				insert_into(result.mIndices, model.indices_for_mesh<uint32_t>(meshIndex));
+
+				const auto indexCount = static_cast<uint32_t>(result.mIndices.size()) - firstIndex;
+				const auto drawIndex = static_cast<uint32_t>(result.mDrawCommands.size());
+				result.mDrawCommands.emplace_back(
+					indexCount,		// indexCount
+					1u,				// instanceCount
+					firstIndex,		// firstIndex
+					firstVertex,	// vertexOffset
+					drawIndex		// firstInstance => use gl_InstanceIndex to get the scene_batch_draw_data in shaders (requires drawIndirectFirstInstance for indirect draws, c.f. draw_scene_batch)
+				);
+
+				auto& drawData = result.mDrawData.emplace_back();
+				drawData.mBoundsMin = glm::vec4{ bounds.mMin, 1.0f };
+				drawData.mBoundsMax = glm::vec4{ bounds.mMax, 1.0f };
+				drawData.mMaterialIndex = aMaterialIndexGetter(model, meshIndex);
+				drawData.mTransformIndex = aTransformIndexGetter ? aTransformIndexGetter(s, model, meshIndex) : static_cast<uint32_t>(s);
+				drawData.mPadding0 = 0u;
+				drawData.mPadding1 = 0u;
+			}
+		}
+
+		assert(result.mPositions.size() == result.mNormals.size());
+		assert(result.mPositions.size() == result.mTexCoords.size());
+		assert(result.mDrawCommands.size() == result.mDrawData.size());
+		return result;
+	}
+
+	scene_batch create_scene_batch(const scene_batch_data& aBatchData, vk::BufferUsageFlags aUsageFlags, avk::sync aSyncHandler)
+	{
+		if (aBatchData.mDrawCommands.empty()) {
+			throw gvk::runtime_error("Can not create a scene batch without any draw commands.");
+		}
+
+		scene_batch result;
+		result.mDrawCommands = aBatchData.mDrawCommands;
+		result.mNumDrawCommands = static_cast<uint32_t>(aBatchData.mDrawCommands.size());
+
+		result.mPositionsBuffer = context().create_buffer(
+			avk::memory_usage::device, aUsageFlags,
+			avk::vertex_buffer_meta::create_from_data(aBatchData.mPositions)
+				.describe_only_member(aBatchData.mPositions[0], avk::content_description::position)
+		);
+		result.mPositionsBuffer->fill(aBatchData.mPositions.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+
+		result.mTexCoordsBuffer = context().create_buffer(
+			avk::memory_usage::device, aUsageFlags,
+			avk::vertex_buffer_meta::create_from_data(aBatchData.mTexCoords)
+		);
+		result.mTexCoordsBuffer->fill(aBatchData.mTexCoords.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+
+		result.mNormalsBuffer = context().create_buffer(
+			avk::memory_usage::device, aUsageFlags,
+			avk::vertex_buffer_meta::create_from_data(aBatchData.mNormals)
+		);
+		result.mNormalsBuffer->fill(aBatchData.mNormals.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+
+		result.mIndexBuffer = context().create_buffer(
+			avk::memory_usage::device, aUsageFlags,
+			avk::index_buffer_meta::create_from_data(aBatchData.mIndices)
+		);
+		result.mIndexBuffer->fill(aBatchData.mIndices.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+
+		// The draw commands are also usable as storage buffer, s.t. they can be modified in compute shaders (e.g. for GPU culling):
+		result.mDrawCommandsBuffer = context().create_buffer(
+			avk::memory_usage::device, vk::BufferUsageFlagBits::eIndirectBuffer,
+			avk::storage_buffer_meta::create_from_data(aBatchData.mDrawCommands)
+		);
+		result.mDrawCommandsBuffer->fill(aBatchData.mDrawCommands.data(), 0, avk::sync::auxiliary_with_barriers(aSyncHandler, avk::sync::steal_before_handler_on_demand, {}));
+
+		result.mDrawDataBuffer = context().create_buffer(
+			avk::memory_usage::device, {},
+			avk::storage_buffer_meta::create_from_data(aBatchData.mDrawData)
+		);
+		result.mDrawDataBuffer->fill(aBatchData.mDrawData.data(), 0, std::move(aSyncHandler));
+		// It is fine to let aBatchData go out of scope, since its data has been copied to
+		// staging buffers within fill, which are lifetime-handled by the command buffer.
+
+		return result;
+	}
+
+	scene_batch create_scene_batch(
+		const std::vector<std::tuple<std::reference_wrapper<const model_t>, std::vector<size_t>>>& aModelsAndSelectedMeshes,
+		std::function<uint32_t(const model_t&, mesh_index_t)> aMaterialIndexGetter,
+		std::function<uint32_t(size_t, const model_t&, mesh_index_t)> aTransformIndexGetter,
+		bool aFlipTexCoords,
+		vk::BufferUsageFlags aUsageFlags,
+		avk::sync aSyncHandler)
+	{
+		auto batchData = get_scene_batch_data(aModelsAndSelectedMeshes, std::move(aMaterialIndexGetter), std::move(aTransformIndexGetter), aFlipTexCoords);
+		return create_scene_batch(batchData, aUsageFlags, std::move(aSyncHandler));
+	}
+
+	static void bind_scene_batch_buffers(avk::command_buffer_t& aCommandBuffer, const scene_batch& aBatch)
+	{
+		const std::array<vk::Buffer, 3> vertexBuffers = {
+			aBatch.mPositionsBuffer->buffer_handle(),
+			aBatch.mTexCoordsBuffer->buffer_handle(),
+			aBatch.mNormalsBuffer->buffer_handle()
+		};
+		const std::array<vk::DeviceSize, 3> offsets = { 0, 0, 0 };
+		aCommandBuffer.handle().bindVertexBuffers(0u, static_cast<uint32_t>(vertexBuffers.size()), vertexBuffers.data(), offsets.data());
+		aCommandBuffer.handle().bindIndexBuffer(aBatch.mIndexBuffer->buffer_handle(), 0u, vk::IndexType::eUint32);
+	}
+
+	/** Returns the number of draw commands which can be issued with one vkCmdDrawIndexedIndirect, given the features which are enabled on the logical device */
+	static uint32_t max_draws_per_indirect_call()
+	{
+		if (VK_TRUE != context().requested_physical_device_features().multiDrawIndirect) {
+			return 1u;
+		}
+		return std::max(context().physical_device().getProperties().limits.maxDrawIndirectCount, 1u);
+	}
+
+	/** True if draw commands with a non-zero firstInstance may be read from an indirect buffer */
+	static bool indirect_first_instance_enabled()
+	{
+		return VK_TRUE == context().requested_physical_device_features().drawIndirectFirstInstance;
+	}
+
+	static void draw_directly(avk::command_buffer_t& aCommandBuffer, const vk::DrawIndexedIndirectCommand& aDrawCommand)
+	{
+		aCommandBuffer.handle().drawIndexed(aDrawCommand.indexCount, aDrawCommand.instanceCount, aDrawCommand.firstIndex, aDrawCommand.vertexOffset, aDrawCommand.firstInstance);
+	}
+
+	void draw_scene_batch(avk::command_buffer_t& aCommandBuffer, const scene_batch& aBatch)
+	{
+		bind_scene_batch_buffers(aCommandBuffer, aBatch);
+
+		if (!indirect_first_instance_enabled()) {
+			for (const auto& drawCommand : aBatch.mDrawCommands) {
+				draw_directly(aCommandBuffer, drawCommand);
+			}
+			return;
+		}
+
+		constexpr auto stride = static_cast<uint32_t>(sizeof(vk::DrawIndexedIndirectCommand));
+		const auto maxDrawsPerCall = max_draws_per_indirect_call();
+		for (uint32_t i = 0; i < aBatch.mNumDrawCommands; i += maxDrawsPerCall) {
+			aCommandBuffer.handle().drawIndexedIndirect(aBatch.mDrawCommandsBuffer->buffer_handle(), static_cast<vk::DeviceSize>(i) * stride, std::min(maxDrawsPerCall, aBatch.mNumDrawCommands - i), stride);
+		}
+	}
+
+	void draw_scene_batch(avk::command_buffer_t& aCommandBuffer, const scene_batch& aBatch, const std::vector<uint32_t>& aVisibleDrawIndices)
+	{
+		bind_scene_batch_buffers(aCommandBuffer, aBatch);
+
+		if (!indirect_first_instance_enabled()) {
+			for (auto drawIndex : aVisibleDrawIndices) {
+				draw_directly(aCommandBuffer, aBatch.mDrawCommands[drawIndex]);
+			}
+			return;
+		}
+
+		constexpr auto stride = static_cast<uint32_t>(sizeof(vk::DrawIndexedIndirectCommand));
+		const auto maxDrawsPerCall = static_cast<size_t>(max_draws_per_indirect_call());
+		for (size_t i = 0; i < aVisibleDrawIndices.size();) {
+			// Consecutive draw commands can be issued with one call:
+			size_t runEnd = i + 1;
+			while (runEnd - i < maxDrawsPerCall && runEnd < aVisibleDrawIndices.size() && aVisibleDrawIndices[runEnd] == aVisibleDrawIndices[runEnd - 1] + 1) {
+				++runEnd;
+			}
+			aCommandBuffer.handle().drawIndexedIndirect(aBatch.mDrawCommandsBuffer->buffer_handle(), static_cast<vk::DeviceSize>(aVisibleDrawIndices[i]) * stride, static_cast<uint32_t>(runEnd - i), stride);
+			i = runEnd;
+		}
+	}
+}
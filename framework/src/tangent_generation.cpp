@@ -0,0 +1,92 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	static inline bool not_zero(float aValue)
+	{
+		return glm::abs(aValue) > std::numeric_limits<float>::min();
+	}
+
+	/** Projects aVector into the plane with the given normal and normalizes it, if possible. */
+	static inline glm::vec3 project_and_normalize(const glm::vec3& aVector, const glm::vec3& aNormal)
+	{
+		const glm::vec3 projected = aVector - glm::dot(aNormal, aVector) * aNormal;
+		const float len = glm::length(projected);
+		return not_zero(len) ? projected / len : projected;
+	}
+
+	std::vector<glm::vec4> generate_tangents_with_handedness(const aiMesh* aMesh, int aTexCoordSet)
+	{
+		assert(nullptr != aMesh);
+		assert(aTexCoordSet >= 0 && aTexCoordSet < AI_MAX_NUMBER_OF_TEXTURECOORDS);
+		if (nullptr == aMesh->mNormals || nullptr == aMesh->mTextureCoords[aTexCoordSet]) {
+			return {};
+		}
+
+		const auto n = aMesh->mNumVertices;
+		auto pos = [aMesh](unsigned int aIndex) { const auto& v = aMesh->mVertices[aIndex]; return glm::vec3{ v.x, v.y, v.z }; };
+		auto nrm = [aMesh](unsigned int aIndex) {
+			const auto& v = aMesh->mNormals[aIndex];
+			const glm::vec3 normal{ v.x, v.y, v.z };
+			const float len = glm::length(normal);
+			return not_zero(len) ? normal / len : glm::vec3{ 0.0f, 0.0f, 1.0f };
+		};
+		auto tex = [aMesh, aTexCoordSet](unsigned int aIndex) { const auto& v = aMesh->mTextureCoords[aTexCoordSet][aIndex]; return glm::vec2{ v.x, v.y }; };
+
+		// Accumulated, angle-weighted tangents per vertex; separately for orientation-preserving
+		// and for orientation-reversing triangles, because MikkTSpace never mixes them:
+		std::vector<glm::vec3> accumulated[2] = { std::vector<glm::vec3>(n, glm::vec3{ 0.0f }), std::vector<glm::vec3>(n, glm::vec3{ 0.0f }) };
+		std::vector<float> angleSums[2] = { std::vector<float>(n, 0.0f), std::vector<float>(n, 0.0f) };
+
+		for (unsigned int f = 0; f < aMesh->mNumFaces; ++f) {
+			const aiFace& face = aMesh->mFaces[f];
+			if (3 != face.mNumIndices) {
+				continue; // Points and lines do not have a tangent space; polygons must be triangulated
+			}
+			const unsigned int idx[3] = { face.mIndices[0], face.mIndices[1], face.mIndices[2] };
+			const glm::vec3 p[3] = { pos(idx[0]), pos(idx[1]), pos(idx[2]) };
+			const glm::vec2 t[3] = { tex(idx[0]), tex(idx[1]), tex(idx[2]) };
+
+			const glm::vec2 t21 = t[1] - t[0];
+			const glm::vec2 t31 = t[2] - t[0];
+			const glm::vec3 d1 = p[1] - p[0];
+			const glm::vec3 d2 = p[2] - p[0];
+			const float signedAreaSTx2 = t21.x * t31.y - t21.y * t31.x;
+			if (!not_zero(signedAreaSTx2)) {
+				continue; // Degenerate in texture space => no contribution
+			}
+			const int orientation = signedAreaSTx2 > 0.0f ? 0 : 1;
+			// Direction of increasing u, i.e. (t31.y * d1 - t21.y * d2) / signedAreaSTx2 without the magnitude:
+			const glm::vec3 triangleTangent = (0 == orientation ? 1.0f : -1.0f) * (t31.y * d1 - t21.y * d2);
+
+			for (int c = 0; c < 3; ++c) {
+				const auto i = idx[c];
+				const glm::vec3 normal = nrm(i);
+				const glm::vec3 e1 = project_and_normalize(p[(c + 2) % 3] - p[c], normal);
+				const glm::vec3 e2 = project_and_normalize(p[(c + 1) % 3] - p[c], normal);
+				const float angle = glm::acos(glm::clamp(glm::dot(e1, e2), -1.0f, 1.0f));
+				accumulated[orientation][i] += angle * project_and_normalize(triangleTangent, normal);
+				angleSums[orientation][i] += angle;
+			}
+		}
+
+		std::vector<glm::vec4> result;
+		result.reserve(n);
+		for (unsigned int i = 0; i < n; ++i) {
+			const int orientation = angleSums[0][i] >= angleSums[1][i] ? 0 : 1;
+			glm::vec3 tangent = accumulated[orientation][i];
+			const float len = glm::length(tangent);
+			if (not_zero(len)) {
+				tangent /= len;
+			}
+			else {
+				// No usable contribution => any vector perpendicular to the normal will do:
+				const glm::vec3 normal = nrm(i);
+				const glm::vec3 helper = glm::abs(normal.x) < 0.9f ? glm::vec3{ 1.0f, 0.0f, 0.0f } : glm::vec3{ 0.0f, 1.0f, 0.0f };
+				tangent = glm::normalize(glm::cross(helper, normal));
+			}
+			result.emplace_back(tangent, 0 == orientation ? 1.0f : -1.0f);
+		}
+		return result;
+	}
+}
@@ -0,0 +1,89 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	std::optional<avk::image_view> texture_cache::try_acquire(const texture_cache_key& aKey)
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		auto it = mEntries.find(aKey);
+		if (std::end(mEntries) == it) {
+			return {};
+		}
+		++it->second.mReferenceCount;
+		return it->second.mImageView;
+	}
+
+	avk::image_view texture_cache::insert(const texture_cache_key& aKey, avk::image_view aImageView)
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		auto [it, inserted] = mEntries.try_emplace(aKey, entry{ {}, 0 });
+		if (inserted) {
+			aImageView.enable_shared_ownership(); // The cache and all the users share this image view
+			it->second.mImageView = std::move(aImageView);
+			mKeysOfImageViews.emplace(static_cast<VkImageView>(it->second.mImageView->handle()), aKey);
+		}
+		++it->second.mReferenceCount;
+		return it->second.mImageView;
+	}
+
+	avk::image_view texture_cache::acquire(const texture_cache_key& aKey, const std::function<avk::image_view()>& aCreateImageView)
+	{
+		auto cached = try_acquire(aKey);
+		if (cached.has_value()) {
+			return std::move(cached.value());
+		}
+		return insert(aKey, aCreateImageView());
+	}
+
+	void texture_cache::release(const avk::image_view& aImageView)
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		auto keyIt = mKeysOfImageViews.find(static_cast<VkImageView>(aImageView->handle()));
+		if (std::end(mKeysOfImageViews) == keyIt) {
+			return;
+		}
+		auto it = mEntries.find(keyIt->second);
+		assert(std::end(mEntries) != it);
+		if (--it->second.mReferenceCount == 0) {
+			LOG_DEBUG(fmt::format("Texture[{}] is not referenced anymore and removed from the texture cache.", it->first.mPath));
+			mKeysOfImageViews.erase(keyIt);
+			mEntries.erase(it);
+		}
+	}
+
+	size_t texture_cache::reference_count(const texture_cache_key& aKey) const
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		auto it = mEntries.find(aKey);
+		return std::end(mEntries) == it ? 0 : it->second.mReferenceCount;
+	}
+
+	size_t texture_cache::size() const
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		return mEntries.size();
+	}
+
+	void texture_cache::clear()
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		mKeysOfImageViews.clear();
+		mEntries.clear();
+	}
+
+	avk::image_view create_image_view_from_file_cached(const std::string& aPath, vk::Format aFormat, bool aFlip, avk::image_usage aImageUsage, avk::sync aSyncHandler, texture_cache& aTextureCache)
+	{
+		const texture_cache_key key{ avk::clean_up_path(aPath), aFormat, false, aFlip, aImageUsage };
+		return aTextureCache.acquire(key, [&key, &aSyncHandler]() {
+			return context().create_image_view(create_image_from_file(key.mPath, key.mFormat, key.mFlip, avk::memory_usage::device, key.mImageUsage, std::move(aSyncHandler)));
+		});
+	}
+
+	avk::image_view create_image_view_from_file_cached(const std::string& aPath, bool aLoadSrgbIfApplicable, bool aFlip, avk::image_usage aImageUsage, avk::sync aSyncHandler, texture_cache& aTextureCache)
+	{
+		const texture_cache_key key{ avk::clean_up_path(aPath), vk::Format::eUndefined, aLoadSrgbIfApplicable, aFlip, aImageUsage };
+		return aTextureCache.acquire(key, [&key, &aSyncHandler]() {
+			return context().create_image_view(create_image_from_decoded_image(decode_image_file(key.mPath, true, key.mSrgb, key.mFlip, 4), avk::memory_usage::device, key.mImageUsage, std::move(aSyncHandler)));
+		});
+	}
+}
@@ -0,0 +1,180 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	// Every level starts at a multiple of this, which is a multiple of every texel block size and of 4, as required by vkCmdCopyBufferToImage:
+	static constexpr size_t sStagingLevelAlignment = 16;
+
+	// Size of the first block of the staging arena, every further block is twice as large as the previous one:
+	static constexpr size_t sInitialArenaBlockSize = 4 * 1024 * 1024;
+
+	static size_t align_staging_offset(size_t aOffset)
+	{
+		return (aOffset + sStagingLevelAlignment - 1) / sStagingLevelAlignment * sStagingLevelAlignment;
+	}
+
+	texture_upload_batch::texture_upload_batch(size_t aMaxArenaBlockSize)
+		: mMaxArenaBlockSize{ aMaxArenaBlockSize }
+	{
+	}
+
+	texture_upload_batch::~texture_upload_batch()
+	{
+		unmap_arena();
+	}
+
+	void texture_upload_batch::unmap_arena()
+	{
+		for (auto& block : mArena) {
+			if (nullptr != block.mMapped) {
+				context().device().unmapMemory(block.mBuffer->memory_handle());
+				block.mMapped = nullptr;
+			}
+		}
+	}
+
+	std::tuple<size_t, size_t> texture_upload_batch::allocate(size_t aSize)
+	{
+		if (mArena.empty() || align_staging_offset(mArena.back().mUsed) + aSize > mArena.back().mSize) {
+			const auto grownSize = mArena.empty() ? sInitialArenaBlockSize : 2 * mArena.back().mSize;
+			const auto blockSize = std::max(std::min(grownSize, mMaxArenaBlockSize), aSize);
+			auto buffer = context().create_buffer(
+				avk::memory_usage::host_coherent,
+				vk::BufferUsageFlagBits::eTransferSrc,
+				avk::generic_buffer_meta::create_from_size(blockSize)
+			);
+			auto* mapped = static_cast<uint8_t*>(context().device().mapMemory(buffer->memory_handle(), 0, VK_WHOLE_SIZE));
+			mArena.push_back(arena_block{ std::move(buffer), mapped, blockSize, 0 });
+		}
+		auto& block = mArena.back();
+		const auto offset = align_staging_offset(block.mUsed);
+		block.mUsed = offset + aSize;
+		return std::make_tuple(mArena.size() - 1, offset);
+	}
+
+	size_t texture_upload_batch::staging_size() const
+	{
+		size_t result = 0;
+		for (const auto& block : mArena) {
+			result += block.mUsed;
+		}
+		return result;
+	}
+
+	size_t texture_upload_batch::add_image(uint32_t aWidth, uint32_t aHeight, vk::Format aFormat, avk::image_usage aImageUsage, const std::vector<std::tuple<const void*, size_t>>& aLevels)
+	{
+		if (aLevels.empty()) {
+			throw gvk::runtime_error("Can not upload an image without any data.");
+		}
+
+		auto img = context().create_image(aWidth, aHeight, aFormat, 1, avk::memory_usage::device, aImageUsage);
+		const auto numLevels = std::min(static_cast<uint32_t>(aLevels.size()), img->config().mipLevels);
+
+		// All levels of an image are stored consecutively in one block, since they are copied with one command:
+		size_t totalSize = 0;
+		for (uint32_t level = 0; level < numLevels; ++level) {
+			totalSize = align_staging_offset(totalSize) + std::get<size_t>(aLevels[level]);
+		}
+		const auto [blockIndex, offset] = allocate(totalSize);
+		auto* mapped = mArena[blockIndex].mMapped;
+
+		pending_upload upload{ std::move(img), blockIndex, {}, false };
+		auto levelOffset = offset;
+		for (uint32_t level = 0; level < numLevels; ++level) {
+			const auto [data, size] = aLevels[level];
+			levelOffset = align_staging_offset(levelOffset);
+			memcpy(mapped + levelOffset, data, size);
+			upload.mRegions.push_back(vk::BufferImageCopy{}
+				.setBufferOffset(static_cast<vk::DeviceSize>(levelOffset))
+				.setImageSubresource(vk::ImageSubresourceLayers{ vk::ImageAspectFlagBits::eColor, level, 0u, 1u })
+				.setImageExtent(vk::Extent3D{ std::max(aWidth >> level, 1u), std::max(aHeight >> level, 1u), 1u })
+			);
+			levelOffset += size;
+		}
+		// Block-compressed formats can not be blitted, i.e. their MIP levels must be given:
+		upload.mGenerateMipMaps = upload.mImage->config().mipLevels > 1u && 1u == numLevels && !avk::is_block_compressed_format(aFormat);
+
+		mUploads.push_back(std::move(upload));
+		return mUploads.size() - 1;
+	}
+
+	size_t texture_upload_batch::add_decoded_image(const decoded_image& aImage, avk::image_usage aImageUsage)
+	{
+		std::vector<std::tuple<const void*, size_t>> levels;
+		if (aImage.mGliTexture.has_value()) {
+			const auto& gliTex = aImage.mGliTexture.value();
+			for (size_t level = 0; level < gliTex.levels(); ++level) {
+				levels.emplace_back(gliTex.data(0, 0, level), gliTex.size(level));
+			}
+		}
+		else {
+			levels.emplace_back(aImage.mPixels.get(), aImage.mPixelsSize);
+		}
+		return add_image(static_cast<uint32_t>(aImage.mWidth), static_cast<uint32_t>(aImage.mHeight), aImage.mFormat, aImageUsage, levels);
+	}
+
+	size_t texture_upload_batch::add_1px_texture(std::array<uint8_t, 4> aColor, vk::Format aFormat, avk::image_usage aImageUsage)
+	{
+		return add_image(1u, 1u, aFormat, aImageUsage, { std::make_tuple(static_cast<const void*>(aColor.data()), sizeof(aColor)) });
+	}
+
+	std::vector<avk::image> texture_upload_batch::submit(avk::sync aSyncHandler)
+	{
+		// The arena is host-coherent => no flush is required before the device reads it:
+		unmap_arena();
+
+		auto& commandBuffer = aSyncHandler.get_or_create_command_buffer();
+		aSyncHandler.establish_barrier_before_the_operation(avk::pipeline_stage::transfer, avk::read_memory_access{avk::memory_access::transfer_read_access});
+
+		// 1. Transition every image to eTransferDstOptimal and copy all of its given levels with one command:
+		std::vector<vk::ImageLayout> finalTargetLayouts;
+		finalTargetLayouts.reserve(mUploads.size());
+		for (auto& upload : mUploads) {
+			finalTargetLayouts.push_back(upload.mImage->target_layout()); // save for later, because first, we need to transfer something into it
+			upload.mImage->transition_to_layout(vk::ImageLayout::eTransferDstOptimal, avk::sync::auxiliary_with_barriers(aSyncHandler, {}, {}));
+			commandBuffer.handle().copyBufferToImage(
+				mArena[upload.mBlockIndex].mBuffer->buffer_handle(), upload.mImage->handle(), vk::ImageLayout::eTransferDstOptimal,
+				static_cast<uint32_t>(upload.mRegions.size()), upload.mRegions.data()
+			);
+		}
+
+		// 2. Create the remaining MIP levels via BLIT where required:
+		for (auto& upload : mUploads) {
+			if (!upload.mGenerateMipMaps) {
+				continue;
+			}
+			auto& img = upload.mImage;
+			img->generate_mip_maps(avk::sync::auxiliary_with_barriers(aSyncHandler,
+				// We have to sync the copy with generate_mip_maps:
+				[&img](avk::command_buffer_t& cb, avk::pipeline_stage dstStage, std::optional<avk::read_memory_access> dstAccess){
+					cb.establish_image_memory_barrier_rw(img,
+						avk::pipeline_stage::transfer, /* transfer -> transfer */ dstStage,
+						avk::write_memory_access{ avk::memory_access::transfer_write_access }, /* -> */ dstAccess
+					);
+				},
+				{})
+			);
+		}
+
+		// 3. Transition every image to its target layout:
+		for (size_t i = 0; i < mUploads.size(); ++i) {
+			mUploads[i].mImage->transition_to_layout(finalTargetLayouts[i], avk::sync::auxiliary_with_barriers(aSyncHandler, {}, {}));
+		}
+
+		LOG_DEBUG(fmt::format("Uploading {} images with {} bytes of staging memory in one submission.", mUploads.size(), staging_size()));
+		commandBuffer.set_custom_deleter([lOwnedArena = std::move(mArena)](){});
+		mArena.clear();
+
+		aSyncHandler.establish_barrier_after_the_operation(avk::pipeline_stage::transfer, avk::write_memory_access{ avk::memory_access::transfer_write_access });
+		auto syncResult = aSyncHandler.submit_and_sync();
+		assert(!syncResult.has_value());
+
+		std::vector<avk::image> result;
+		result.reserve(mUploads.size());
+		for (auto& upload : mUploads) {
+			result.push_back(std::move(upload.mImage));
+		}
+		mUploads.clear();
+		return result;
+	}
+}
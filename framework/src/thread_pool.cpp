@@ -0,0 +1,72 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	thread_pool::thread_pool(uint32_t aNumWorkers)
+	{
+		if (0 == aNumWorkers) {
+			const auto hw = std::thread::hardware_concurrency();
+			aNumWorkers = hw > 1 ? hw - 1 : 1;
+		}
+		mWorkers.reserve(aNumWorkers);
+		for (uint32_t i = 0; i < aNumWorkers; ++i) {
+			mWorkers.emplace_back([this]() { worker_loop(); });
+		}
+	}
+
+	thread_pool::~thread_pool()
+	{
+		{
+			std::scoped_lock<std::mutex> guard(mMutex);
+			mStopRequested = true;
+		}
+		mCondition.notify_all();
+		for (auto& worker : mWorkers) {
+			if (worker.joinable()) {
+				worker.join();
+			}
+		}
+	}
+
+	void thread_pool::enqueue(std::function<void()> aTask)
+	{
+		{
+			std::scoped_lock<std::mutex> guard(mMutex);
+			mTasks.push_back(std::move(aTask));
+		}
+		mCondition.notify_one();
+	}
+
+	bool thread_pool::try_execute_one_pending_task()
+	{
+		std::function<void()> task;
+		{
+			std::scoped_lock<std::mutex> guard(mMutex);
+			if (mTasks.empty()) {
+				return false;
+			}
+			task = std::move(mTasks.front());
+			mTasks.pop_front();
+		}
+		task();
+		return true;
+	}
+
+	void thread_pool::worker_loop()
+	{
+		for (;;) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mCondition.wait(lock, [this]() { return mStopRequested || !mTasks.empty(); });
+				// Finish all pending tasks before stopping:
+				if (mTasks.empty()) {
+					return;
+				}
+				task = std::move(mTasks.front());
+				mTasks.pop_front();
+			}
+			task();
+		}
+	}
+}
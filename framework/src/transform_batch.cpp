@@ -0,0 +1,414 @@
+#include <gvk.hpp>
+#include "simd_target.hpp"
+
+#if defined(GVK_SIMD_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace gvk
+{
+	// The SIMD implementations load and store the quaternions' components as x, y, z, w:
+	static_assert(sizeof(glm::quat) == 4 * sizeof(float), "Unexpected glm::quat layout");
+	static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "Unexpected glm::vec3 layout");
+	static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "Unexpected glm::mat4 layout");
+
+	static void matrices_from_transforms_scalar(const glm::vec3* aTranslations, const glm::quat* aRotations, const glm::vec3* aScales, size_t aCount, glm::mat4* aMatricesOut)
+	{
+		for (size_t i = 0; i < aCount; ++i) {
+			aMatricesOut[i] = matrix_from_transforms(aTranslations[i], aRotations[i], aScales[i]);
+		}
+	}
+
+	static void transforms_from_matrices_scalar(const glm::mat4* aMatrices, size_t aCount, glm::vec3* aTranslationsOut, glm::quat* aRotationsOut, glm::vec3* aScalesOut)
+	{
+		for (size_t i = 0; i < aCount; ++i) {
+			std::tie(aTranslationsOut[i], aRotationsOut[i], aScalesOut[i]) = transforms_from_matrix(aMatrices[i]);
+		}
+	}
+
+#if defined(GVK_SIMD_X86)
+	/** Loads the components of four vec3s into one register per component. */
+	static inline void load_vec3s_sse(const glm::vec3* aSrc, __m128& aX, __m128& aY, __m128& aZ)
+	{
+		aX = _mm_setr_ps(aSrc[0].x, aSrc[1].x, aSrc[2].x, aSrc[3].x);
+		aY = _mm_setr_ps(aSrc[0].y, aSrc[1].y, aSrc[2].y, aSrc[3].y);
+		aZ = _mm_setr_ps(aSrc[0].z, aSrc[1].z, aSrc[2].z, aSrc[3].z);
+	}
+
+	/** Stores one register per component into four vec3s. */
+	static inline void store_vec3s_sse(__m128 aX, __m128 aY, __m128 aZ, glm::vec3* aDst)
+	{
+		__m128 w = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(aX, aY, aZ, w);
+		float tmp[4];
+		_mm_storeu_ps(tmp, aX); aDst[0] = glm::vec3{ tmp[0], tmp[1], tmp[2] };
+		_mm_storeu_ps(tmp, aY); aDst[1] = glm::vec3{ tmp[0], tmp[1], tmp[2] };
+		_mm_storeu_ps(tmp, aZ); aDst[2] = glm::vec3{ tmp[0], tmp[1], tmp[2] };
+		_mm_storeu_ps(tmp, w);  aDst[3] = glm::vec3{ tmp[0], tmp[1], tmp[2] };
+	}
+
+	/** Loads four vec4-sized elements (quaternions or matrix columns) and transposes them into one register per component. */
+	static inline void load_vec4s_sse(const float* aSrc0, const float* aSrc1, const float* aSrc2, const float* aSrc3, __m128& aX, __m128& aY, __m128& aZ, __m128& aW)
+	{
+		aX = _mm_loadu_ps(aSrc0);
+		aY = _mm_loadu_ps(aSrc1);
+		aZ = _mm_loadu_ps(aSrc2);
+		aW = _mm_loadu_ps(aSrc3);
+		_MM_TRANSPOSE4_PS(aX, aY, aZ, aW);
+	}
+
+	/** Transposes one register per component back into four vec4-sized elements and stores them. */
+	static inline void store_vec4s_sse(__m128 aX, __m128 aY, __m128 aZ, __m128 aW, float* aDst0, float* aDst1, float* aDst2, float* aDst3)
+	{
+		_MM_TRANSPOSE4_PS(aX, aY, aZ, aW);
+		_mm_storeu_ps(aDst0, aX);
+		_mm_storeu_ps(aDst1, aY);
+		_mm_storeu_ps(aDst2, aZ);
+		_mm_storeu_ps(aDst3, aW);
+	}
+
+	GVK_TARGET("sse4.1")
+	static void matrices_from_transforms_sse4_1(const glm::vec3* aTranslations, const glm::quat* aRotations, const glm::vec3* aScales, size_t aCount, glm::mat4* aMatricesOut)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		size_t i = 0;
+		for (; i + 4 <= aCount; i += 4) {
+			__m128 qx, qy, qz, qw, tx, ty, tz, sx, sy, sz;
+			load_vec4s_sse(&aRotations[i].x, &aRotations[i + 1].x, &aRotations[i + 2].x, &aRotations[i + 3].x, qx, qy, qz, qw);
+			load_vec3s_sse(aTranslations + i, tx, ty, tz);
+			load_vec3s_sse(aScales + i, sx, sy, sz);
+
+			// x = aRotation * (1, 0, 0) and y = aRotation * (0, 1, 0), c.f. matrix_from_transforms:
+			const __m128 xx = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qy, qy), _mm_mul_ps(qz, qz))));
+			const __m128 xy = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qx, qy), _mm_mul_ps(qz, qw)));
+			const __m128 xz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, qz), _mm_mul_ps(qy, qw)));
+			__m128 yx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, qy), _mm_mul_ps(qz, qw)));
+			__m128 yy = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qx, qx))));
+			__m128 yz = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qy, qz), _mm_mul_ps(qx, qw)));
+			// z = cross(x, y), y = cross(z, x):
+			const __m128 zx = _mm_sub_ps(_mm_mul_ps(xy, yz), _mm_mul_ps(xz, yy));
+			const __m128 zy = _mm_sub_ps(_mm_mul_ps(xz, yx), _mm_mul_ps(xx, yz));
+			const __m128 zz = _mm_sub_ps(_mm_mul_ps(xx, yy), _mm_mul_ps(xy, yx));
+			yx = _mm_sub_ps(_mm_mul_ps(zy, xz), _mm_mul_ps(zz, xy));
+			yy = _mm_sub_ps(_mm_mul_ps(zz, xx), _mm_mul_ps(zx, xz));
+			yz = _mm_sub_ps(_mm_mul_ps(zx, xy), _mm_mul_ps(zy, xx));
+
+			const __m128 columns[4][4] = {
+				{ _mm_mul_ps(xx, sx), _mm_mul_ps(xy, sx), _mm_mul_ps(xz, sx), zero },
+				{ _mm_mul_ps(yx, sy), _mm_mul_ps(yy, sy), _mm_mul_ps(yz, sy), zero },
+				{ _mm_mul_ps(zx, sz), _mm_mul_ps(zy, sz), _mm_mul_ps(zz, sz), zero },
+				{ tx, ty, tz, one }
+			};
+			auto* out = aMatricesOut + i;
+			for (glm::length_t c = 0; c < 4; ++c) {
+				store_vec4s_sse(columns[c][0], columns[c][1], columns[c][2], columns[c][3], &out[0][c].x, &out[1][c].x, &out[2][c].x, &out[3][c].x);
+			}
+		}
+		matrices_from_transforms_scalar(aTranslations + i, aRotations + i, aScales + i, aCount - i, aMatricesOut + i);
+	}
+
+	GVK_TARGET("sse4.1")
+	static void transforms_from_matrices_sse4_1(const glm::mat4* aMatrices, size_t aCount, glm::vec3* aTranslationsOut, glm::quat* aRotationsOut, glm::vec3* aScalesOut)
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 quarter = _mm_set1_ps(0.25f);
+		size_t i = 0;
+		for (; i + 4 <= aCount; i += 4) {
+			// m[c][r] => column c, row r; the fourth row is ignored:
+			__m128 m[4][4];
+			for (glm::length_t c = 0; c < 4; ++c) {
+				load_vec4s_sse(&aMatrices[i][c].x, &aMatrices[i + 1][c].x, &aMatrices[i + 2][c].x, &aMatrices[i + 3][c].x, m[c][0], m[c][1], m[c][2], m[c][3]);
+			}
+
+			__m128 s[3];
+			for (int c = 0; c < 3; ++c) {
+				s[c] = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[c][0], m[c][0]), _mm_mul_ps(m[c][1], m[c][1])), _mm_mul_ps(m[c][2], m[c][2])));
+				for (int r = 0; r < 3; ++r) {
+					m[c][r] = _mm_div_ps(m[c][r], s[c]);
+				}
+			}
+
+			// Branchless version of glm::quat_cast, which selects the largest of the four candidates:
+			const __m128 fourX = _mm_sub_ps(_mm_sub_ps(m[0][0], m[1][1]), m[2][2]);
+			const __m128 fourY = _mm_sub_ps(_mm_sub_ps(m[1][1], m[0][0]), m[2][2]);
+			const __m128 fourZ = _mm_sub_ps(_mm_sub_ps(m[2][2], m[0][0]), m[1][1]);
+			__m128 biggest = _mm_add_ps(_mm_add_ps(m[0][0], m[1][1]), m[2][2]);
+			const __m128 selX = _mm_cmpgt_ps(fourX, biggest);
+			biggest = _mm_blendv_ps(biggest, fourX, selX);
+			const __m128 selY = _mm_cmpgt_ps(fourY, biggest);
+			biggest = _mm_blendv_ps(biggest, fourY, selY);
+			const __m128 selZ = _mm_cmpgt_ps(fourZ, biggest);
+			biggest = _mm_blendv_ps(biggest, fourZ, selZ);
+
+			const __m128 biggestVal = _mm_mul_ps(_mm_sqrt_ps(_mm_add_ps(biggest, one)), half);
+			const __m128 mult = _mm_div_ps(quarter, biggestVal);
+			const __m128 d12 = _mm_mul_ps(_mm_sub_ps(m[1][2], m[2][1]), mult);
+			const __m128 d20 = _mm_mul_ps(_mm_sub_ps(m[2][0], m[0][2]), mult);
+			const __m128 d01 = _mm_mul_ps(_mm_sub_ps(m[0][1], m[1][0]), mult);
+			const __m128 s01 = _mm_mul_ps(_mm_add_ps(m[0][1], m[1][0]), mult);
+			const __m128 s20 = _mm_mul_ps(_mm_add_ps(m[2][0], m[0][2]), mult);
+			const __m128 s12 = _mm_mul_ps(_mm_add_ps(m[1][2], m[2][1]), mult);
+
+			// Later selections override earlier ones, just like in glm::quat_cast:
+			__m128 qw = biggestVal, qx = d12, qy = d20, qz = d01;
+			qw = _mm_blendv_ps(qw, d12, selX);        qx = _mm_blendv_ps(qx, biggestVal, selX); qy = _mm_blendv_ps(qy, s01, selX);        qz = _mm_blendv_ps(qz, s20, selX);
+			qw = _mm_blendv_ps(qw, d20, selY);        qx = _mm_blendv_ps(qx, s01, selY);        qy = _mm_blendv_ps(qy, biggestVal, selY); qz = _mm_blendv_ps(qz, s12, selY);
+			qw = _mm_blendv_ps(qw, d01, selZ);        qx = _mm_blendv_ps(qx, s20, selZ);        qy = _mm_blendv_ps(qy, s12, selZ);        qz = _mm_blendv_ps(qz, biggestVal, selZ);
+
+			store_vec4s_sse(qx, qy, qz, qw, &aRotationsOut[i].x, &aRotationsOut[i + 1].x, &aRotationsOut[i + 2].x, &aRotationsOut[i + 3].x);
+			store_vec3s_sse(m[3][0], m[3][1], m[3][2], aTranslationsOut + i);
+			store_vec3s_sse(s[0], s[1], s[2], aScalesOut + i);
+		}
+		transforms_from_matrices_scalar(aMatrices + i, aCount - i, aTranslationsOut + i, aRotationsOut + i, aScalesOut + i);
+	}
+
+	/** Combines two registers of four lanes into one register of eight lanes. */
+	GVK_TARGET("avx2,fma")
+	static inline __m256 combine_avx(__m128 aLow, __m128 aHigh)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(aLow), aHigh, 1);
+	}
+
+	GVK_TARGET("avx2,fma")
+	static void matrices_from_transforms_avx2(const glm::vec3* aTranslations, const glm::quat* aRotations, const glm::vec3* aScales, size_t aCount, glm::mat4* aMatricesOut)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 two = _mm256_set1_ps(2.0f);
+		size_t i = 0;
+		for (; i + 8 <= aCount; i += 8) {
+			__m128 l[10], h[10];
+			load_vec4s_sse(&aRotations[i].x, &aRotations[i + 1].x, &aRotations[i + 2].x, &aRotations[i + 3].x, l[0], l[1], l[2], l[3]);
+			load_vec4s_sse(&aRotations[i + 4].x, &aRotations[i + 5].x, &aRotations[i + 6].x, &aRotations[i + 7].x, h[0], h[1], h[2], h[3]);
+			load_vec3s_sse(aTranslations + i, l[4], l[5], l[6]);
+			load_vec3s_sse(aTranslations + i + 4, h[4], h[5], h[6]);
+			load_vec3s_sse(aScales + i, l[7], l[8], l[9]);
+			load_vec3s_sse(aScales + i + 4, h[7], h[8], h[9]);
+			const __m256 qx = combine_avx(l[0], h[0]), qy = combine_avx(l[1], h[1]), qz = combine_avx(l[2], h[2]), qw = combine_avx(l[3], h[3]);
+			const __m256 sx = combine_avx(l[7], h[7]), sy = combine_avx(l[8], h[8]), sz = combine_avx(l[9], h[9]);
+
+			// x = aRotation * (1, 0, 0) and y = aRotation * (0, 1, 0), c.f. matrix_from_transforms:
+			const __m256 xx = _mm256_fnmadd_ps(two, _mm256_fmadd_ps(qy, qy, _mm256_mul_ps(qz, qz)), one);
+			const __m256 xy = _mm256_mul_ps(two, _mm256_fmadd_ps(qx, qy, _mm256_mul_ps(qz, qw)));
+			const __m256 xz = _mm256_mul_ps(two, _mm256_fmsub_ps(qx, qz, _mm256_mul_ps(qy, qw)));
+			__m256 yx = _mm256_mul_ps(two, _mm256_fmsub_ps(qx, qy, _mm256_mul_ps(qz, qw)));
+			__m256 yy = _mm256_fnmadd_ps(two, _mm256_fmadd_ps(qz, qz, _mm256_mul_ps(qx, qx)), one);
+			__m256 yz = _mm256_mul_ps(two, _mm256_fmadd_ps(qy, qz, _mm256_mul_ps(qx, qw)));
+			// z = cross(x, y), y = cross(z, x):
+			const __m256 zx = _mm256_fmsub_ps(xy, yz, _mm256_mul_ps(xz, yy));
+			const __m256 zy = _mm256_fmsub_ps(xz, yx, _mm256_mul_ps(xx, yz));
+			const __m256 zz = _mm256_fmsub_ps(xx, yy, _mm256_mul_ps(xy, yx));
+			yx = _mm256_fmsub_ps(zy, xz, _mm256_mul_ps(zz, xy));
+			yy = _mm256_fmsub_ps(zz, xx, _mm256_mul_ps(zx, xz));
+			yz = _mm256_fmsub_ps(zx, xy, _mm256_mul_ps(zy, xx));
+
+			const __m256 columns[3][3] = {
+				{ _mm256_mul_ps(xx, sx), _mm256_mul_ps(xy, sx), _mm256_mul_ps(xz, sx) },
+				{ _mm256_mul_ps(yx, sy), _mm256_mul_ps(yy, sy), _mm256_mul_ps(yz, sy) },
+				{ _mm256_mul_ps(zx, sz), _mm256_mul_ps(zy, sz), _mm256_mul_ps(zz, sz) }
+			};
+			const __m128 zero4 = _mm_setzero_ps();
+			const __m128 one4 = _mm_set1_ps(1.0f);
+			auto* out = aMatricesOut + i;
+			for (glm::length_t c = 0; c < 3; ++c) {
+				store_vec4s_sse(_mm256_castps256_ps128(columns[c][0]), _mm256_castps256_ps128(columns[c][1]), _mm256_castps256_ps128(columns[c][2]), zero4,
+					&out[0][c].x, &out[1][c].x, &out[2][c].x, &out[3][c].x);
+				store_vec4s_sse(_mm256_extractf128_ps(columns[c][0], 1), _mm256_extractf128_ps(columns[c][1], 1), _mm256_extractf128_ps(columns[c][2], 1), zero4,
+					&out[4][c].x, &out[5][c].x, &out[6][c].x, &out[7][c].x);
+			}
+			// The translations are only copied, hence they have never been combined into 8-wide registers:
+			store_vec4s_sse(l[4], l[5], l[6], one4, &out[0][3].x, &out[1][3].x, &out[2][3].x, &out[3][3].x);
+			store_vec4s_sse(h[4], h[5], h[6], one4, &out[4][3].x, &out[5][3].x, &out[6][3].x, &out[7][3].x);
+		}
+		matrices_from_transforms_sse4_1(aTranslations + i, aRotations + i, aScales + i, aCount - i, aMatricesOut + i);
+	}
+
+	GVK_TARGET("avx2,fma")
+	static void transforms_from_matrices_avx2(const glm::mat4* aMatrices, size_t aCount, glm::vec3* aTranslationsOut, glm::quat* aRotationsOut, glm::vec3* aScalesOut)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 half = _mm256_set1_ps(0.5f);
+		const __m256 quarter = _mm256_set1_ps(0.25f);
+		size_t i = 0;
+		for (; i + 8 <= aCount; i += 8) {
+			// m[c][r] => column c, row r; the translations are not needed in 8-wide registers:
+			__m256 m[3][3];
+			for (glm::length_t c = 0; c < 3; ++c) {
+				__m128 l[4], h[4];
+				load_vec4s_sse(&aMatrices[i][c].x, &aMatrices[i + 1][c].x, &aMatrices[i + 2][c].x, &aMatrices[i + 3][c].x, l[0], l[1], l[2], l[3]);
+				load_vec4s_sse(&aMatrices[i + 4][c].x, &aMatrices[i + 5][c].x, &aMatrices[i + 6][c].x, &aMatrices[i + 7][c].x, h[0], h[1], h[2], h[3]);
+				for (int r = 0; r < 3; ++r) {
+					m[c][r] = combine_avx(l[r], h[r]);
+				}
+			}
+
+			__m256 s[3];
+			for (int c = 0; c < 3; ++c) {
+				s[c] = _mm256_sqrt_ps(_mm256_fmadd_ps(m[c][0], m[c][0], _mm256_fmadd_ps(m[c][1], m[c][1], _mm256_mul_ps(m[c][2], m[c][2]))));
+				for (int r = 0; r < 3; ++r) {
+					m[c][r] = _mm256_div_ps(m[c][r], s[c]);
+				}
+			}
+
+			// Branchless version of glm::quat_cast, which selects the largest of the four candidates:
+			const __m256 fourX = _mm256_sub_ps(_mm256_sub_ps(m[0][0], m[1][1]), m[2][2]);
+			const __m256 fourY = _mm256_sub_ps(_mm256_sub_ps(m[1][1], m[0][0]), m[2][2]);
+			const __m256 fourZ = _mm256_sub_ps(_mm256_sub_ps(m[2][2], m[0][0]), m[1][1]);
+			__m256 biggest = _mm256_add_ps(_mm256_add_ps(m[0][0], m[1][1]), m[2][2]);
+			const __m256 selX = _mm256_cmp_ps(fourX, biggest, _CMP_GT_OQ);
+			biggest = _mm256_blendv_ps(biggest, fourX, selX);
+			const __m256 selY = _mm256_cmp_ps(fourY, biggest, _CMP_GT_OQ);
+			biggest = _mm256_blendv_ps(biggest, fourY, selY);
+			const __m256 selZ = _mm256_cmp_ps(fourZ, biggest, _CMP_GT_OQ);
+			biggest = _mm256_blendv_ps(biggest, fourZ, selZ);
+
+			const __m256 biggestVal = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_add_ps(biggest, one)), half);
+			const __m256 mult = _mm256_div_ps(quarter, biggestVal);
+			const __m256 d12 = _mm256_mul_ps(_mm256_sub_ps(m[1][2], m[2][1]), mult);
+			const __m256 d20 = _mm256_mul_ps(_mm256_sub_ps(m[2][0], m[0][2]), mult);
+			const __m256 d01 = _mm256_mul_ps(_mm256_sub_ps(m[0][1], m[1][0]), mult);
+			const __m256 s01 = _mm256_mul_ps(_mm256_add_ps(m[0][1], m[1][0]), mult);
+			const __m256 s20 = _mm256_mul_ps(_mm256_add_ps(m[2][0], m[0][2]), mult);
+			const __m256 s12 = _mm256_mul_ps(_mm256_add_ps(m[1][2], m[2][1]), mult);
+
+			// Later selections override earlier ones, just like in glm::quat_cast:
+			__m256 qw = biggestVal, qx = d12, qy = d20, qz = d01;
+			qw = _mm256_blendv_ps(qw, d12, selX);     qx = _mm256_blendv_ps(qx, biggestVal, selX); qy = _mm256_blendv_ps(qy, s01, selX);        qz = _mm256_blendv_ps(qz, s20, selX);
+			qw = _mm256_blendv_ps(qw, d20, selY);     qx = _mm256_blendv_ps(qx, s01, selY);        qy = _mm256_blendv_ps(qy, biggestVal, selY); qz = _mm256_blendv_ps(qz, s12, selY);
+			qw = _mm256_blendv_ps(qw, d01, selZ);     qx = _mm256_blendv_ps(qx, s20, selZ);        qy = _mm256_blendv_ps(qy, s12, selZ);        qz = _mm256_blendv_ps(qz, biggestVal, selZ);
+
+			store_vec4s_sse(_mm256_castps256_ps128(qx), _mm256_castps256_ps128(qy), _mm256_castps256_ps128(qz), _mm256_castps256_ps128(qw),
+				&aRotationsOut[i].x, &aRotationsOut[i + 1].x, &aRotationsOut[i + 2].x, &aRotationsOut[i + 3].x);
+			store_vec4s_sse(_mm256_extractf128_ps(qx, 1), _mm256_extractf128_ps(qy, 1), _mm256_extractf128_ps(qz, 1), _mm256_extractf128_ps(qw, 1),
+				&aRotationsOut[i + 4].x, &aRotationsOut[i + 5].x, &aRotationsOut[i + 6].x, &aRotationsOut[i + 7].x);
+			store_vec3s_sse(_mm256_castps256_ps128(s[0]), _mm256_castps256_ps128(s[1]), _mm256_castps256_ps128(s[2]), aScalesOut + i);
+			store_vec3s_sse(_mm256_extractf128_ps(s[0], 1), _mm256_extractf128_ps(s[1], 1), _mm256_extractf128_ps(s[2], 1), aScalesOut + i + 4);
+			for (size_t k = 0; k < 8; ++k) {
+				aTranslationsOut[i + k] = glm::vec3{ aMatrices[i + k][3] };
+			}
+		}
+		transforms_from_matrices_sse4_1(aMatrices + i, aCount - i, aTranslationsOut + i, aRotationsOut + i, aScalesOut + i);
+	}
+
+	static void cpuid(int aLeaf, int aSubleaf, int aRegistersOut[4])
+	{
+#if defined(_MSC_VER)
+		__cpuidex(aRegistersOut, aLeaf, aSubleaf);
+#else
+		unsigned int a = 0, b = 0, c = 0, d = 0;
+		__cpuid_count(aLeaf, aSubleaf, a, b, c, d);
+		aRegistersOut[0] = static_cast<int>(a); aRegistersOut[1] = static_cast<int>(b); aRegistersOut[2] = static_cast<int>(c); aRegistersOut[3] = static_cast<int>(d);
+#endif
+	}
+
+	/** Returns the state components which the OS saves on context switches, c.f. XGETBV */
+	static uint64_t os_saved_state_components()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32_t eax = 0, edx = 0;
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+	}
+
+	static simd_instruction_set detect_simd_instruction_set()
+	{
+		int regs[4];
+		cpuid(0, 0, regs);
+		const int maxLeaf = regs[0];
+		if (maxLeaf < 1) {
+			return simd_instruction_set::scalar;
+		}
+		cpuid(1, 0, regs);
+		const bool sse41   = 0 != (regs[2] & (1 << 19));
+		const bool fma     = 0 != (regs[2] & (1 << 12));
+		const bool osxsave = 0 != (regs[2] & (1 << 27));
+		const bool avx     = 0 != (regs[2] & (1 << 28));
+		if (!sse41) {
+			return simd_instruction_set::scalar;
+		}
+		// AVX registers can only be used if the OS saves them (XMM and YMM state):
+		if (maxLeaf >= 7 && fma && osxsave && avx && 0x6 == (os_saved_state_components() & 0x6)) {
+			cpuid(7, 0, regs);
+			if (0 != (regs[1] & (1 << 5))) {
+				return simd_instruction_set::avx2;
+			}
+		}
+		return simd_instruction_set::sse4_1;
+	}
+#else
+	static simd_instruction_set detect_simd_instruction_set()
+	{
+		return simd_instruction_set::scalar;
+	}
+#endif
+
+	simd_instruction_set supported_simd_instruction_set()
+	{
+		static const simd_instruction_set sSupported = detect_simd_instruction_set();
+		return sSupported;
+	}
+
+	static std::atomic<simd_instruction_set>& active_instruction_set_storage()
+	{
+		static std::atomic<simd_instruction_set> sActive{ supported_simd_instruction_set() };
+		return sActive;
+	}
+
+	simd_instruction_set active_simd_instruction_set()
+	{
+		return active_instruction_set_storage().load(std::memory_order_relaxed);
+	}
+
+	void set_simd_instruction_set(simd_instruction_set aInstructionSet)
+	{
+		const auto supported = supported_simd_instruction_set();
+		if (static_cast<int>(aInstructionSet) > static_cast<int>(supported)) {
+			LOG_WARNING(fmt::format("The requested SIMD instruction set is not supported by this CPU => falling back to {}.", static_cast<int>(supported)));
+			aInstructionSet = supported;
+		}
+		active_instruction_set_storage().store(aInstructionSet, std::memory_order_relaxed);
+	}
+
+	void matrices_from_transforms(const glm::vec3* aTranslations, const glm::quat* aRotations, const glm::vec3* aScales, size_t aCount, glm::mat4* aMatricesOut)
+	{
+		switch (active_simd_instruction_set()) {
+#if defined(GVK_SIMD_X86)
+		case simd_instruction_set::avx2:
+			matrices_from_transforms_avx2(aTranslations, aRotations, aScales, aCount, aMatricesOut);
+			break;
+		case simd_instruction_set::sse4_1:
+			matrices_from_transforms_sse4_1(aTranslations, aRotations, aScales, aCount, aMatricesOut);
+			break;
+#endif
+		default:
+			matrices_from_transforms_scalar(aTranslations, aRotations, aScales, aCount, aMatricesOut);
+			break;
+		}
+	}
+
+	void transforms_from_matrices(const glm::mat4* aMatrices, size_t aCount, glm::vec3* aTranslationsOut, glm::quat* aRotationsOut, glm::vec3* aScalesOut)
+	{
+		switch (active_simd_instruction_set()) {
+#if defined(GVK_SIMD_X86)
+		case simd_instruction_set::avx2:
+			transforms_from_matrices_avx2(aMatrices, aCount, aTranslationsOut, aRotationsOut, aScalesOut);
+			break;
+		case simd_instruction_set::sse4_1:
+			transforms_from_matrices_sse4_1(aMatrices, aCount, aTranslationsOut, aRotationsOut, aScalesOut);
+			break;
+#endif
+		default:
+			transforms_from_matrices_scalar(aMatrices, aCount, aTranslationsOut, aRotationsOut, aScalesOut);
+			break;
+		}
+	}
+}
@@ -0,0 +1,235 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	transform_system::transform_id transform_system::create(glm::vec3 aTranslation, glm::quat aRotation, glm::vec3 aScale, std::optional<transform_id> aParent)
+	{
+		const int32_t parentIndex = aParent.has_value() ? static_cast<int32_t>(index_of(aParent.value())) : sNoParent;
+
+		transform_id id;
+		if (!mFreeIds.empty()) {
+			id = mFreeIds.back();
+			mFreeIds.pop_back();
+		}
+		else {
+			id = static_cast<transform_id>(mIndexOfId.size());
+			mIndexOfId.push_back(sInvalidIndex);
+		}
+
+		// New transforms are appended, i.e. they are stored after their parents, but not sorted into their depth level yet:
+		mIndexOfId[id] = static_cast<uint32_t>(mTranslations.size());
+		mTranslations.push_back(aTranslation);
+		mRotations.push_back(aRotation);
+		mScales.push_back(aScale);
+		mParentIndices.push_back(parentIndex);
+		mLocalMatrices.emplace_back(1.0f);
+		mWorldMatrices.emplace_back(1.0f);
+		mDirty.push_back(1);
+		mChanged.push_back(0);
+		mAlive.push_back(1);
+		mIdAtIndex.push_back(id);
+		++mNumAlive;
+		mHierarchyChanged = true;
+		return id;
+	}
+
+	void transform_system::destroy(transform_id aId)
+	{
+		const auto index = index_of(aId);
+		// The entry is removed during the next rebuild(). Until then, it remains in the arrays, s.t. its children can find their new parent.
+		mAlive[index] = 0;
+		mIndexOfId[aId] = sInvalidIndex;
+		mFreeIds.push_back(aId);
+		--mNumAlive;
+		mHierarchyChanged = true;
+	}
+
+	void transform_system::set_parent(transform_id aId, std::optional<transform_id> aParent)
+	{
+		const auto index = index_of(aId);
+		int32_t parentIndex = sNoParent;
+		if (aParent.has_value()) {
+			parentIndex = static_cast<int32_t>(index_of(aParent.value()));
+			for (auto i = parentIndex; sNoParent != i; i = mParentIndices[i]) {
+				if (static_cast<uint32_t>(i) == index) {
+					throw gvk::logic_error(fmt::format("Transform {} can not be attached to transform {}, because that would create a cycle.", aId, aParent.value()));
+				}
+			}
+		}
+		mParentIndices[index] = parentIndex;
+		mDirty[index] = 1;
+		mHierarchyChanged = true;
+	}
+
+	std::optional<transform_system::transform_id> transform_system::parent(transform_id aId) const
+	{
+		auto p = mParentIndices[index_of(aId)];
+		while (sNoParent != p && 0 == mAlive[p]) {
+			p = mParentIndices[p];
+		}
+		if (sNoParent == p) {
+			return {};
+		}
+		return mIdAtIndex[p];
+	}
+
+	uint32_t transform_system::index_of(transform_id aId) const
+	{
+		if (!exists(aId)) {
+			throw gvk::logic_error(fmt::format("There is no transform with id {}.", aId));
+		}
+		return mIndexOfId[aId];
+	}
+
+	void transform_system::rebuild()
+	{
+		const auto n = mTranslations.size();
+
+		// Resolve the parents of transforms whose parents have been destroyed:
+		std::vector<int32_t> parents(n, sNoParent);
+		for (size_t i = 0; i < n; ++i) {
+			auto p = mParentIndices[i];
+			while (sNoParent != p && 0 == mAlive[p]) {
+				p = mParentIndices[p];
+			}
+			parents[i] = p;
+			if (p != mParentIndices[i]) {
+				mDirty[i] = 1;
+			}
+		}
+
+		// Determine the depth of each transform, without recursion:
+		std::vector<int32_t> depths(n, -1);
+		std::vector<size_t> stack;
+		uint32_t maxDepth = 0;
+		for (size_t i = 0; i < n; ++i) {
+			if (0 == mAlive[i]) {
+				continue;
+			}
+			auto j = static_cast<int32_t>(i);
+			while (sNoParent != j && depths[j] < 0) {
+				stack.push_back(static_cast<size_t>(j));
+				j = parents[j];
+			}
+			int32_t depth = sNoParent == j ? -1 : depths[j];
+			while (!stack.empty()) {
+				depths[stack.back()] = ++depth;
+				stack.pop_back();
+			}
+			maxDepth = std::max(maxDepth, static_cast<uint32_t>(depths[i]));
+		}
+
+		// Counting sort by depth, which keeps the relative order within each level:
+		mLevels.assign(mNumAlive > 0 ? maxDepth + 2 : 1, 0u);
+		for (size_t i = 0; i < n; ++i) {
+			if (0 != mAlive[i]) {
+				++mLevels[depths[i] + 1];
+			}
+		}
+		for (size_t l = 1; l < mLevels.size(); ++l) {
+			mLevels[l] += mLevels[l - 1];
+		}
+		std::vector<uint32_t> newIndices(n, sInvalidIndex);
+		{
+			auto insertPositions = mLevels;
+			for (size_t i = 0; i < n; ++i) {
+				if (0 != mAlive[i]) {
+					newIndices[i] = insertPositions[depths[i]]++;
+				}
+			}
+		}
+
+		auto permute = [&newIndices, this](auto& bArray) {
+			std::remove_reference_t<decltype(bArray)> sorted(mNumAlive);
+			for (size_t i = 0; i < newIndices.size(); ++i) {
+				if (sInvalidIndex != newIndices[i]) {
+					sorted[newIndices[i]] = bArray[i];
+				}
+			}
+			bArray = std::move(sorted);
+		};
+		permute(mTranslations);
+		permute(mRotations);
+		permute(mScales);
+		permute(mLocalMatrices);
+		permute(mWorldMatrices);
+		permute(mDirty);
+		permute(mChanged);
+		permute(mIdAtIndex);
+		for (auto& p : parents) {
+			p = sNoParent == p ? sNoParent : static_cast<int32_t>(newIndices[p]);
+		}
+		permute(parents);
+		mParentIndices = std::move(parents);
+		mAlive.assign(mNumAlive, 1);
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(mNumAlive); ++i) {
+			mIndexOfId[mIdAtIndex[i]] = i;
+		}
+		mHierarchyChanged = false;
+	}
+
+	void transform_system::update_range(size_t aBegin, size_t aEnd)
+	{
+		// Compute the local matrices of consecutive dirty transforms in batches:
+		for (size_t i = aBegin; i < aEnd;) {
+			if (0 == mDirty[i]) {
+				++i;
+				continue;
+			}
+			size_t runEnd = i + 1;
+			while (runEnd < aEnd && 0 != mDirty[runEnd]) {
+				++runEnd;
+			}
+			matrices_from_transforms(&mTranslations[i], &mRotations[i], &mScales[i], runEnd - i, &mLocalMatrices[i]);
+			i = runEnd;
+		}
+
+		for (size_t i = aBegin; i < aEnd; ++i) {
+			const auto p = mParentIndices[i];
+			const bool parentChanged = sNoParent != p && 0 != mChanged[p];
+			if (0 != mDirty[i] || parentChanged) {
+				mWorldMatrices[i] = sNoParent != p ? mWorldMatrices[p] * mLocalMatrices[i] : mLocalMatrices[i];
+				mDirty[i] = 0;
+				mChanged[i] = 1;
+			}
+			else {
+				mChanged[i] = 0;
+			}
+		}
+	}
+
+	void transform_system::update()
+	{
+		if (mHierarchyChanged) {
+			rebuild();
+		}
+		update_range(0, mNumAlive);
+	}
+
+	void transform_system::update(thread_pool& aThreadPool, size_t aGrainSize)
+	{
+		if (mHierarchyChanged) {
+			rebuild();
+		}
+		if (0 == aGrainSize) {
+			// Aim for a few chunks per thread, but not for chunks which are so small that the overhead dominates:
+			const auto numThreads = static_cast<size_t>(aThreadPool.number_of_workers()) + 1;
+			aGrainSize = std::max(size_t{ 1024 }, mNumAlive / (numThreads * 4));
+		}
+		// All parents of a level are stored in the previous levels => the levels must be processed one after the other:
+		for (size_t l = 0; l + 1 < mLevels.size(); ++l) {
+			const size_t levelBegin = mLevels[l];
+			const size_t levelEnd = mLevels[l + 1];
+			if (levelEnd - levelBegin <= aGrainSize) {
+				update_range(levelBegin, levelEnd);
+				continue;
+			}
+			const size_t numChunks = (levelEnd - levelBegin + aGrainSize - 1) / aGrainSize;
+			aThreadPool.parallel_for(0, numChunks, [this, levelBegin, levelEnd, aGrainSize](size_t bChunk) {
+				const size_t begin = levelBegin + bChunk * aGrainSize;
+				update_range(begin, std::min(begin + aGrainSize, levelEnd));
+			});
+		}
+	}
+}
@@ -0,0 +1,243 @@
+#include <gvk.hpp>
+
+namespace gvk
+{
+	static constexpr uint32_t sEmptySlot = std::numeric_limits<uint32_t>::max();
+
+	static inline uint32_t rotl32(uint32_t aValue, int aBits)
+	{
+		return (aValue << aBits) | (aValue >> (32 - aBits));
+	}
+
+	/**	Hashes the given words, following xxHash32's structure: The bulk of the data
+	 *	is consumed in four independent lanes, which compilers can keep in one SIMD
+	 *	register, and which do not have to wait for each other's results.
+	 */
+	static uint32_t hash_vertex_key(const uint32_t* aWords, size_t aCount)
+	{
+		constexpr uint32_t P1 = 2654435761u;
+		constexpr uint32_t P2 = 2246822519u;
+		constexpr uint32_t P3 = 3266489917u;
+		constexpr uint32_t P4 = 668265263u;
+		constexpr uint32_t P5 = 374761393u;
+
+		uint32_t h;
+		size_t i = 0;
+		if (aCount >= 4) {
+			uint32_t lanes[4] = { P1 + P2, P2, 0u, 0u - P1 };
+			for (; i + 4 <= aCount; i += 4) {
+				for (size_t l = 0; l < 4; ++l) {
+					lanes[l] = rotl32(lanes[l] + aWords[i + l] * P2, 13) * P1;
+				}
+			}
+			h = rotl32(lanes[0], 1) + rotl32(lanes[1], 7) + rotl32(lanes[2], 12) + rotl32(lanes[3], 18);
+		}
+		else {
+			h = P5;
+		}
+		h += static_cast<uint32_t>(aCount * sizeof(uint32_t));
+		for (; i < aCount; ++i) {
+			h = rotl32(h + aWords[i] * P3, 17) * P4;
+		}
+		h ^= h >> 15;
+		h *= P2;
+		h ^= h >> 13;
+		h *= P3;
+		h ^= h >> 16;
+		return h;
+	}
+
+	/** Returns the bit pattern of the given float, with -0.0 mapped to +0.0, s.t. they are treated as identical. */
+	static inline uint32_t key_word(float aValue)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &aValue, sizeof(bits));
+		return 0x80000000u == bits ? 0u : bits;
+	}
+
+	/** Moves the elements at the representatives' positions to the front of the given array. */
+	template <typename T>
+	static void compact_in_place(T* aArray, const std::vector<uint32_t>& aRepresentatives)
+	{
+		if (nullptr == aArray) {
+			return;
+		}
+		// Representatives are strictly increasing and aRepresentatives[u] >= u, i.e. no element is overwritten before it has been read.
+		for (size_t u = 0; u < aRepresentatives.size(); ++u) {
+			aArray[u] = aArray[aRepresentatives[u]];
+		}
+	}
+
+	uint32_t weld_identical_vertices(aiMesh* aMesh)
+	{
+		assert(nullptr != aMesh);
+		const uint32_t n = aMesh->mNumVertices;
+		if (n < 2 || nullptr == aMesh->mVertices) {
+			return 0u;
+		}
+		if (aMesh->mNumAnimMeshes > 0) {
+			LOG_DEBUG(fmt::format("Not welding the vertices of mesh '{}' since it has morph targets.", aMesh->mName.C_Str()));
+			return 0u;
+		}
+
+		// Gather the bone influences per vertex, sorted by bone index, s.t. they can be compared:
+		std::vector<uint32_t> influenceOffsets(static_cast<size_t>(n) + 1, 0u);
+		std::vector<std::tuple<uint32_t, float>> influences;
+		uint32_t maxInfluences = 0u;
+		if (aMesh->HasBones()) {
+			for (unsigned int b = 0; b < aMesh->mNumBones; ++b) {
+				const aiBone* bone = aMesh->mBones[b];
+				for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+					++influenceOffsets[bone->mWeights[w].mVertexId + 1];
+				}
+			}
+			for (uint32_t v = 0; v < n; ++v) {
+				maxInfluences = std::max(maxInfluences, influenceOffsets[v + 1]);
+				influenceOffsets[v + 1] += influenceOffsets[v];
+			}
+			influences.resize(influenceOffsets[n]);
+			std::vector<uint32_t> fillCounts(n, 0u);
+			for (unsigned int b = 0; b < aMesh->mNumBones; ++b) {
+				const aiBone* bone = aMesh->mBones[b];
+				for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+					const auto vertexId = bone->mWeights[w].mVertexId;
+					influences[influenceOffsets[vertexId] + fillCounts[vertexId]++] = std::make_tuple(static_cast<uint32_t>(b), bone->mWeights[w].mWeight);
+				}
+			}
+			for (uint32_t v = 0; v < n; ++v) {
+				std::sort(influences.begin() + influenceOffsets[v], influences.begin() + influenceOffsets[v + 1]);
+			}
+		}
+
+		// Determine the number of 32-bit words which make up one vertex' key:
+		size_t stride = 3;
+		if (nullptr != aMesh->mNormals)    { stride += 3; }
+		if (nullptr != aMesh->mTangents)   { stride += 3; }
+		if (nullptr != aMesh->mBitangents) { stride += 3; }
+		for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+			if (nullptr != aMesh->mColors[c]) { stride += 4; }
+		}
+		for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+			if (nullptr != aMesh->mTextureCoords[t]) { stride += std::max(aMesh->mNumUVComponents[t], 1u); }
+		}
+		stride += 2 * static_cast<size_t>(maxInfluences);
+
+		// Pack all the keys tightly, s.t. hashing and comparing operate on contiguous memory:
+		std::vector<uint32_t> keys(stride * n);
+		for (uint32_t v = 0; v < n; ++v) {
+			uint32_t* k = &keys[stride * v];
+			auto put3 = [&k](const aiVector3D& bVec) {
+				*k++ = key_word(bVec.x); *k++ = key_word(bVec.y); *k++ = key_word(bVec.z);
+			};
+			put3(aMesh->mVertices[v]);
+			if (nullptr != aMesh->mNormals)    { put3(aMesh->mNormals[v]); }
+			if (nullptr != aMesh->mTangents)   { put3(aMesh->mTangents[v]); }
+			if (nullptr != aMesh->mBitangents) { put3(aMesh->mBitangents[v]); }
+			for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+				if (nullptr != aMesh->mColors[c]) {
+					const auto& col = aMesh->mColors[c][v];
+					*k++ = key_word(col.r); *k++ = key_word(col.g); *k++ = key_word(col.b); *k++ = key_word(col.a);
+				}
+			}
+			for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+				if (nullptr != aMesh->mTextureCoords[t]) {
+					const auto nuv = std::max(aMesh->mNumUVComponents[t], 1u);
+					for (unsigned int i = 0; i < nuv; ++i) {
+						*k++ = key_word(aMesh->mTextureCoords[t][v][i]);
+					}
+				}
+			}
+			for (uint32_t i = 0; i < maxInfluences; ++i) {
+				const auto idx = influenceOffsets[v] + i;
+				if (idx < influenceOffsets[v + 1]) {
+					*k++ = std::get<uint32_t>(influences[idx]);
+					*k++ = key_word(std::get<float>(influences[idx]));
+				}
+				else {
+					*k++ = sEmptySlot;
+					*k++ = 0u;
+				}
+			}
+		}
+
+		// Insert all vertices into an open-addressing hash table with linear probing.
+		// The table stores indices of unique vertices; the table is at most half full.
+		size_t capacity = 1;
+		while (capacity < 2 * static_cast<size_t>(n)) {
+			capacity <<= 1;
+		}
+		const size_t mask = capacity - 1;
+		std::vector<uint32_t> table(capacity, sEmptySlot);
+		std::vector<uint32_t> uniqueHashes;
+		std::vector<uint32_t> representatives; // unique vertex index => original vertex index
+		std::vector<uint32_t> remap(n);        // original vertex index => unique vertex index
+		uniqueHashes.reserve(n);
+		representatives.reserve(n);
+		const size_t keySize = stride * sizeof(uint32_t);
+
+		for (uint32_t v = 0; v < n; ++v) {
+			const uint32_t* key = &keys[stride * v];
+			const auto h = hash_vertex_key(key, stride);
+			size_t slot = h & mask;
+			for (;;) {
+				const auto u = table[slot];
+				if (sEmptySlot == u) {
+					table[slot] = static_cast<uint32_t>(representatives.size());
+					remap[v] = static_cast<uint32_t>(representatives.size());
+					uniqueHashes.push_back(h);
+					representatives.push_back(v);
+					break;
+				}
+				if (uniqueHashes[u] == h && 0 == std::memcmp(&keys[stride * representatives[u]], key, keySize)) {
+					remap[v] = u;
+					break;
+				}
+				slot = (slot + 1) & mask;
+			}
+		}
+
+		const auto numUnique = static_cast<uint32_t>(representatives.size());
+		if (numUnique == n) {
+			return 0u;
+		}
+
+		// Compact the vertex attributes:
+		compact_in_place(aMesh->mVertices, representatives);
+		compact_in_place(aMesh->mNormals, representatives);
+		compact_in_place(aMesh->mTangents, representatives);
+		compact_in_place(aMesh->mBitangents, representatives);
+		for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+			compact_in_place(aMesh->mColors[c], representatives);
+		}
+		for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+			compact_in_place(aMesh->mTextureCoords[t], representatives);
+		}
+		aMesh->mNumVertices = numUnique;
+
+		// Remap the indices:
+		for (unsigned int f = 0; f < aMesh->mNumFaces; ++f) {
+			aiFace& face = aMesh->mFaces[f];
+			for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+				face.mIndices[i] = remap[face.mIndices[i]];
+			}
+		}
+
+		// Remap the bone weights and keep only those of representatives (the others are duplicates now):
+		for (unsigned int b = 0; b < aMesh->mNumBones; ++b) {
+			aiBone* bone = aMesh->mBones[b];
+			unsigned int numKept = 0;
+			for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+				const auto oldId = bone->mWeights[w].mVertexId;
+				const auto newId = remap[oldId];
+				if (representatives[newId] == oldId) {
+					bone->mWeights[numKept].mVertexId = newId;
+					bone->mWeights[numKept].mWeight = bone->mWeights[w].mWeight;
+					++numKept;
+				}
+			}
+			bone->mNumWeights = numKept;
+		}
+
+		return n - numUnique;
+	}
+}
@@ -0,0 +1,11 @@
+// cg_stdafx.h : include file for standard system include files,
+// or project specific include files that are used frequently, but
+// are changed infrequently
+//
+#pragma once
+
+#include "cg_targetver.hpp"
+
+#define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
+
+#include "gvk.hpp"
\ No newline at end of file